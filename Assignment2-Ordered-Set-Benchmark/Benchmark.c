@@ -0,0 +1,590 @@
+/**
+ * @file Benchmark.c
+ *
+ * @brief Benchmark of the ordered set operations across backends, sizes and element distributions.
+ *
+ * @details
+ * Times bulk building, `addElement()`, `removeElement()`, `setUnion()`, `setIntersection()`, `setDifference()`
+ * and printing for every backend, for sets of 10 to 10^7 elements in four distributions:
+ * - `sequential`: ascending consecutive elements; the second set of a set operation overlaps half of the first.
+ * - `random`: elements spread evenly, inserted in random order; two sets share about a quarter of their elements.
+ * - `clustered`: runs of consecutive elements separated by random gaps, inserted in random order.
+ * - `skewed`: a set operation between a set and one 64 times smaller, mostly made of elements of the first.
+ *
+ * Every measurement is the best of `--repeat` runs. When one takes longer than `--budget` seconds, that operation
+ * is skipped for larger sizes of the same backend and distribution, so the quadratic cases of the plain list do
+ * not stall the run. One row is written per measurement, as CSV or JSON:
+ * backend, distribution, operation, size, ops, seconds, ns_per_op, ops_per_second and peak_rss_kb, the peak
+ * resident memory of the process so far.
+ *
+ * Usage: `Benchmark [--format csv|json] [--max-size n] [--backend list|indexed|array|bitmap]
+ * [--distribution sequential|random|clustered|skewed] [--repeat n] [--budget seconds] [--seed n]`
+ *
+ * @date 17/10/2026
+*/
+
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "OrderedList.h"
+#include "SetFormat.h"
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#define BENCH_NULL_DEVICE "NUL"
+#else
+#include <time.h>
+#include <sys/resource.h>
+#define BENCH_NULL_DEVICE "/dev/null"
+#endif
+
+#define BENCH_MIN_SIZE 10 // Smallest set size measured
+#define BENCH_MAX_SIZE 10000000 // Largest set size measured by default
+#define BENCH_OPS 10000 // Elements added and removed per measurement at most
+#define BENCH_CLUSTER 128 // Elements a cluster holds at most
+#define BENCH_CLUSTER_GAP 4096 // Gap between two clusters at most
+#define BENCH_SKEW 64 // Size ratio of the two sets of the skewed distribution
+
+/**
+ * @enum BenchOperation
+ * @brief The operations that are timed.
+ */
+typedef enum {
+    BENCH_BUILD, /**< `createOrderedSetFromArray()` from unsorted elements. */
+    BENCH_ADD, /**< `addElement()` of elements not in the set. */
+    BENCH_REMOVE, /**< `removeElement()` of elements in the set. */
+    BENCH_PRINT, /**< `writeOrderedSet()` to the null device, as `printToStdout()` does. */
+    BENCH_UNION, /**< `setUnion()`. */
+    BENCH_INTERSECTION, /**< `setIntersection()`. */
+    BENCH_DIFFERENCE, /**< `setDifference()`. */
+    BENCH_OPERATIONS /**< Number of operations. */
+} BenchOperation;
+
+static const char *operationNames[BENCH_OPERATIONS] = {
+    "build", "add", "remove", "print", "union", "intersection", "difference"
+};
+
+/**
+ * @enum BenchDistribution
+ * @brief How the elements of the measured sets are chosen.
+ */
+typedef enum {
+    DIST_SEQUENTIAL, /**< Ascending consecutive elements. */
+    DIST_RANDOM, /**< Evenly spread elements in random order. */
+    DIST_CLUSTERED, /**< Runs of consecutive elements in random order. */
+    DIST_SKEWED, /**< A large set and a small one that mostly overlaps it; set operations only. */
+    DIST_COUNT /**< Number of distributions. */
+} BenchDistribution;
+
+static const char *distributionNames[DIST_COUNT] = {"sequential", "random", "clustered", "skewed"};
+
+/**
+ * @struct BenchBackend
+ * @brief A backend and the flags `createOrderedSetFromArray()` builds it with.
+ */
+typedef struct {
+    const char *name; /**< Name in the output. */
+    int flags; /**< `CreateFlags` of the backend. */
+} BenchBackend;
+
+static const BenchBackend backends[] = {
+    {"list", 0},
+    {"indexed", CREATE_INDEXED},
+    {"array", CREATE_ARRAY_BACKEND},
+    {"bitmap", CREATE_BITMAP_BACKEND}
+};
+
+#define BENCH_BACKENDS ((int) (sizeof(backends) / sizeof(backends[0])))
+
+/**
+ * @struct BenchOptions
+ * @brief The command line options.
+ */
+typedef struct {
+    int json; /**< 1 for JSON output, 0 for CSV. */
+    int maxSize; /**< Largest set size measured. */
+    int backend; /**< Index into `backends`, -1 for all. */
+    int distribution; /**< `BenchDistribution` measured, -1 for all. */
+    int repeat; /**< Runs per measurement; the fastest counts. */
+    double budget; /**< Seconds after which an operation is skipped for larger sizes. */
+    uint64_t seed; /**< Seed of the element generator. */
+    int rows; /**< Number of rows written so far. */
+    FILE *sink; /**< The null device `BENCH_PRINT` writes to. */
+} BenchOptions;
+
+/**
+ * @struct BenchData
+ * @brief The elements of one measurement, in the order they are inserted.
+ */
+typedef struct {
+    int *a; /**< Elements of the first set. */
+    int aCount; /**< Number of elements in `a`. */
+    int *extra; /**< Elements not in `a`, added by `BENCH_ADD`. */
+    int extraCount; /**< Number of elements in `extra`. */
+    int *b; /**< Elements of the second set of the set operations. */
+    int bCount; /**< Number of elements in `b`. */
+} BenchData;
+
+/**
+ * @brief Returns the time in seconds from a monotonic clock.
+*/
+static double nowSeconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double) counter.QuadPart / (double) frequency.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+#endif
+}
+
+/**
+ * @brief Returns the peak resident memory of the process so far, in kilobytes.
+*/
+static long long peakMemoryKb(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return -1;
+    }
+    return (long long) (counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+#ifdef __APPLE__
+    return (long long) usage.ru_maxrss / 1024;// Reported in bytes
+#else
+    return (long long) usage.ru_maxrss;// Reported in kilobytes
+#endif
+#endif
+}
+
+/**
+ * @brief Returns the next number of a xorshift64* generator, so runs with the same seed measure the same sets.
+*/
+static uint64_t nextRandom(uint64_t *state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Puts elements in random order.
+*/
+static void shuffle(int *elems, int count, uint64_t *state) {
+    for (int i = count - 1; i > 0; i--) {
+        int j = (int) (nextRandom(state) % (uint64_t) (i + 1));
+        int swap = elems[i];
+        elems[i] = elems[j];
+        elems[j] = swap;
+    }
+}
+
+/**
+ * @brief Allocates an array of elements, ending the program if this fails.
+*/
+static int *allocateElems(int count) {
+    int *elems = (int *) malloc((count > 0 ? count : 1) * sizeof(int));
+
+    if (elems == NULL) {
+        fprintf(stderr, "[ERROR] Memory allocation failed for the benchmark elements.\n");
+        exit(-1);
+    }
+
+    return elems;
+}
+
+/**
+ * @brief Fills an array with distinct elements of a distribution, in insertion order.
+ *
+ * ***Pseudocode:***
+ * 1. Produce ascending elements starting at `first`:
+ *      - `DIST_SEQUENTIAL`: consecutive
+ *      - `DIST_CLUSTERED`: runs of up to `BENCH_CLUSTER` consecutive elements, then a gap of up to
+ *        `BENCH_CLUSTER_GAP`
+ *      - Otherwise: gaps of 1 to 7, 4 on average
+ * 2. Unless the distribution is sequential, shuffle them
+*/
+static void fillElems(int *elems, int count, BenchDistribution distribution, int first, uint64_t *state) {
+    int run = 0;
+    int elem = first;
+
+    for (int i = 0; i < count; i++) {
+        elems[i] = elem;
+        if (distribution == DIST_SEQUENTIAL) {
+            elem++;
+        }
+        else if (distribution == DIST_CLUSTERED) {
+            if (run == 0) {
+                run = 1 + (int) (nextRandom(state) % BENCH_CLUSTER);
+            }
+            elem += --run > 0 ? 1 : 2 + (int) (nextRandom(state) % BENCH_CLUSTER_GAP);
+        }
+        else {
+            elem += 1 + (int) (nextRandom(state) % 7);
+        }
+    }
+
+    if (distribution != DIST_SEQUENTIAL) {
+        shuffle(elems, count, state);
+    }
+}
+
+/**
+ * @brief Generates the elements of a measurement of `size` elements.
+ *
+ * @details
+ * - `a` and `extra` are taken from one generated array, so they never share an element.
+ * - For `DIST_SEQUENTIAL` the second set starts halfway into the first; for `DIST_SKEWED` it takes nine in ten
+ *   elements from the first set and the rest at random; otherwise it is generated like the first.
+*/
+static void generateData(BenchData *data, BenchDistribution distribution, int size, uint64_t seed) {
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + (uint64_t) size * 2 + 1;
+    int ops = size < BENCH_OPS ? size : BENCH_OPS;
+    BenchDistribution elems = distribution == DIST_SKEWED ? DIST_RANDOM : distribution;
+
+    data->aCount = size;
+    data->extraCount = ops;
+    data->a = allocateElems(size + ops);
+    data->extra = data->a + size;
+    fillElems(data->a, size + ops, elems, 0, &state);// Sequential adds thus append after the largest element
+
+    if (distribution == DIST_SKEWED) {
+        int fromA = 0;
+
+        data->bCount = size / BENCH_SKEW > 0 ? size / BENCH_SKEW : 1;
+        data->b = allocateElems(data->bCount);
+        fromA = data->bCount * 9 / 10;
+        memcpy(data->b, data->a, fromA * sizeof(int));// `a` is in random order, so this is a random sample
+        fillElems(data->b + fromA, data->bCount - fromA, DIST_RANDOM, 0, &state);
+    }
+    else {
+        data->bCount = size;
+        data->b = allocateElems(size);
+        fillElems(data->b, size, elems, distribution == DIST_SEQUENTIAL ? size / 2 : 0, &state);
+    }
+}
+
+/**
+ * @brief Frees the elements of a measurement.
+*/
+static void freeData(BenchData *data) {
+    free(data->a);
+    free(data->b);
+}
+
+/**
+ * @brief Creates a set from elements, ending the program if this fails.
+*/
+static orderedIntSet *buildSet(const int *elems, int count, const BenchBackend *backend) {
+    orderedIntSet *s = createOrderedSetFromArray(elems, (size_t) count, CREATE_FROM_UNSORTED | backend->flags);
+
+    if (s == NULL) {
+        fprintf(stderr, "[ERROR] Memory allocation failed for a benchmark set.\n");
+        exit(-1);
+    }
+
+    return s;
+}
+
+/**
+ * @brief Times a set operation and deletes its result.
+*/
+static double timeSetOperation(BenchOperation operation, orderedIntSet *a, orderedIntSet *b) {
+    double start = nowSeconds();
+    orderedIntSet *result;
+
+    if (operation == BENCH_UNION) {
+        result = setUnion(a, b);
+    }
+    else if (operation == BENCH_INTERSECTION) {
+        result = setIntersection(a, b);
+    }
+    else {
+        result = setDifference(a, b);
+    }
+    double seconds = nowSeconds() - start;
+
+    if (result == NULL) {
+        fprintf(stderr, "[ERROR] Memory allocation failed for a benchmark result.\n");
+        exit(-1);
+    }
+    deleteOrderedSet(result);
+
+    return seconds;
+}
+
+/**
+ * @brief Writes one row of results.
+*/
+static void reportResult(BenchOptions *options, const char *backend, BenchDistribution distribution,
+                         BenchOperation operation, int size, long long ops, double seconds) {
+    double nsPerOp = seconds * 1e9 / (double) ops;
+    double opsPerSecond = seconds > 0 ? (double) ops / seconds : 0;
+
+    if (options->json) {
+        printf("%s{\"backend\":\"%s\",\"distribution\":\"%s\",\"operation\":\"%s\",\"size\":%d,\"ops\":%lld,"
+               "\"seconds\":%.9f,\"ns_per_op\":%.2f,\"ops_per_second\":%.0f,\"peak_rss_kb\":%lld}",
+               options->rows > 0 ? ",\n" : "[\n", backend, distributionNames[distribution],
+               operationNames[operation], size, ops, seconds, nsPerOp, opsPerSecond, peakMemoryKb());
+    }
+    else {
+        if (options->rows == 0) {
+            printf("backend,distribution,operation,size,ops,seconds,ns_per_op,ops_per_second,peak_rss_kb\n");
+        }
+        printf("%s,%s,%s,%d,%lld,%.9f,%.2f,%.0f,%lld\n", backend, distributionNames[distribution],
+               operationNames[operation], size, ops, seconds, nsPerOp, opsPerSecond, peakMemoryKb());
+    }
+    options->rows++;
+    fflush(stdout);
+}
+
+/**
+ * @brief Measures every operation not yet skipped for one backend, distribution and size.
+ *
+ * ***Pseudocode:***
+ * 1. Generate the elements
+ * 2. Repeat `options->repeat` times, keeping the fastest time of each operation:
+ *      - Build the first set, timed unless the distribution is skewed
+ *      - Build the second set and time the set operations
+ *      - Time printing, adding and then removing elements, unless the distribution is skewed
+ *      - Delete both sets
+ * 3. Report the operations and mark those slower than the budget as skipped
+ *
+ * @param options The `BenchOptions`.
+ * @param backend The backend measured.
+ * @param distribution The distribution measured.
+ * @param size Number of elements of the first set.
+ * @param skipped Per `BenchOperation`, 1 if it is no longer measured; updated.
+*/
+static void benchmarkSize(BenchOptions *options, const BenchBackend *backend, BenchDistribution distribution,
+                          int size, int *skipped) {
+    double best[BENCH_OPERATIONS];
+    long long ops[BENCH_OPERATIONS];
+    int single = distribution != DIST_SKEWED;
+    BenchData data;
+
+    generateData(&data, distribution, size, options->seed);
+    ops[BENCH_BUILD] = size;
+    ops[BENCH_ADD] = data.extraCount;
+    ops[BENCH_REMOVE] = data.extraCount;
+    ops[BENCH_PRINT] = size;
+    ops[BENCH_UNION] = ops[BENCH_INTERSECTION] = ops[BENCH_DIFFERENCE] = (long long) size + data.bCount;
+    for (int op = 0; op < BENCH_OPERATIONS; op++) {
+        best[op] = -1;
+        if (!single && op < BENCH_UNION) {
+            skipped[op] = 1;
+        }
+    }
+
+    for (int run = 0; run < options->repeat; run++) {
+        double start = nowSeconds();
+        orderedIntSet *a = buildSet(data.a, data.aCount, backend);
+        double seconds = nowSeconds() - start;
+
+        if (!skipped[BENCH_BUILD] && (best[BENCH_BUILD] < 0 || seconds < best[BENCH_BUILD])) {
+            best[BENCH_BUILD] = seconds;
+        }
+
+        if (!skipped[BENCH_UNION] || !skipped[BENCH_INTERSECTION] || !skipped[BENCH_DIFFERENCE]) {
+            orderedIntSet *b = buildSet(data.b, data.bCount, backend);
+
+            for (int op = BENCH_UNION; op <= BENCH_DIFFERENCE; op++) {
+                if (!skipped[op]) {
+                    seconds = timeSetOperation((BenchOperation) op, a, b);
+                    if (best[op] < 0 || seconds < best[op]) {
+                        best[op] = seconds;
+                    }
+                }
+            }
+            deleteOrderedSet(b);
+        }
+
+        if (!skipped[BENCH_PRINT]) {
+            start = nowSeconds();
+            writeOrderedSet(a, SET_FORMAT_BRACES, options->sink);
+            seconds = nowSeconds() - start;
+            if (best[BENCH_PRINT] < 0 || seconds < best[BENCH_PRINT]) {
+                best[BENCH_PRINT] = seconds;
+            }
+        }
+
+        if (!skipped[BENCH_ADD]) {
+            start = nowSeconds();
+            for (int i = 0; i < data.extraCount; i++) {
+                addElement(a, data.extra[i]);
+            }
+            seconds = nowSeconds() - start;
+            if (best[BENCH_ADD] < 0 || seconds < best[BENCH_ADD]) {
+                best[BENCH_ADD] = seconds;
+            }
+        }
+
+        if (!skipped[BENCH_REMOVE]) {
+            start = nowSeconds();
+            for (int i = 0; i < data.extraCount; i++) {
+                removeElement(a, data.a[i]);
+            }
+            seconds = nowSeconds() - start;
+            if (best[BENCH_REMOVE] < 0 || seconds < best[BENCH_REMOVE]) {
+                best[BENCH_REMOVE] = seconds;
+            }
+        }
+
+        deleteOrderedSet(a);
+    }
+
+    for (int op = 0; op < BENCH_OPERATIONS; op++) {
+        if (best[op] >= 0) {
+            reportResult(options, backend->name, distribution, (BenchOperation) op, size, ops[op], best[op]);
+            if (best[op] > options->budget) {
+                skipped[op] = 1;
+            }
+        }
+    }
+    freeData(&data);
+}
+
+/**
+ * @brief Finds a name in a list of names.
+ *
+ * @return The index of `name` in `names`, or -1 if it is not there.
+*/
+static int findName(const char *name, const char **names, int count) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(name, names[i]) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Reads the command line options.
+ *
+ * @return 1 on success, 0 if an option is unknown or its value is invalid.
+*/
+static int parseOptions(int argc, char *argv[], BenchOptions *options) {
+    const char *backendNames[BENCH_BACKENDS];
+
+    for (int i = 0; i < BENCH_BACKENDS; i++) {
+        backendNames[i] = backends[i].name;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (value == NULL) {
+            return 0;// Every option takes a value
+        }
+        if (strcmp(argv[i], "--format") == 0 && (strcmp(value, "csv") == 0 || strcmp(value, "json") == 0)) {
+            options->json = strcmp(value, "json") == 0;
+        }
+        else if (strcmp(argv[i], "--max-size") == 0) {
+            long size = strtol(value, NULL, 10);
+            if (size < BENCH_MIN_SIZE || size > BENCH_MAX_SIZE * 10L) {
+                return 0;
+            }
+            options->maxSize = (int) size;
+        }
+        else if (strcmp(argv[i], "--backend") == 0) {
+            if ((options->backend = findName(value, backendNames, BENCH_BACKENDS)) < 0) {
+                return 0;
+            }
+        }
+        else if (strcmp(argv[i], "--distribution") == 0) {
+            if ((options->distribution = findName(value, distributionNames, DIST_COUNT)) < 0) {
+                return 0;
+            }
+        }
+        else if (strcmp(argv[i], "--repeat") == 0) {
+            if ((options->repeat = atoi(value)) < 1) {
+                return 0;
+            }
+        }
+        else if (strcmp(argv[i], "--budget") == 0) {
+            if ((options->budget = atof(value)) <= 0) {
+                return 0;
+            }
+        }
+        else if (strcmp(argv[i], "--seed") == 0) {
+            options->seed = strtoull(value, NULL, 10);
+        }
+        else {
+            return 0;
+        }
+        i++;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Runs the benchmark.
+ *
+ * ***Pseudocode:***
+ * 1. Read the options
+ * 2. For each selected backend and distribution, measure sizes 10, 100, ... up to the largest size, skipping the
+ *    operations that went over the budget at a smaller size
+ * 3. Close the JSON array
+ *
+ * @param argc Number of command line arguments.
+ * @param argv The command line arguments.
+ *
+ * @return 0 on success, 1 if the options are invalid.
+*/
+int main(int argc, char *argv[]) {
+    BenchOptions options = {0, BENCH_MAX_SIZE, -1, -1, 3, 5.0, 1, 0, NULL};
+
+    if (!parseOptions(argc, argv, &options)) {
+        fprintf(stderr, "Usage: %s [--format csv|json] [--max-size n] [--backend list|indexed|array|bitmap]\n"
+                        "       [--distribution sequential|random|clustered|skewed] [--repeat n] [--budget seconds]"
+                        " [--seed n]\n", argv[0]);
+        return 1;
+    }
+    options.sink = fopen(BENCH_NULL_DEVICE, "w");
+    if (options.sink == NULL) {
+        fprintf(stderr, "[ERROR] Could not open %s.\n", BENCH_NULL_DEVICE);
+        return 1;
+    }
+
+    for (int backend = 0; backend < BENCH_BACKENDS; backend++) {
+        if (options.backend >= 0 && options.backend != backend) {
+            continue;
+        }
+        for (int distribution = 0; distribution < DIST_COUNT; distribution++) {
+            int skipped[BENCH_OPERATIONS] = {0};
+
+            if (options.distribution >= 0 && options.distribution != distribution) {
+                continue;
+            }
+            for (long size = BENCH_MIN_SIZE; size <= options.maxSize; size *= 10) {
+                benchmarkSize(&options, &backends[backend], (BenchDistribution) distribution, (int) size, skipped);
+            }
+        }
+    }
+
+    if (options.json) {
+        printf(options.rows > 0 ? "\n]\n" : "[]\n");
+    }
+    fclose(options.sink);
+
+    return 0;
+}
+
+// 
+
+// END OF BENCHMARK.C
\ No newline at end of file
@@ -0,0 +1,82 @@
+/**
+ * @file ConcurrentSet.h
+ *
+ * @brief Header file for defining the concurrent ordered set, which writers modify while readers scan it.
+ *
+ * @details
+ * A `concurrentIntSet` is a sorted linked list that one writer at a time modifies while any number of readers
+ * look elements up or iterate over it, without ever waiting for the writer or for each other.
+ * - Every change gets a new version number. A node records the version it was added in and the one it was removed
+ *   in, so a reader that noted the version when it started sees exactly the elements of that version: a
+ *   consistent snapshot, however long it takes and whatever the writers do meanwhile.
+ * - Removed nodes stay linked until no reader can still be reading an older version, and are freed once no reader
+ *   can still be standing on them. Both waits are grace periods of an `EpochDomain`, see `EpochReclaimer.h`.
+ * - Writers take a lock among themselves; readers never take it.
+ *
+ * Each thread using a set opens a `SetSession` of its own and passes it to every call.
+ *
+ * @date 17/10/2026
+ */
+#ifndef ConcurrentSet_h
+#define ConcurrentSet_h
+#include "OrderedList.h"
+#include "EpochReclaimer.h"
+
+#define CONCURRENT_NEVER 0x7FFFFFFFFFFFFFFFLL /**< Removal version of an element that is still in the set. */
+
+/**
+ * @struct ConcurrentNode
+ * @brief One element of a concurrent set, with the versions it is visible in.
+ *
+ * Readers only follow `next` and read `elem`, `added` and `removed`; the other fields belong to the writer.
+ */
+typedef struct concurrentNode {
+    int elem; /**< The element. */
+    long long added; /**< Version the element was added in. */
+    volatile long long removed; /**< Version the element was removed in, `CONCURRENT_NEVER` while in the set. */
+    struct concurrentNode *volatile next; /**< Next node, including removed nodes that are still linked. */
+    struct concurrentNode *prev; /**< Previous linked node, the head node for the first one (writer only). */
+    long long removedEpoch; /**< Global epoch right after the removal (writer only). */
+    struct concurrentNode *pending; /**< Next removed node waiting to be unlinked (writer only). */
+} ConcurrentNode;
+
+/**
+ * @struct concurrentIntSet
+ * @brief An ordered set of integers that writers modify while readers scan consistent snapshots of it.
+ */
+typedef struct concurrentIntSet concurrentIntSet;
+
+/**
+ * @struct SetSession
+ * @brief One thread's access to a `concurrentIntSet`; it must not be shared between threads.
+ */
+typedef struct setSession SetSession;
+
+/**
+ * @struct SnapshotCursor
+ * @brief Reads the elements of one version of a concurrent set in ascending order.
+ *
+ * The cursor stays inside a critical section of its session from `startSnapshotCursor()` until
+ * `endSnapshotCursor()`, which holds back the freeing of removed nodes: do not keep it open longer than needed.
+ */
+typedef struct {
+    SetSession *session; /**< Session the cursor reads through. */
+    long long version; /**< Version being read. */
+    ConcurrentNode *node; /**< Node holding the next element, NULL when done. */
+} SnapshotCursor;
+
+concurrentIntSet *createConcurrentSet();
+ReturnValues deleteConcurrentSet(concurrentIntSet *s);
+SetSession *openSetSession(concurrentIntSet *s);
+void closeSetSession(SetSession *session);
+ReturnValues concurrentAddElement(SetSession *session, int elem);
+ReturnValues concurrentRemoveElement(SetSession *session, int elem);
+int concurrentContainsElement(SetSession *session, int elem);
+int getConcurrentSetSize(concurrentIntSet *s);
+void startSnapshotCursor(SetSession *session, SnapshotCursor *cursor);
+int snapshotCursorHasElement(const SnapshotCursor *cursor);
+int snapshotCursorElement(const SnapshotCursor *cursor);
+void snapshotCursorAdvance(SnapshotCursor *cursor);
+void endSnapshotCursor(SnapshotCursor *cursor);
+orderedIntSet *snapshotConcurrentSet(SetSession *session);
+#endif
@@ -0,0 +1,577 @@
+/**
+ * @file ConcurrentSetFunctions.c
+ *
+ * @brief Implementation of the concurrent ordered set, which writers modify while readers scan it.
+ *
+ * @details This file provides the implementation for:
+ *   - Creating and deleting concurrent sets, and opening and closing sessions on them.
+ *   - Adding and removing elements under the writer lock, publishing a new version for each change.
+ *   - Looking elements up and iterating over a version without locks.
+ *   - Unlinking and freeing removed nodes once their grace periods are over.
+ *
+ * @date 17/10/2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ConcurrentSet.h"
+#include "SyncPrimitives.h"
+
+/**
+ * @struct concurrentIntSet
+ * @brief The list, its latest version and the state shared by the writers.
+ */
+struct concurrentIntSet {
+    ConcurrentNode *head; /**< Node before the first element; holds no element and is never removed. */
+    volatile long long version; /**< Latest published version. */
+    volatile long long size; /**< Number of elements in the latest version. */
+    EpochDomain *domain; /**< Grace periods of the readers and writers of this set. */
+    Mutex writer; /**< Held by the writer changing the set. */
+    ConcurrentNode *firstPending; /**< Oldest removed node that is still linked (writer only). */
+    ConcurrentNode *lastPending; /**< Newest removed node that is still linked (writer only). */
+    int sinceCollect; /**< Changes since the writers last tried to advance the epoch (writer only). */
+};
+
+/**
+ * @struct setSession
+ * @brief A thread's slot in the epoch domain of a set.
+ */
+struct setSession {
+    concurrentIntSet *set; /**< The set. */
+    EpochSlot *slot; /**< The thread's slot in `set->domain`. */
+};
+
+/**
+ * @brief Creates a new, empty, concurrent set.
+ *
+ * @pre None.
+ * @post The set is at version 0 and no session is open on it.
+ *
+ * ***Pseudocode:***
+ * 1. Allocate the set, its head node and its epoch domain
+ * 2. If allocation fails:
+ *      - Print error message
+ *      - Exit program
+ * 3. Initialize the writer lock, version and size to 0, and no pending nodes
+ * 4. Return the set
+ *
+ * @return A pointer to the newly created set, or exits the program on allocation failure.
+*/
+concurrentIntSet *createConcurrentSet() {
+    concurrentIntSet *s = (concurrentIntSet *) malloc(sizeof(concurrentIntSet));
+    ConcurrentNode *head = (ConcurrentNode *) calloc(1, sizeof(ConcurrentNode));
+    EpochDomain *domain = createEpochDomain();
+
+    // Check if memory allocation failed
+    if (s == NULL || head == NULL || domain == NULL) {
+        // Print an error message and terminate the program if allocation fails
+        printf("[ERROR] Could not allocate heap memory when creating concurrent set. Exiting...\n");
+        exit(-1);
+    }
+
+    head->removed = CONCURRENT_NEVER;
+    s->head = head;
+    s->version = 0;
+    s->size = 0;
+    s->domain = domain;
+    initMutex(&s->writer);
+    s->firstPending = NULL;
+    s->lastPending = NULL;
+    s->sinceCollect = 0;
+
+    return s;
+}
+
+/**
+ * @brief Deletes a concurrent set and all of its nodes.
+ *
+ * @pre No session is open on the set.
+ * @post The nodes, including removed ones, the epoch domain and the set are freed.
+ *
+ * @param s A pointer to the `concurrentIntSet` to be deleted.
+ *
+ * @return `ALLOCATION_ERROR` if `s` is NULL, otherwise `NUMBER_REMOVED`.
+*/
+ReturnValues deleteConcurrentSet(concurrentIntSet *s) {
+    // Check if the input set pointer is NULL
+    if (s == NULL) {
+        return ALLOCATION_ERROR;
+    }
+
+    // Removed nodes still linked are freed here, unlinked ones by the epoch domain
+    ConcurrentNode *node = s->head;
+    while (node != NULL) {
+        ConcurrentNode *next = node->next;
+        free(node);
+        node = next;
+    }
+    deleteEpochDomain(s->domain);
+    destroyMutex(&s->writer);
+    free(s);
+
+    return NUMBER_REMOVED;
+}
+
+/**
+ * @brief Opens a session through which the calling thread reads and modifies a concurrent set.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post The session holds a slot of the set's epoch domain until `closeSetSession()`.
+ *
+ * @param s A pointer to the `concurrentIntSet`.
+ *
+ * @return A pointer to the new `SetSession`, or NULL if memory could not be allocated or `EPOCH_MAX_THREADS`
+ *         sessions are already open on the set.
+*/
+SetSession *openSetSession(concurrentIntSet *s) {
+    SetSession *session = (SetSession *) malloc(sizeof(SetSession));
+
+    if (session == NULL) {
+        return NULL;
+    }
+    session->set = s;
+    session->slot = joinEpochDomain(s->domain);
+    if (session->slot == NULL) {
+        free(session);
+        return NULL;
+    }
+
+    return session;
+}
+
+/**
+ * @brief Closes a session opened with `openSetSession()`.
+ *
+ * @pre No snapshot cursor of the session is open.
+ * @post The slot of the session is free for another thread.
+ *
+ * @param session A pointer to the `SetSession`, or NULL.
+*/
+void closeSetSession(SetSession *session) {
+    if (session == NULL) {
+        return;
+    }
+
+    leaveEpochDomain(session->slot);
+    free(session);
+}
+
+/**
+ * @brief Checks whether a node belongs to a version of the set.
+ *
+ * @return 1 if the node was added in or before `version` and not removed by then, else 0.
+*/
+static int visibleIn(const ConcurrentNode *node, long long version) {
+    return node->added <= version && version < atomicLoadCounter(&node->removed);
+}
+
+/**
+ * @brief Skips the nodes that do not belong to a version of the set.
+ *
+ * @return The first node from `node` on that is visible in `version`, or NULL if there is none.
+*/
+static ConcurrentNode *nextVisible(ConcurrentNode *node, long long version) {
+    while (node != NULL && !visibleIn(node, version)) {
+        node = (ConcurrentNode *) atomicLoadPointer(&node->next);
+    }
+
+    return node;
+}
+
+/**
+ * @brief Finds the node holding an element in the latest version of the set (writer only).
+ *
+ * @details
+ * - Removed nodes with the same element may still be linked; they are kept in front of the node holding the element
+ *   now, so the search passes them.
+ *
+ * @param s A pointer to the `concurrentIntSet`, whose writer lock is held.
+ * @param elem The element to look for.
+ * @param pred Receives the last node before the position of `elem`.
+ *
+ * @return The node holding `elem`, or NULL if `elem` is not in the set.
+*/
+static ConcurrentNode *findElement(concurrentIntSet *s, int elem, ConcurrentNode **pred) {
+    ConcurrentNode *node = s->head;
+
+    while (node->next != NULL
+           && (node->next->elem < elem || (node->next->elem == elem && node->next->removed != CONCURRENT_NEVER))) {
+        node = node->next;
+    }
+    *pred = node;
+
+    return (node->next != NULL && node->next->elem == elem) ? node->next : NULL;
+}
+
+/**
+ * @brief Unlinks the removed nodes no reader can see any more and hands them to the epoch domain (writer only).
+ *
+ * @pre The calling thread holds the writer lock and is inside a critical section of `session`.
+ * @post Every removed node whose grace period is over is unlinked and retired.
+ *
+ * @details
+ * - A node removed in version `r` must stay linked for readers of older versions. Its removal was made visible
+ *   before `removedEpoch` was read, so a reader that started two epochs later reads a version from `r` on: once
+ *   the epoch is two past `removedEpoch`, no reader still needs the node and it is unlinked.
+ * - Readers may still be standing on an unlinked node, so it is retired rather than freed, see `epochRetire()`.
+ *   It is retired only once it is unlinked, so its retire epoch is one no reader entering later can reach it in.
+ *   Room to retire it is reserved first, so running out of memory just leaves it linked, like in
+ *   `lockFreeRemoveElement()`.
+ * - Nodes are removed in epoch order, so the ones to unlink are at the front of the pending list.
+ * - Every `EPOCH_COLLECT_INTERVAL` changes the writer tries to advance the epoch itself, so removed nodes move on
+ *   even when nothing is retired.
+ *
+ * ***Pseudocode:***
+ * 1. If nodes are pending and `EPOCH_COLLECT_INTERVAL` changes were made since the last try, advance the epoch
+ * 2. While the oldest pending node was removed at least two epochs ago:
+ *      - Reserve room to retire it, stop if that fails
+ *      - Link its predecessor to its successor and its successor back to its predecessor
+ *      - Retire it and drop it from the pending list
+ *
+ * @param s A pointer to the `concurrentIntSet`.
+ * @param session The writer's `SetSession`.
+*/
+static void unlinkRemoved(concurrentIntSet *s, SetSession *session) {
+    if (s->firstPending != NULL && ++s->sinceCollect >= EPOCH_COLLECT_INTERVAL) {
+        epochCollect(s->domain, session->slot);
+        s->sinceCollect = 0;
+    }
+
+    while (s->firstPending != NULL && s->firstPending->removedEpoch + 2 <= epochCurrent(s->domain)) {
+        ConcurrentNode *node = s->firstPending;
+
+        if (epochReserve(session->slot) != ok) {
+            break;// Stays linked and is tried again on the next change
+        }
+        // Readers coming along now skip the node; readers already on it still find its successor
+        atomicStorePointer(&node->prev->next, node->next);
+        if (node->next != NULL) {
+            node->next->prev = node->prev;
+        }
+        epochRetire(s->domain, session->slot, node, free);// Cannot fail after the reserve
+        s->firstPending = node->pending;
+        if (s->firstPending == NULL) {
+            s->lastPending = NULL;
+        }
+    }
+}
+
+/**
+ * @brief Adds an integer element to a concurrent set.
+ *
+ * @pre `session` is an open session of the calling thread.
+ * @post If `elem` was not in the set, a new version holding it is published.
+ *
+ * @details
+ * - Writers take turns through the writer lock; readers are not blocked and go on reading their version.
+ * - The new node is fully built before it is linked in, and linked in before the version that contains it is
+ *   published, so a reader either skips it as too new or finds it complete.
+ *
+ * ***Pseudocode:***
+ * 1. If `session` is NULL, return `ALLOCATION_ERROR`
+ * 2. Enter a critical section and take the writer lock
+ * 3. Unlink removed nodes whose grace period is over
+ * 4. Find the position of `elem`; if it is in the set, the result is `NUMBER_ALREADY_IN_SET`
+ * 5. Otherwise:
+ *      - Create a node for `elem` added in the next version (`ALLOCATION_ERROR` if that fails)
+ *      - Link it in after its predecessor
+ *      - Increment the size and publish the next version
+ * 6. Release the writer lock, leave the critical section and return the result
+ *
+ * @param session The calling thread's `SetSession`.
+ * @param elem The integer element to be added.
+ *
+ * @return `NUMBER_ADDED` if successful, `NUMBER_ALREADY_IN_SET` if `elem` exists, or `ALLOCATION_ERROR` on failure.
+*/
+ReturnValues concurrentAddElement(SetSession *session, int elem) {
+    if (session == NULL) {
+        return ALLOCATION_ERROR;
+    }
+
+    concurrentIntSet *s = session->set;
+    ConcurrentNode *pred;
+    ReturnValues result = NUMBER_ADDED;
+
+    epochEnter(s->domain, session->slot);
+    lockMutex(&s->writer);
+    unlinkRemoved(s, session);
+
+    if (findElement(s, elem, &pred) != NULL) {
+        result = NUMBER_ALREADY_IN_SET;
+    }
+    else {
+        ConcurrentNode *node = (ConcurrentNode *) malloc(sizeof(ConcurrentNode));
+
+        if (node == NULL) {
+            result = ALLOCATION_ERROR;
+        }
+        else {
+            long long version = s->version + 1;
+
+            node->elem = elem;
+            node->added = version;
+            node->removed = CONCURRENT_NEVER;
+            node->next = pred->next;
+            node->prev = pred;
+            node->removedEpoch = 0;
+            node->pending = NULL;
+            if (pred->next != NULL) {
+                pred->next->prev = node;
+            }
+            // Link the finished node in, then publish the version it belongs to
+            atomicStorePointer(&pred->next, node);
+            atomicStoreCounter(&s->size, s->size + 1);
+            atomicStoreCounter(&s->version, version);
+        }
+    }
+
+    unlockMutex(&s->writer);
+    epochExit(session->slot);
+
+    return result;
+}
+
+/**
+ * @brief Removes an integer element from a concurrent set.
+ *
+ * @pre `session` is an open session of the calling thread.
+ * @post If `elem` was in the set, a new version without it is published.
+ *
+ * @details
+ * - The node is only marked with the version it was removed in: readers of older versions still see it. It is
+ *   unlinked and freed by later changes once no reader needs it, see `unlinkRemoved()`.
+ *
+ * ***Pseudocode:***
+ * 1. If `session` is NULL, return `ALLOCATION_ERROR`
+ * 2. Enter a critical section and take the writer lock
+ * 3. Unlink removed nodes whose grace period is over
+ * 4. Find the node holding `elem`; if there is none, the result is `NUMBER_NOT_IN_SET`
+ * 5. Otherwise:
+ *      - Mark it removed in the next version, decrement the size and publish the next version
+ *      - Note the global epoch after a full fence, and append the node to the pending list
+ * 6. Release the writer lock, leave the critical section and return the result
+ *
+ * @param session The calling thread's `SetSession`.
+ * @param elem The integer element to be removed.
+ *
+ * @return `NUMBER_REMOVED` if successful, `NUMBER_NOT_IN_SET` if `elem` is not in the set, or `ALLOCATION_ERROR`
+ *         if `session` is NULL.
+*/
+ReturnValues concurrentRemoveElement(SetSession *session, int elem) {
+    if (session == NULL) {
+        return ALLOCATION_ERROR;
+    }
+
+    concurrentIntSet *s = session->set;
+    ConcurrentNode *pred;
+    ReturnValues result = NUMBER_REMOVED;
+
+    epochEnter(s->domain, session->slot);
+    lockMutex(&s->writer);
+    unlinkRemoved(s, session);
+
+    ConcurrentNode *node = findElement(s, elem, &pred);
+    if (node == NULL) {
+        result = NUMBER_NOT_IN_SET;
+    }
+    else {
+        long long version = s->version + 1;
+
+        atomicStoreCounter(&node->removed, version);
+        atomicStoreCounter(&s->size, s->size - 1);
+        atomicStoreCounter(&s->version, version);
+        // The epoch is read after the removal is visible, see unlinkRemoved()
+        atomicFence();
+        node->removedEpoch = epochCurrent(s->domain);
+        if (s->lastPending != NULL) {
+            s->lastPending->pending = node;
+        }
+        else {
+            s->firstPending = node;
+        }
+        s->lastPending = node;
+    }
+
+    unlockMutex(&s->writer);
+    epochExit(session->slot);
+
+    return result;
+}
+
+/**
+ * @brief Checks whether an integer element is in the latest version of a concurrent set.
+ *
+ * @pre `session` is an open session of the calling thread.
+ * @post The set is unchanged.
+ *
+ * @details
+ * - Takes no lock and never waits: the lookup reads the version published when it starts and walks the list from
+ *   the head, skipping nodes of other versions.
+ *
+ * ***Pseudocode:***
+ * 1. If `session` is NULL, return 0
+ * 2. Enter a critical section and read the latest version
+ * 3. Walk the list while the element is smaller than or equal to `elem`:
+ *      - If a node holds `elem` and is visible in the version, it is found
+ * 4. Leave the critical section and return whether it was found
+ *
+ * @param session The calling thread's `SetSession`.
+ * @param elem The integer element to look for.
+ *
+ * @return 1 if `elem` is in the set, otherwise 0.
+*/
+int concurrentContainsElement(SetSession *session, int elem) {
+    if (session == NULL) {
+        return 0;
+    }
+
+    concurrentIntSet *s = session->set;
+    int found = 0;
+
+    epochEnter(s->domain, session->slot);
+    long long version = atomicLoadCounter(&s->version);
+    ConcurrentNode *node = (ConcurrentNode *) atomicLoadPointer(&s->head->next);
+    while (node != NULL && node->elem <= elem && !found) {
+        found = node->elem == elem && visibleIn(node, version);
+        node = (ConcurrentNode *) atomicLoadPointer(&node->next);
+    }
+    epochExit(session->slot);
+
+    return found;
+}
+
+/**
+ * @brief Returns the number of elements in the latest version of a concurrent set.
+ *
+ * @param s A pointer to the `concurrentIntSet`.
+ *
+ * @return The number of elements, or 0 if `s` is NULL.
+*/
+int getConcurrentSetSize(concurrentIntSet *s) {
+    if (s == NULL) {
+        return 0;
+    }
+
+    return (int) atomicLoadCounter(&s->size);
+}
+
+/**
+ * @brief Positions a cursor on the first element of the latest version of a concurrent set.
+ *
+ * @pre `session` is an open session of the calling thread.
+ * @post The cursor reads the version published now, whatever writers do until `endSnapshotCursor()`.
+ *
+ * ***Pseudocode:***
+ * 1. Enter a critical section of `session`
+ * 2. Read the latest version
+ * 3. Move to the first node visible in it
+ *
+ * @param session The calling thread's `SetSession`.
+ * @param cursor The `SnapshotCursor` to start.
+*/
+void startSnapshotCursor(SetSession *session, SnapshotCursor *cursor) {
+    concurrentIntSet *s = session->set;
+
+    cursor->session = session;
+    epochEnter(s->domain, session->slot);
+    cursor->version = atomicLoadCounter(&s->version);
+    cursor->node = nextVisible((ConcurrentNode *) atomicLoadPointer(&s->head->next), cursor->version);
+}
+
+/**
+ * @brief Checks whether a snapshot cursor has an element left.
+ *
+ * @param cursor The `SnapshotCursor`.
+ *
+ * @return 1 if `snapshotCursorElement()` may be called, 0 once every element was read.
+*/
+int snapshotCursorHasElement(const SnapshotCursor *cursor) {
+    return cursor->node != NULL;
+}
+
+/**
+ * @brief Returns the element a snapshot cursor is on.
+ *
+ * @pre `snapshotCursorHasElement(cursor)` is 1.
+ *
+ * @param cursor The `SnapshotCursor`.
+ *
+ * @return The element.
+*/
+int snapshotCursorElement(const SnapshotCursor *cursor) {
+    return cursor->node->elem;
+}
+
+/**
+ * @brief Moves a snapshot cursor on to the next element of its version.
+ *
+ * @pre `snapshotCursorHasElement(cursor)` is 1.
+ *
+ * @param cursor The `SnapshotCursor`.
+*/
+void snapshotCursorAdvance(SnapshotCursor *cursor) {
+    cursor->node = nextVisible((ConcurrentNode *) atomicLoadPointer(&cursor->node->next), cursor->version);
+}
+
+/**
+ * @brief Closes a snapshot cursor, letting the nodes it may have been reading be freed.
+ *
+ * @pre The cursor was started with `startSnapshotCursor()` and not ended yet.
+ * @post The cursor is done and its session left the critical section entered for it.
+ *
+ * @param cursor The `SnapshotCursor`.
+*/
+void endSnapshotCursor(SnapshotCursor *cursor) {
+    cursor->node = NULL;
+    epochExit(cursor->session->slot);
+}
+
+/**
+ * @brief Copies the latest version of a concurrent set into a new ordered set.
+ *
+ * @pre `session` is an open session of the calling thread.
+ * @post A new array backed `orderedIntSet` holds the elements of the version; the concurrent set is unchanged.
+ *
+ * @details
+ * - The copy can be used with all functions of `OrderedList.h`, such as the set operations, without holding back
+ *   the reclamation of the concurrent set for longer than the copy takes.
+ *
+ * ***Pseudocode:***
+ * 1. Create new array backed ordered set `result`
+ * 2. Start a snapshot cursor and append each of its elements to `result`
+ * 3. End the cursor
+ * 4. Return `result`, or NULL if appending failed
+ *
+ * @param session The calling thread's `SetSession`.
+ *
+ * @return A pointer to the new `orderedIntSet`, or NULL on allocation failure.
+*/
+orderedIntSet *snapshotConcurrentSet(SetSession *session) {
+    if (session == NULL) {
+        return NULL;
+    }
+
+    orderedIntSet *result = createOrderedSetWithBackend(SET_BACKEND_ARRAY);
+    SnapshotCursor cursor;
+    llError status = ok;
+
+    for (startSnapshotCursor(session, &cursor); snapshotCursorHasElement(&cursor) && status == ok;
+         snapshotCursorAdvance(&cursor)) {
+        // The version is sorted, so every element goes after the last one
+        status = sortedArrayAppend(result->array, snapshotCursorElement(&cursor));
+        result->size++;
+    }
+    endSnapshotCursor(&cursor);
+
+    if (status != ok) {
+        // Clean up and return NULL if memory allocation fails
+        deleteOrderedSet(result);
+        return NULL;
+    }
+
+    return result;// Return the copy
+}
+
+// 
+
+// END OF CONCURRENTSETFUNCTIONS.C
\ No newline at end of file
@@ -19,6 +19,8 @@
 
 #include "DoubleLinkedListTypeDefs.h"
 #include "DoubleLinkedListFunctions.h"
+#include "NodePoolFunctions.h"
+#include "SetStats.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -34,32 +36,74 @@
 * - Head points to tail resulting in NULL.
 * - Set the current pointer to the head node.
 * 
+* - The list gets a node pool of its own, see 'createDoubleLinkedListWithPool' to share one.
+*
+* ***PSEUDOCODE***
+* 1. Create a new node pool
+* 2. If successfully created, then;
+*		- Create a list using that pool
+*		- Release the creator's hold on the pool, so the list is its only user
+* 3. return list, end.
+* *****************
+*
+* @return: Pointer to created DoubleLinkedList if successful,
+*		   Pointer to NULL if it fails.
+*/
+DoubleLinkedList* createDoubleLinkedList() {
+	DoubleLinkedList* list = NULL;		// pointer variable 'list' declared of type 'DoubleLinkedList*'
+	NodePool* pool = createNodePool();	// private pool for the nodes of this list
+
+	if (pool != NULL) { // Checks if pool creation was successful
+		list = createDoubleLinkedListWithPool(pool);
+		releaseNodePool(pool); // The list holds its own reference, or the pool is freed if the list failed
+	}
+	return list;
+}
+
+
+/**
+* @brief Creates a new empty double linked list that takes its nodes from an existing node pool.
+*
+* @pre valid node pool exists
+* @post Empty double linked list is created and registered as a user of the pool
+*
+* @details
+* - Several lists can share a pool, e.g. lists that are built and thrown away together.
+* - The pool is freed when the last list using it is deleted.
+*
 * ***PSEUDOCODE***
 * 1. Allocate memory for list
 * 2. If successfully allocated, then;
-*		- Allocate memory for head node.
+*		- Take the head node from the pool.
 * 3.		then if head allocation successful, then;
 *				- Set next & previous node from head to NULL
-* 4,		else 
+*				- Set tail and current to the head
+*				- Register the list as a user of the pool
+* 4,		else
 *				- free lists memory
 *				- set list to NULL
 * 5. return list, end.
 * *****************
-* 
+*
+* @param pool - A pointer to the 'NodePool' to take nodes from
+*
 * @return: Pointer to created DoubleLinkedList if successful,
 *		   Pointer to NULL if it fails.
 */
-DoubleLinkedList* createDoubleLinkedList() {
-	DoubleLinkedList* list; // pointer variable 'list' declared of type 'DoubleLinkedList*' 
+DoubleLinkedList* createDoubleLinkedListWithPool(NodePool* pool) {
+	DoubleLinkedList* list; // pointer variable 'list' declared of type 'DoubleLinkedList*'
 	list = (DoubleLinkedList*)malloc(sizeof(DoubleLinkedList)); // allocates enough memory to hold a 'DoubleLinkedList' structure
-	
+
 	if (list != NULL) { // Checks if list allocation was successful
-		list->head = (Node*)malloc(sizeof(Node)); // Attempts to allocate memory for the head node.
+		list->head = allocateNode(pool); // Attempts to take the head node from the pool.
 		//Check if successful
 		if (list->head != NULL) { // Checks if head allocation was successful
 			list->head->next = NULL; // Head's next pointer set to NULL
 			list->head->prev = NULL; // Head's previous pointer set to NULL
+			list->tail = list->head; // The head is the last node of an empty list
 			list->current = list->head; // Set the current pointer to the head
+			list->pool = pool; // Nodes of this list come from the pool
+			retainNodePool(pool); // The pool must outlive this list
 		}
 		//If it failed, deallocate the list and set it NULL
 		else {
@@ -67,7 +111,7 @@ DoubleLinkedList* createDoubleLinkedList() {
 			list = NULL; // set it to NULL.
 		}
 	}
-	return list; 
+	return list;
 }
 
 
@@ -79,16 +123,17 @@ DoubleLinkedList* createDoubleLinkedList() {
 * 
 * @details 
 * This deletes all nodes in the 'DoubleLinkedList' and frees the memory allocated for the list structure itself.
-* Iterates through all nodes and frees them one by one.
+* If the list is the only user of its node pool, all nodes are freed at once together with the pool.
+* If the pool is shared with other lists, the nodes are given back to the pool one by one instead.
 * 
 * ***PSEUDOCODE***
 * 0. dont do anything if list is NULL
-* 1. Set current node to head
-* 2. while loop for it to get to the end of the loop (Next doesnt equal NULL).
-*		3. Set current node to head
-*		4. Set next node to next next node
-*		5. free up the next node.
-* 6. free head and list after ending while loop
+* 1. If other lists share the pool, then;
+*		2. while loop for it to get to the end of the loop (Next doesnt equal NULL).
+*			3. Set next node to next next node
+*			4. give the skipped node back to the pool.
+*		5. give the head back to the pool
+* 6. release the pool (frees all of its slabs if this list was its last user) and free the list
 * *****************
 * 
 * @param list - A pointer to the 'DoubleLinkedList' thats to be deleted
@@ -104,17 +149,20 @@ void deleteDoubleLinkedList(DoubleLinkedList* list) {
 	
 	Node* nextNode; // temporary pointer to hold the next node
 
-	// Starting from beginning of the list
-	list->current = list->head; // sets current pointer to head node.
-	
-	// Iterate through all nodes in list and delete all nodes until list is empty
-	while (list->head->next != NULL) {
-		nextNode = list->head->next;				// Store the pointer in the next node
-		list->head->next = list->head->next->next;	// Update head's next node to skip the current node
-		free(nextNode);								// Free the skipped node
+	// Nodes only have to be handed back one by one if other lists keep using the pool
+	if (list->pool->users > 1) {
+		// Iterate through all nodes in list and recycle all nodes until list is empty
+		while (list->head->next != NULL) {
+			nextNode = list->head->next;				// Store the pointer in the next node
+			list->head->next = list->head->next->next;	// Update head's next node to skip the current node
+			recycleNode(nextNode, list->pool);			// Give the skipped node back to the pool
+			STATS_COUNT(nodeFrees, 1);
+		}
+		recycleNode(list->head, list->pool);	// Give the head node back to the pool
+		STATS_COUNT(nodeFrees, 1);
 	}
-	free(list->head);	// Free the head node
-	free(list);			// Free the list
+	releaseNodePool(list->pool);	// Frees every node at once if this list was the last user
+	free(list);						// Free the list
 }
 
 /**
@@ -180,6 +228,7 @@ llError gotoNextNode(DoubleLinkedList* list) {
 	if (list->current->next != NULL) {
 		// no -> move current to the next node
 		list->current = list->current->next;
+		STATS_COUNT(nodeHops, 1);
 	}
 	else {
 		// yes -> the current node is the tail so...
@@ -218,6 +267,7 @@ llError gotoPreviousNode(DoubleLinkedList* list) {
 	if (list->current != list->head) {
 		// no -> move the current node to the previous node
 			list->current = list->current->prev;
+			STATS_COUNT(nodeHops, 1);
 	}
 	else {
 		// yes -> the current node is the head so...
@@ -252,22 +302,17 @@ void gotoHead(DoubleLinkedList* list) {
 * @pre valid double linked list exists.
 * @post current node is set to tail.
 * 
-* @details updates the current pointer to point to last valid node before the tail. Not the tail because its often a placeholder and no further operations can be performed.
+* @details updates the current pointer to point to the last node, which the list keeps track of, so no node is walked.
 * 
 * ***PSEUDOCODE***
-* 1. while loop while next doesnt equal tail (NULL)
-*		- set current to next current
+* 1. set current to the last node
 * 
 * @param list - A pointer to the 'DoubleLinkedList'
 * 
 * @note no modifcaiton to the structure is done.
 */
 void gotoTail(DoubleLinkedList* list) {
-	// While loop selects the next node until the last valid node (nefore the tail) is selected.
-	// If the tail was selected, nothing else could be done (no further operation could perform)
-	while (list->current->next != NULL) {
-		list->current = list->current->next; // Move current pointer to the next node
-	}
+	list->current = list->tail; // Set the current pointer to the last node
 }
 
 /**
@@ -283,12 +328,13 @@ void gotoTail(DoubleLinkedList* list) {
 * ***PSEUDOCODE***
 * 0. cant insert if current is the tail, so if current is NULL, then
 *		- return illegal argument.
-* 1. allocate memory for the new node
+* 1. take a node for the new node from the list's pool
 *		1.5. if its unsuccesfull, return no memory error
 * 2. set new node's data to data
 * 3. set new nodes precessor and succesor to current and next after current
 * 4. if current next is not the tail (NULL), then, 
 *		- set current's next previous to the new node
+*	  else, the new node becomes the last node
 * 5. set current next to new node.
 * *****************
 * 
@@ -297,7 +343,7 @@ void gotoTail(DoubleLinkedList* list) {
 * 
 * @return 'llError' status code
 * 
-* @note Dynamically allocates memory for the new node.
+* @note The new node is taken from the list's node pool, which allocates memory in slabs.
 */
 llError insertAfter(data* d, DoubleLinkedList* list) {
 	llError returnvalue = ok; // indicates no errors
@@ -308,7 +354,7 @@ llError insertAfter(data* d, DoubleLinkedList* list) {
 		returnvalue = illegalNode;
 	}
 	else {
-		newnode = (Node*)malloc(sizeof(Node)); // allocates memory for new node
+		newnode = allocateNode(list->pool); // takes a node for new node from the pool
 
 		// is allocation successful?
 		if (newnode == NULL) {
@@ -327,6 +373,10 @@ llError insertAfter(data* d, DoubleLinkedList* list) {
 				// 3. Set the previous pointer of next node to newnode.
 				list->current->next->prev = newnode;
 			}
+			else {
+				// 3. otherwise newnode is the new last node
+				list->tail = newnode;
+			}
 			// 4. set next pointer of current node to point to the newnode
 			list->current->next = newnode;
 		}
@@ -348,7 +398,7 @@ llError insertAfter(data* d, DoubleLinkedList* list) {
 * ***PSEUDOCODE***
 * 0. cant insert if current is the head, so then
 *		- return illegal argument.
-* 1. allocate memory for the new node
+* 1. take a node for the new node from the list's pool
 *		1.5. if its unsuccesfull, return no memory error
 * 2. set new node's data to data
 * 3. set new nodes succesor and precessor to current and before current
@@ -361,7 +411,7 @@ llError insertAfter(data* d, DoubleLinkedList* list) {
 * 
 * @return ''llError' status code
 * 
-* @note Dynamically allocates memory for the new node.
+* @note The new node is taken from the list's node pool, which allocates memory in slabs.
 */
 llError insertBefore(data* d, DoubleLinkedList* list) {
 	llError returnvalue = ok; // indicates no errors
@@ -372,7 +422,7 @@ llError insertBefore(data* d, DoubleLinkedList* list) {
 		returnvalue = illegalNode;
 	}
 	else {
-		newnode = (Node*)malloc(sizeof(Node)); // allocates memory for newnode
+		newnode = allocateNode(list->pool); // takes a node for newnode from the pool
 
 		// is allocation successful?
 		if (newnode == NULL) {
@@ -412,11 +462,12 @@ llError insertBefore(data* d, DoubleLinkedList* list) {
 * 2. store current (which will be deleted) in a temperary varable
 * 3. if next is null, then;
 *		- set current's previous ad next to NULL
+*		- set the last node to current's previous
 * 4. else set the following;
 *		- current previous next to current next
 *		- curent next previous to current previous
 * 5. set current to current's previous
-* 6. free the temp varable
+* 6. give the temp varable back to the list's pool
 * ****************
 * 
 * @param list - A pointer to the 'DoubleLinkedList', thats where the current node is deleted from.
@@ -440,10 +491,12 @@ llError deleteCurrent(DoubleLinkedList* list) {
 		todelete = list->current;
 		// 2. Set Successor of previous to successor of node to be deleted.
 		list->current->prev->next = todelete->next;
-		// 3. Set the current node to the previous node
+		// 3. Set the current node to the previous node, which is now the last node
 		list->current = todelete->prev;
-		// 4. Free the memory of the deleted node
-		free(todelete);
+		list->tail = todelete->prev;
+		// 4. Give the deleted node back to the pool for reuse
+		recycleNode(todelete, list->pool);
+		STATS_COUNT(nodeFrees, 1);
 	}
 	else {
 		// 1. Keep the current node to be deleted.
@@ -454,11 +507,74 @@ llError deleteCurrent(DoubleLinkedList* list) {
 		list->current->next->prev = todelete->prev;
 		// 4. Set the current node to the previous node
 		list->current = todelete->prev;
-		// 5. Free the memory of the deleted node
-		free(todelete);
+		// 5. Give the deleted node back to the pool for reuse
+		recycleNode(todelete, list->pool);
+		STATS_COUNT(nodeFrees, 1);
 	}
 	return result;
 }
+
+/**
+* @brief Moves every node of another list in after the current node and deletes the other list.
+* 
+* @pre valid double linked lists exist, and 'other' shares the pool of 'list' or is the only user of its own pool
+* @post the nodes of 'other' follow the current node in their original order, current is on the last moved node,
+*		 and 'other' is deleted. Otherwise both lists remain unchanged and an error is returned.
+* 
+* @details
+* No node is copied: the chain of 'other' is relinked as a whole, and if it comes from another pool that pool is
+* absorbed by the pool of 'list' (see 'absorbNodePool'). Used to join lists that were built separately, e.g. in
+* parallel. Both lists know their last node, so the join takes time independent of their lengths.
+* 
+* ***PSEUDOCODE***
+* 0. cant move nodes if there is no current node or the other pool is still used by other lists, so then
+*		- return illegal argument.
+* 1. absorb the pool of 'other' into the pool of 'list'
+* 2. if 'other' is not empty, then;
+*		- link its first node after current and its last node before current's successor
+*		- if current was the last node of 'list', its last node becomes the last node of 'list'
+*		- set current to its last node
+* 3. give the head of 'other' back to the pool, free 'other' and release its pool
+* *****************
+* 
+* @param list - A pointer to the 'DoubleLinkedList' that takes the nodes
+* @param other - A pointer to the 'DoubleLinkedList' that is emptied and deleted
+* 
+* @return 'llError' status code
+*/
+llError appendDoubleLinkedList(DoubleLinkedList* list, DoubleLinkedList* other) {
+	Node* first;	// first node of the other list
+	Node* last;		// last node of the other list
+
+	// Nodes of a shared pool cannot be moved without the pool's other lists noticing
+	if (list->current == NULL || (other->pool != list->pool && other->pool->users > 1)) {
+		return illegalNode;
+	}
+
+	absorbNodePool(list->pool, other->pool);
+
+	first = other->head->next;
+	if (first != NULL) {
+		last = other->tail; // End of the chain that is moved
+		// Link the chain in between current and its successor
+		last->next = list->current->next;
+		if (list->current->next != NULL) {
+			list->current->next->prev = last;
+		}
+		else {
+			list->tail = last; // The chain ends the list
+		}
+		first->prev = list->current;
+		list->current->next = first;
+		list->current = last; // Further appends continue behind the moved nodes
+	}
+
+	// The head of 'other' now belongs to the pool of 'list'
+	recycleNode(other->head, list->pool);
+	releaseNodePool(other->pool);
+	free(other);
+	return ok;
+}
 // 
 
 // END OF DOUBLELINKEDLISTFUNCTIONS.C
\ No newline at end of file
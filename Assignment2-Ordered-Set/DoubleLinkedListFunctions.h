@@ -21,6 +21,7 @@
 #define DoubleLinkedListFunctions_h
 
 DoubleLinkedList* createDoubleLinkedList();
+DoubleLinkedList* createDoubleLinkedListWithPool(NodePool* pool);
 void deleteDoubleLinkedList(DoubleLinkedList* list);
 data* getData(DoubleLinkedList* list);
 llError gotoNextNode(DoubleLinkedList* list);
@@ -30,6 +31,7 @@ void gotoTail(DoubleLinkedList* list);
 llError insertAfter(data* d, DoubleLinkedList* list);
 llError insertBefore(data* d, DoubleLinkedList* list);
 llError deleteCurrent(DoubleLinkedList* list);
+llError appendDoubleLinkedList(DoubleLinkedList* list, DoubleLinkedList* other);
 
 #endif //DoubleLinkedListFunctions_h
 
@@ -21,6 +21,8 @@
 #ifndef DoubleLinkedListTypeDefs_h
 #define DoubleLinkedListTypeDefs_h
 
+#include <stddef.h>
+
 /**
 * @enum llError
 *
@@ -62,16 +64,51 @@ typedef struct n {		///< dummy name (n) before declaring Node name
 } Node;
 
 
+#define NODE_POOL_FIRST_SLAB 32		///< Number of nodes carved out by a pool's first slab.
+#define NODE_POOL_MAX_SLAB 8192		///< Upper limit for the number of nodes in one slab.
+
+/**
+* @struct NodeSlab
+*
+* @brief One block of nodes allocated in bulk by a node pool.
+*
+* @details The nodes themselves are stored directly after this header in the same allocation.
+*/
+typedef struct nodeSlab {	///< dummy name (nodeSlab) before declaring NodeSlab name
+	struct nodeSlab* next;	///< Pointer to the previously allocated slab of the same pool.
+	size_t capacity;		///< Number of nodes stored in this slab.
+} NodeSlab;
+
+/**
+* @struct NodePool
+*
+* @brief Hands out nodes for one or more double linked lists.
+*
+* @details it has the following;
+* - a chain of slabs, each holding many nodes next to each other in memory
+* - a free list of nodes given back by 'deleteCurrent', linked through their 'next' pointer
+* - the number of lists using the pool, so it can be shared and freed by the last one
+*/
+typedef struct {
+	NodeSlab* slabs;	///< Pointer to the newest slab (older slabs are chained behind it).
+	size_t used;		///< Number of nodes of the newest slab handed out so far.
+	Node* freeList;		///< Pointer to the first recycled node, NULL if there is none.
+	int users;			///< Number of lists sharing this pool.
+} NodePool;
+
+
 /**
 * @struct DoubleLinkedList
 * 
 * @brief Represents the entire double linked list.
 *
-* @details It keeps track of the 'head' and 'current' node.
+* @details It keeps track of the 'head', 'tail' and 'current' node, and of the pool its nodes are allocated from.
 */
 typedef struct {
 	Node* head;			///< Pointer to the first node. 
+	Node* tail;			///< Pointer to the last node, the head if the list is empty.
 	Node* current;		///< Pointer the the current node.
+	NodePool* pool;		///< Pointer to the pool the nodes are taken from.
 } DoubleLinkedList;
 
 
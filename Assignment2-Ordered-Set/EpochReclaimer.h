@@ -0,0 +1,83 @@
+/**
+ * @file EpochReclaimer.h
+ *
+ * @brief Header file for defining the epoch based reclaimer that frees memory other threads may still be reading.
+ *
+ * @details
+ * A concurrent data structure cannot free a node the moment it unlinks it: a reader that loaded a pointer to the
+ * node just before may still be looking at it. The reclaimer defers the free instead:
+ * - Every thread taking part claims a slot of the domain and brackets each access with `epochEnter()` and
+ *   `epochExit()`, announcing the global epoch it started in. Both are a few stores, so readers never wait.
+ * - An unlinked node is handed to `epochRetire()`, which files it under the current global epoch.
+ * - The global epoch only moves on once every thread inside a critical section has announced the current one, so
+ *   once it is two epochs past the epoch a node was retired in, no thread can still hold a pointer to the node and
+ *   it is freed.
+ *
+ * A thread that stays inside a critical section forever stops the epoch, so memory is then only retired, never
+ * freed. Critical sections should be short.
+ *
+ * @date 17/10/2026
+ */
+#ifndef EpochReclaimer_h
+#define EpochReclaimer_h
+#include "DoubleLinkedListTypeDefs.h"
+
+#define EPOCH_MAX_THREADS 256 /**< Threads that can take part in one domain at the same time. */
+#define EPOCH_COLLECT_INTERVAL 64 /**< Retired pointers after which `epochRetire()` tries to free some. */
+
+/**
+ * @typedef EpochRelease
+ * @brief Frees a retired pointer once no thread can be reading it any more.
+ */
+typedef void (*EpochRelease)(void *ptr);
+
+/**
+ * @struct EpochRetired
+ * @brief A pointer waiting for its grace period to pass.
+ */
+typedef struct {
+    void *ptr; /**< The retired memory. */
+    EpochRelease release; /**< Frees `ptr`. */
+    long long epoch; /**< Global epoch the pointer was retired in. */
+} EpochRetired;
+
+/**
+ * @struct EpochSlot
+ * @brief The state of one thread taking part in an `EpochDomain`.
+ *
+ * `epoch` and `active` are read by every thread advancing the epoch; the rest is only used by the thread owning the
+ * slot. Slots are padded to a cache line each so that announcing an epoch does not slow down other threads.
+ */
+typedef struct {
+    volatile long long epoch; /**< Global epoch announced when the outermost critical section was entered. */
+    volatile long long active; /**< 1 while the owner is inside a critical section. */
+    volatile long long claimed; /**< 1 while a thread owns the slot. */
+    int depth; /**< Nesting depth of the owner's critical sections. */
+    int count; /**< Number of pointers in `retired`. */
+    int capacity; /**< Number of pointers `retired` has room for. */
+    int sinceCollect; /**< Pointers retired since the last `epochCollect()`. */
+    EpochRetired *retired; /**< Pointers retired by the owner and not freed yet, oldest first. */
+    char padding[16]; /**< Fills the slot up to 64 bytes on 64-bit targets. */
+} EpochSlot;
+
+/**
+ * @struct EpochDomain
+ * @brief The global epoch and the slots of the threads sharing it, usually one domain per data structure.
+ */
+typedef struct {
+    volatile long long epoch; /**< The global epoch. */
+    volatile long long slotsUsed; /**< One past the highest slot ever claimed, so scans can stop there. */
+    EpochSlot slots[EPOCH_MAX_THREADS]; /**< One slot per participating thread. */
+} EpochDomain;
+
+EpochDomain *createEpochDomain();
+void deleteEpochDomain(EpochDomain *domain);
+EpochSlot *joinEpochDomain(EpochDomain *domain);
+void leaveEpochDomain(EpochSlot *slot);
+void epochEnter(EpochDomain *domain, EpochSlot *slot);
+void epochExit(EpochSlot *slot);
+long long epochCurrent(EpochDomain *domain);
+llError epochReserve(EpochSlot *slot);
+llError epochRetire(EpochDomain *domain, EpochSlot *slot, void *ptr, EpochRelease release);
+void epochCollect(EpochDomain *domain, EpochSlot *slot);
+#endif
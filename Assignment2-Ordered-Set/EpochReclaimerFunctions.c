@@ -0,0 +1,301 @@
+/**
+ * @file EpochReclaimerFunctions.c
+ *
+ * @brief Implementation of the epoch based reclaimer used by the concurrent sets.
+ *
+ * @details This file provides the implementation for:
+ *   - Creating and deleting epoch domains, and joining and leaving them.
+ *   - Entering and leaving critical sections.
+ *   - Reserving room for and retiring memory, and freeing it once every thread is past it.
+ *
+ * @date 17/10/2026
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "EpochReclaimer.h"
+#include "SyncPrimitives.h"
+
+/**
+ * @brief Creates an epoch domain with no threads in it.
+ *
+ * @pre None.
+ * @post The global epoch is 0 and every slot is free.
+ *
+ * @return A pointer to the new `EpochDomain`, or NULL if memory could not be allocated.
+*/
+EpochDomain *createEpochDomain() {
+    EpochDomain *domain = (EpochDomain *) malloc(sizeof(EpochDomain));
+
+    if (domain == NULL) {
+        return NULL;
+    }
+    memset(domain, 0, sizeof(EpochDomain));
+
+    return domain;
+}
+
+/**
+ * @brief Frees an epoch domain and everything still retired in it.
+ *
+ * @pre No thread is inside a critical section of the domain or uses it any more.
+ * @post Every retired pointer is released and the domain is freed.
+ *
+ * @param domain A pointer to the `EpochDomain`, or NULL.
+*/
+void deleteEpochDomain(EpochDomain *domain) {
+    if (domain == NULL) {
+        return;
+    }
+
+    // Nobody can be reading any more, so the grace periods are over
+    for (int i = 0; i < EPOCH_MAX_THREADS; i++) {
+        EpochSlot *slot = &domain->slots[i];
+
+        for (int k = 0; k < slot->count; k++) {
+            slot->retired[k].release(slot->retired[k].ptr);
+        }
+        free(slot->retired);
+    }
+
+    free(domain);
+}
+
+/**
+ * @brief Claims a free slot of a domain for the calling thread.
+ *
+ * @pre None.
+ * @post The slot is owned by the caller until `leaveEpochDomain()`; it must not be used by other threads.
+ *
+ * @details
+ * - A slot left by another thread may still hold pointers it retired; the new owner frees them in its collections.
+ *
+ * ***Pseudocode:***
+ * 1. For every slot:
+ *      - If it can be claimed by swapping `claimed` from 0 to 1:
+ *          - Raise `slotsUsed` to include it
+ *          - Return it
+ * 2. Return NULL
+ *
+ * @param domain A pointer to the `EpochDomain`.
+ *
+ * @return A pointer to the claimed `EpochSlot`, or NULL if `EPOCH_MAX_THREADS` threads are already in the domain.
+*/
+EpochSlot *joinEpochDomain(EpochDomain *domain) {
+    for (int i = 0; i < EPOCH_MAX_THREADS; i++) {
+        EpochSlot *slot = &domain->slots[i];
+
+        if (atomicLoadCounter(&slot->claimed) == 0 && atomicCasCounter(&slot->claimed, 0, 1)) {
+            // Scans of the slots have to reach this one from now on
+            long long used = atomicLoadCounter(&domain->slotsUsed);
+            while (used < i + 1 && !atomicCasCounter(&domain->slotsUsed, used, i + 1)) {
+                used = atomicLoadCounter(&domain->slotsUsed);
+            }
+            slot->depth = 0;
+            slot->sinceCollect = 0;
+            return slot;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Gives a slot back to its domain.
+ *
+ * @pre The calling thread owns `slot` and is not inside a critical section.
+ * @post The slot is free; pointers it retired stay in it until its next owner or the domain frees them.
+ *
+ * @param slot A pointer to the `EpochSlot`, or NULL.
+*/
+void leaveEpochDomain(EpochSlot *slot) {
+    if (slot == NULL) {
+        return;
+    }
+
+    atomicStoreCounter(&slot->claimed, 0);
+}
+
+/**
+ * @brief Enters a critical section: pointers loaded from now on stay valid until the matching `epochExit()`.
+ *
+ * @pre The calling thread owns `slot`.
+ * @post The slot announces the global epoch and is active. Critical sections may be nested.
+ *
+ * @details
+ * - Wait-free: announcing takes two stores and a fence, whatever other threads are doing.
+ * - The fence makes the announcement visible before anything the critical section reads, so a thread advancing
+ *   the epoch either sees this slot or the critical section sees everything retired before the advance as unlinked.
+ *
+ * ***Pseudocode:***
+ * 1. If this is the outermost critical section of the slot:
+ *      - Announce the global epoch, mark the slot active
+ *      - Issue a full fence
+ * 2. Increment the nesting depth
+ *
+ * @param domain A pointer to the `EpochDomain`.
+ * @param slot The caller's `EpochSlot`.
+*/
+void epochEnter(EpochDomain *domain, EpochSlot *slot) {
+    if (slot->depth++ == 0) {
+        atomicStoreCounter(&slot->epoch, atomicLoadCounter(&domain->epoch));
+        atomicStoreCounter(&slot->active, 1);
+        atomicFence();
+    }
+}
+
+/**
+ * @brief Leaves a critical section entered with `epochEnter()`.
+ *
+ * @pre The calling thread owns `slot` and is inside a critical section.
+ * @post Once the outermost critical section is left, the slot no longer holds the epoch back.
+ *
+ * @param slot The caller's `EpochSlot`.
+*/
+void epochExit(EpochSlot *slot) {
+    if (--slot->depth == 0) {
+        atomicStoreCounter(&slot->active, 0);
+    }
+}
+
+/**
+ * @brief Returns the global epoch of a domain.
+ *
+ * @param domain A pointer to the `EpochDomain`.
+ *
+ * @return The global epoch.
+*/
+long long epochCurrent(EpochDomain *domain) {
+    return atomicLoadCounter(&domain->epoch);
+}
+
+/**
+ * @brief Makes sure a slot has room to retire one more pointer, so that the next `epochRetire()` cannot fail.
+ *
+ * @pre The calling thread owns `slot`.
+ * @post If `ok` is returned, the next call to `epochRetire()` for `slot` returns `ok`.
+ *
+ * @details
+ * - Lock-free structures call this before they unlink memory: once a node is unlinked nobody else will retire it,
+ *   so the retire must not fail.
+ *
+ * ***Pseudocode:***
+ * 1. If the list of retired pointers is full, double it:
+ *      - If that fails, return `noMemory`
+ * 2. Return `ok`
+ *
+ * @param slot The caller's `EpochSlot`.
+ *
+ * @return `ok`, or `noMemory` if the list of retired pointers could not grow.
+*/
+llError epochReserve(EpochSlot *slot) {
+    if (slot->count == slot->capacity) {
+        int capacity = slot->capacity > 0 ? slot->capacity * 2 : EPOCH_COLLECT_INTERVAL;
+        EpochRetired *retired = (EpochRetired *) realloc(slot->retired, (size_t) capacity * sizeof(EpochRetired));
+
+        if (retired == NULL) {
+            return noMemory;// The old list is still valid
+        }
+        slot->retired = retired;
+        slot->capacity = capacity;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Hands unlinked memory to the reclaimer, to be released once no thread can be reading it any more.
+ *
+ * @pre `ptr` can no longer be reached by threads entering a critical section from now on, and the calling thread
+ *      owns `slot`.
+ * @post `ptr` is released by a later collection of the slot, or by `deleteEpochDomain()`.
+ *
+ * @details
+ * - Every `EPOCH_COLLECT_INTERVAL` pointers the slot is collected, so retired memory does not pile up.
+ *
+ * ***Pseudocode:***
+ * 1. Make room for one more pointer, see `epochReserve()`:
+ *      - If that fails, return `noMemory`
+ * 2. Append `ptr` with the global epoch
+ * 3. If `EPOCH_COLLECT_INTERVAL` pointers were retired since the last collection, collect
+ * 4. Return `ok`
+ *
+ * @param domain A pointer to the `EpochDomain`.
+ * @param slot The caller's `EpochSlot`.
+ * @param ptr The memory to release.
+ * @param release The function releasing it.
+ *
+ * @return `ok`, or `noMemory` if the pointer could not be recorded; it is then not released.
+*/
+llError epochRetire(EpochDomain *domain, EpochSlot *slot, void *ptr, EpochRelease release) {
+    if (epochReserve(slot) != ok) {
+        return noMemory;
+    }
+
+    slot->retired[slot->count].ptr = ptr;
+    slot->retired[slot->count].release = release;
+    slot->retired[slot->count].epoch = epochCurrent(domain);
+    slot->count++;
+
+    if (++slot->sinceCollect >= EPOCH_COLLECT_INTERVAL) {
+        epochCollect(domain, slot);
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Advances the global epoch if possible and releases the pointers of a slot whose grace period is over.
+ *
+ * @pre The calling thread owns `slot`.
+ * @post Pointers the slot retired at least two epochs ago are released.
+ *
+ * @details
+ * - The epoch moves from `e` to `e + 1` only if every active slot announced `e`. A thread inside a critical
+ *   section therefore holds the epoch at most one past its own, and a pointer retired in epoch `e` is unreachable
+ *   for every thread once the epoch reaches `e + 2`.
+ * - Pointers are retired in epoch order, so the ones to release are at the front of the list.
+ *
+ * ***Pseudocode:***
+ * 1. Read the global epoch `e`
+ * 2. If no active slot announced an epoch other than `e`, try to swap the global epoch from `e` to `e + 1`
+ * 3. Release the retired pointers of `slot` whose epoch is at least two below the global epoch
+ * 4. Move the remaining pointers to the front of the list
+ *
+ * @param domain A pointer to the `EpochDomain`.
+ * @param slot The caller's `EpochSlot`.
+*/
+void epochCollect(EpochDomain *domain, EpochSlot *slot) {
+    long long epoch;
+    long long used = atomicLoadCounter(&domain->slotsUsed);
+    int behind = 0;
+    int released = 0;
+
+    atomicFence();// Everything retired so far is unlinked before the slots are read
+    epoch = epochCurrent(domain);
+    for (int i = 0; i < used && !behind; i++) {
+        EpochSlot *other = &domain->slots[i];
+        behind = atomicLoadCounter(&other->active) && atomicLoadCounter(&other->epoch) != epoch;
+    }
+    if (!behind && atomicCasCounter(&domain->epoch, epoch, epoch + 1)) {
+        epoch++;
+    }
+    else {
+        epoch = epochCurrent(domain);
+    }
+
+    // Release the pointers no thread can reach any more
+    while (released < slot->count && slot->retired[released].epoch + 2 <= epoch) {
+        slot->retired[released].release(slot->retired[released].ptr);
+        released++;
+    }
+    if (released > 0) {
+        memmove(slot->retired, slot->retired + released, (size_t) (slot->count - released) * sizeof(EpochRetired));
+        slot->count -= released;
+    }
+    slot->sinceCollect = 0;
+}
+
+// ���������������������������������������������������������������������������������������������������������������������
+
+// END OF EPOCHRECLAIMERFUNCTIONS.C
\ No newline at end of file
@@ -0,0 +1,60 @@
+/**
+ * @file LockFreeSet.h
+ *
+ * @brief Header file for defining the lock-free ordered set, which any number of threads modify at the same time.
+ *
+ * @details
+ * A `lockFreeIntSet` is a sorted singly linked list in the style of Harris and Michael. No operation takes a lock:
+ * - An element is added by swapping it into its predecessor's `next` with a compare-and-swap (CAS).
+ * - An element is removed in two steps. First the low bit of its own `next` is set with a CAS, which removes it
+ *   logically and stops anything from being linked in after it. Then it is unlinked with a CAS on its predecessor's
+ *   `next`, by the remover or by any later operation passing by.
+ * - A failed CAS means another thread changed the list at that spot; the operation searches again. Some thread
+ *   always makes progress, so a thread that is stopped or slow never blocks the others.
+ * - Unlinked nodes may still be read by threads that loaded them before, so they are freed through an
+ *   `EpochDomain`, see `EpochReclaimer.h`.
+ *
+ * The functions return the same `ReturnValues` as `addElement()` and `removeElement()`. Each call takes effect at
+ * one instant between its start and its end; a size or copy read while other threads change the set is only
+ * approximate. Each thread using a set opens a `LockFreeSession` of its own and passes it to every call.
+ *
+ * @date 17/10/2026
+ */
+#ifndef LockFreeSet_h
+#define LockFreeSet_h
+#include "OrderedList.h"
+#include "EpochReclaimer.h"
+
+/**
+ * @struct LockFreeNode
+ * @brief One element of a lock-free set.
+ *
+ * The low bit of `next` is the removal mark, so nodes must be at least 2-byte aligned, which `malloc()` guarantees.
+ */
+typedef struct lockFreeNode {
+    int elem; /**< The element. */
+    struct lockFreeNode *volatile next; /**< Next node, with the low bit set once this node is removed. */
+} LockFreeNode;
+
+/**
+ * @struct lockFreeIntSet
+ * @brief An ordered set of integers that threads modify concurrently without locks.
+ */
+typedef struct lockFreeIntSet lockFreeIntSet;
+
+/**
+ * @struct LockFreeSession
+ * @brief One thread's access to a `lockFreeIntSet`; it must not be shared between threads.
+ */
+typedef struct lockFreeSession LockFreeSession;
+
+lockFreeIntSet *createLockFreeSet();
+ReturnValues deleteLockFreeSet(lockFreeIntSet *s);
+LockFreeSession *openLockFreeSession(lockFreeIntSet *s);
+void closeLockFreeSession(LockFreeSession *session);
+ReturnValues lockFreeAddElement(LockFreeSession *session, int elem);
+ReturnValues lockFreeRemoveElement(LockFreeSession *session, int elem);
+int lockFreeContainsElement(LockFreeSession *session, int elem);
+int getLockFreeSetSize(lockFreeIntSet *s);
+orderedIntSet *copyLockFreeSet(LockFreeSession *session);
+#endif
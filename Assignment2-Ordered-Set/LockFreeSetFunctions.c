@@ -0,0 +1,488 @@
+/**
+ * @file LockFreeSetFunctions.c
+ *
+ * @brief Implementation of the lock-free ordered set, which any number of threads modify at the same time.
+ *
+ * @details This file provides the implementation for:
+ *   - Creating and deleting lock-free sets, and opening and closing sessions on them.
+ *   - Adding, removing and looking up elements with compare-and-swap instead of locks.
+ *   - Unlinking removed nodes on the way and freeing them once their grace period is over.
+ *   - Copying a lock-free set into an ordered set.
+ *
+ * @date 17/10/2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "LockFreeSet.h"
+#include "SyncPrimitives.h"
+
+/**
+ * @struct lockFreeIntSet
+ * @brief The list, its size and the epoch domain its nodes are freed through.
+ */
+struct lockFreeIntSet {
+    LockFreeNode *head; /**< Node before the first element; holds no element and is never removed. */
+    volatile long long size; /**< Number of elements, counted when they are marked or linked in. */
+    EpochDomain *domain; /**< Grace periods of the threads using this set. */
+};
+
+/**
+ * @struct lockFreeSession
+ * @brief A thread's slot in the epoch domain of a set.
+ */
+struct lockFreeSession {
+    lockFreeIntSet *set; /**< The set. */
+    EpochSlot *slot; /**< The thread's slot in `set->domain`. */
+};
+
+/**
+ * @brief Checks the removal mark of a `next` pointer.
+ *
+ * @return 1 if the node owning `next` is removed, else 0.
+*/
+static int isMarked(LockFreeNode *next) {
+    return (int) ((uintptr_t) next & 1);
+}
+
+/**
+ * @brief Sets the removal mark of a `next` pointer.
+*/
+static LockFreeNode *marked(LockFreeNode *next) {
+    return (LockFreeNode *) ((uintptr_t) next | 1);
+}
+
+/**
+ * @brief Clears the removal mark of a `next` pointer.
+ *
+ * @return The node `next` points to.
+*/
+static LockFreeNode *unmarked(LockFreeNode *next) {
+    return (LockFreeNode *) ((uintptr_t) next & ~(uintptr_t) 1);
+}
+
+/**
+ * @brief Creates a new, empty, lock-free set.
+ *
+ * @pre None.
+ * @post The set is empty and no session is open on it.
+ *
+ * ***Pseudocode:***
+ * 1. Allocate the set, its head node and its epoch domain
+ * 2. If allocation fails:
+ *      - Print error message
+ *      - Exit program
+ * 3. Initialize the size to 0
+ * 4. Return the set
+ *
+ * @return A pointer to the newly created set, or exits the program on allocation failure.
+*/
+lockFreeIntSet *createLockFreeSet() {
+    lockFreeIntSet *s = (lockFreeIntSet *) malloc(sizeof(lockFreeIntSet));
+    LockFreeNode *head = (LockFreeNode *) calloc(1, sizeof(LockFreeNode));
+    EpochDomain *domain = createEpochDomain();
+
+    // Check if memory allocation failed
+    if (s == NULL || head == NULL || domain == NULL) {
+        // Print an error message and terminate the program if allocation fails
+        printf("[ERROR] Could not allocate heap memory when creating lock-free set. Exiting...\n");
+        exit(-1);
+    }
+
+    s->head = head;
+    s->size = 0;
+    s->domain = domain;
+
+    return s;
+}
+
+/**
+ * @brief Deletes a lock-free set and all of its nodes.
+ *
+ * @pre No session is open on the set.
+ * @post The nodes, including removed ones, the epoch domain and the set are freed.
+ *
+ * @param s A pointer to the `lockFreeIntSet` to be deleted.
+ *
+ * @return `ALLOCATION_ERROR` if `s` is NULL, otherwise `NUMBER_REMOVED`.
+*/
+ReturnValues deleteLockFreeSet(lockFreeIntSet *s) {
+    // Check if the input set pointer is NULL
+    if (s == NULL) {
+        return ALLOCATION_ERROR;
+    }
+
+    // Marked nodes still linked are freed here, unlinked ones by the epoch domain
+    LockFreeNode *node = s->head;
+    while (node != NULL) {
+        LockFreeNode *next = unmarked(node->next);
+        free(node);
+        node = next;
+    }
+    deleteEpochDomain(s->domain);
+    free(s);
+
+    return NUMBER_REMOVED;
+}
+
+/**
+ * @brief Opens a session through which the calling thread reads and modifies a lock-free set.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post The session holds a slot of the set's epoch domain until `closeLockFreeSession()`.
+ *
+ * @param s A pointer to the `lockFreeIntSet`.
+ *
+ * @return A pointer to the new `LockFreeSession`, or NULL if memory could not be allocated or `EPOCH_MAX_THREADS`
+ *         sessions are already open on the set.
+*/
+LockFreeSession *openLockFreeSession(lockFreeIntSet *s) {
+    LockFreeSession *session = (LockFreeSession *) malloc(sizeof(LockFreeSession));
+
+    if (session == NULL) {
+        return NULL;
+    }
+    session->set = s;
+    session->slot = joinEpochDomain(s->domain);
+    if (session->slot == NULL) {
+        free(session);
+        return NULL;
+    }
+
+    return session;
+}
+
+/**
+ * @brief Closes a session opened with `openLockFreeSession()`.
+ *
+ * @pre No call through the session is running.
+ * @post The slot of the session is free for another thread.
+ *
+ * @param session A pointer to the `LockFreeSession`, or NULL.
+*/
+void closeLockFreeSession(LockFreeSession *session) {
+    if (session == NULL) {
+        return;
+    }
+
+    leaveEpochDomain(session->slot);
+    free(session);
+}
+
+/**
+ * @brief Finds the position of an element, unlinking the removed nodes it passes.
+ *
+ * @pre The calling thread is inside a critical section of `session`.
+ *
+ * @details
+ * - A marked node is unlinked with a CAS on the `next` of its predecessor, which only succeeds while the
+ *   predecessor still points to it and is not marked itself. Exactly one thread wins that CAS, and only the winner
+ *   retires the node, so it is freed once.
+ * - Room to retire is reserved before the CAS, so that a node is never unlinked without being retired.
+ * - If any CAS fails, the list changed under the search and it starts over from the head.
+ *
+ * ***Pseudocode:***
+ * 1. Start with the link of the head node
+ * 2. While the link points to a node:
+ *      - If the node is marked:
+ *          - Reserve room to retire it, return -1 if that fails
+ *          - Swap the link from the node to its successor, start over if that fails
+ *          - Retire the node and go on with the successor
+ *      - Else if the node's element is at least `elem`, stop
+ *      - Else move on to the node's own link
+ * 3. Return whether the node reached holds `elem`
+ *
+ * @param session The calling thread's `LockFreeSession`.
+ * @param elem The element to look for.
+ * @param link Receives the unmarked `next` pointing to `*curr`, the position of `elem`.
+ * @param curr Receives the first node whose element is at least `elem`, or NULL.
+ *
+ * @return 1 if `*curr` holds `elem`, 0 if it does not, or -1 if memory could not be allocated.
+*/
+static int findPosition(LockFreeSession *session, int elem, LockFreeNode *volatile **link, LockFreeNode **curr) {
+    lockFreeIntSet *s = session->set;
+    int restart = 1;
+
+    while (restart) {
+        restart = 0;
+        *link = &s->head->next;
+        *curr = (LockFreeNode *) atomicLoadPointer(*link);
+        while (*curr != NULL && !restart) {
+            LockFreeNode *next = (LockFreeNode *) atomicLoadPointer(&(*curr)->next);
+
+            if (isMarked(next)) {
+                if (epochReserve(session->slot) != ok) {
+                    return -1;
+                }
+                if (atomicCasPointer(*link, *curr, unmarked(next))) {
+                    epochRetire(s->domain, session->slot, *curr, free);
+                    *curr = unmarked(next);
+                }
+                else {
+                    restart = 1;// The predecessor was changed or removed meanwhile
+                }
+            }
+            else if ((*curr)->elem >= elem) {
+                break;
+            }
+            else {
+                *link = &(*curr)->next;
+                *curr = next;
+            }
+        }
+    }
+
+    return *curr != NULL && (*curr)->elem == elem;
+}
+
+/**
+ * @brief Adds an integer element to a lock-free set.
+ *
+ * @pre `session` is an open session of the calling thread.
+ * @post If `elem` was not in the set, it is in the set.
+ *
+ * @details
+ * - The element is added at the instant the CAS on its predecessor succeeds. The node is fully built before, and
+ *   the CAS is a full barrier, so a thread that finds the node sees it complete.
+ *
+ * ***Pseudocode:***
+ * 1. If `session` is NULL, return `ALLOCATION_ERROR`
+ * 2. Enter a critical section
+ * 3. Repeat:
+ *      - Find the position of `elem`; stop with `NUMBER_ALREADY_IN_SET` if it is in the set
+ *      - Create a node for `elem` if there is none yet (`ALLOCATION_ERROR` if that fails)
+ *      - Point the node at the node found, and swap it into the link found
+ *      - If the swap succeeds, increment the size and stop with `NUMBER_ADDED`
+ * 4. Free the node if it was not added, leave the critical section and return the result
+ *
+ * @param session The calling thread's `LockFreeSession`.
+ * @param elem The integer element to be added.
+ *
+ * @return `NUMBER_ADDED` if successful, `NUMBER_ALREADY_IN_SET` if `elem` exists, or `ALLOCATION_ERROR` on failure.
+*/
+ReturnValues lockFreeAddElement(LockFreeSession *session, int elem) {
+    if (session == NULL) {
+        return ALLOCATION_ERROR;
+    }
+
+    lockFreeIntSet *s = session->set;
+    LockFreeNode *volatile *link;
+    LockFreeNode *curr;
+    LockFreeNode *node = NULL;
+    ReturnValues result = ALLOCATION_ERROR;
+
+    epochEnter(s->domain, session->slot);
+    for (;;) {
+        int found = findPosition(session, elem, &link, &curr);
+
+        if (found != 0) {
+            result = found > 0 ? NUMBER_ALREADY_IN_SET : ALLOCATION_ERROR;
+            break;
+        }
+        if (node == NULL) {
+            node = (LockFreeNode *) malloc(sizeof(LockFreeNode));
+            if (node == NULL) {
+                break;
+            }
+            node->elem = elem;
+        }
+        node->next = curr;
+        if (atomicCasPointer(link, curr, node)) {
+            atomicAddCounter(&s->size, 1);
+            node = NULL;// Owned by the set now
+            result = NUMBER_ADDED;
+            break;
+        }
+    }
+    epochExit(session->slot);
+
+    free(node);
+
+    return result;
+}
+
+/**
+ * @brief Removes an integer element from a lock-free set.
+ *
+ * @pre `session` is an open session of the calling thread.
+ * @post If `elem` was in the set, it is not in the set.
+ *
+ * @details
+ * - The element is removed at the instant the CAS marking its node succeeds; only one thread can win it, so only
+ *   one remover gets `NUMBER_REMOVED`.
+ * - The remover tries to unlink the node straight away. If that fails, a search is run to unlink it; should that
+ *   fail too, the node stays marked and the next operation passing by unlinks it.
+ *
+ * ***Pseudocode:***
+ * 1. If `session` is NULL, return `ALLOCATION_ERROR`
+ * 2. Enter a critical section
+ * 3. Repeat:
+ *      - Find the node holding `elem`; stop with `NUMBER_NOT_IN_SET` if there is none
+ *      - Mark its `next` with a CAS, try again if that fails
+ *      - Decrement the size
+ *      - Unlink it from the link found and retire it, or search for `elem` again to unlink it
+ *      - Stop with `NUMBER_REMOVED`
+ * 4. Leave the critical section and return the result
+ *
+ * @param session The calling thread's `LockFreeSession`.
+ * @param elem The integer element to be removed.
+ *
+ * @return `NUMBER_REMOVED` if successful, `NUMBER_NOT_IN_SET` if `elem` is not in the set, or `ALLOCATION_ERROR`
+ *         if `session` is NULL or memory could not be allocated.
+*/
+ReturnValues lockFreeRemoveElement(LockFreeSession *session, int elem) {
+    if (session == NULL) {
+        return ALLOCATION_ERROR;
+    }
+
+    lockFreeIntSet *s = session->set;
+    LockFreeNode *volatile *link;
+    LockFreeNode *curr;
+    ReturnValues result;
+
+    epochEnter(s->domain, session->slot);
+    for (;;) {
+        int found = findPosition(session, elem, &link, &curr);
+
+        if (found != 1) {
+            result = found == 0 ? NUMBER_NOT_IN_SET : ALLOCATION_ERROR;
+            break;
+        }
+
+        LockFreeNode *next = (LockFreeNode *) atomicLoadPointer(&curr->next);
+        if (isMarked(next) || !atomicCasPointer(&curr->next, next, marked(next))) {
+            continue;// Another thread removed it or linked a node in after it
+        }
+        atomicAddCounter(&s->size, -1);
+
+        if (epochReserve(session->slot) == ok && atomicCasPointer(link, curr, next)) {
+            epochRetire(s->domain, session->slot, curr, free);
+        }
+        else {
+            findPosition(session, elem, &link, &curr);
+        }
+        result = NUMBER_REMOVED;
+        break;
+    }
+    epochExit(session->slot);
+
+    return result;
+}
+
+/**
+ * @brief Checks whether an integer element is in a lock-free set.
+ *
+ * @pre `session` is an open session of the calling thread.
+ * @post The set is unchanged.
+ *
+ * @details
+ * - Wait-free: the lookup writes nothing and never starts over. It walks past marked nodes instead of unlinking
+ *   them, which is safe because a removed node still points into the list.
+ *
+ * ***Pseudocode:***
+ * 1. If `session` is NULL, return 0
+ * 2. Enter a critical section
+ * 3. Walk the list while the element is smaller than `elem`
+ * 4. The element is found if the node reached holds `elem` and is not marked
+ * 5. Leave the critical section and return whether it was found
+ *
+ * @param session The calling thread's `LockFreeSession`.
+ * @param elem The integer element to look for.
+ *
+ * @return 1 if `elem` is in the set, otherwise 0.
+*/
+int lockFreeContainsElement(LockFreeSession *session, int elem) {
+    if (session == NULL) {
+        return 0;
+    }
+
+    lockFreeIntSet *s = session->set;
+    int found;
+
+    epochEnter(s->domain, session->slot);
+    LockFreeNode *node = unmarked((LockFreeNode *) atomicLoadPointer(&s->head->next));
+    while (node != NULL && node->elem < elem) {
+        node = unmarked((LockFreeNode *) atomicLoadPointer(&node->next));
+    }
+    found = node != NULL && node->elem == elem && !isMarked((LockFreeNode *) atomicLoadPointer(&node->next));
+    epochExit(session->slot);
+
+    return found;
+}
+
+/**
+ * @brief Returns the number of elements in a lock-free set.
+ *
+ * @details
+ * - Exact while no other thread changes the set; otherwise it may count some of the changes still running.
+ *
+ * @param s A pointer to the `lockFreeIntSet`.
+ *
+ * @return The number of elements, or 0 if `s` is NULL.
+*/
+int getLockFreeSetSize(lockFreeIntSet *s) {
+    if (s == NULL) {
+        return 0;
+    }
+
+    return (int) atomicLoadCounter(&s->size);
+}
+
+/**
+ * @brief Copies the elements of a lock-free set into a new ordered set.
+ *
+ * @pre `session` is an open session of the calling thread.
+ * @post A new array backed `orderedIntSet` holds the elements found; the lock-free set is unchanged.
+ *
+ * @details
+ * - The copy holds every element that is in the set during the whole copy and none that is absent during the
+ *   whole copy. Elements added or removed while it runs may or may not be in it; for consistent snapshots under
+ *   concurrent changes use a `concurrentIntSet`, see `ConcurrentSet.h`.
+ *
+ * ***Pseudocode:***
+ * 1. Create new array backed ordered set `result`
+ * 2. Enter a critical section
+ * 3. Walk the list, appending the element of each node that is not marked to `result`
+ * 4. Leave the critical section
+ * 5. Return `result`, or NULL if appending failed
+ *
+ * @param session The calling thread's `LockFreeSession`.
+ *
+ * @return A pointer to the new `orderedIntSet`, or NULL on allocation failure.
+*/
+orderedIntSet *copyLockFreeSet(LockFreeSession *session) {
+    if (session == NULL) {
+        return NULL;
+    }
+
+    lockFreeIntSet *s = session->set;
+    orderedIntSet *result = createOrderedSetWithBackend(SET_BACKEND_ARRAY);
+    llError status = ok;
+
+    epochEnter(s->domain, session->slot);
+    LockFreeNode *node = unmarked((LockFreeNode *) atomicLoadPointer(&s->head->next));
+    while (node != NULL && status == ok) {
+        LockFreeNode *next = (LockFreeNode *) atomicLoadPointer(&node->next);
+
+        // The list is sorted, so every element goes after the last one
+        if (!isMarked(next)) {
+            status = sortedArrayAppend(result->array, node->elem);
+            result->size++;
+        }
+        node = unmarked(next);
+    }
+    epochExit(session->slot);
+
+    if (status != ok) {
+        // Clean up and return NULL if memory allocation fails
+        deleteOrderedSet(result);
+        return NULL;
+    }
+
+    return result;// Return the copy
+}
+
+// 
+
+// END OF LOCKFREESETFUNCTIONS.C
\ No newline at end of file
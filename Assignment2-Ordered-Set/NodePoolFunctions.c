@@ -0,0 +1,313 @@
+/** 
+* @file NodePoolFunctions.c
+* 
+* @brief Implementation of the slab based node pool used by the double linked list.
+*
+* @details Includes the implemented functions for;
+*  - Creating, sharing and releasing a node pool.
+*  - Handing out nodes from slabs or from the free list.
+*  - Giving deleted nodes back to the pool for reuse.
+*
+* Nodes of one list end up next to each other in a few large slabs, so building a list costs one 'malloc'
+* per slab instead of one per node and traversals touch far fewer cache lines.
+*
+* @date 17/10/2026
+*/
+
+#include "DoubleLinkedListTypeDefs.h"
+#include "NodePoolFunctions.h"
+#include "SetStats.h"
+#include <stdlib.h>
+
+/**
+* @brief Creates a new empty node pool used by one list.
+* 
+* @pre None
+* @post Empty node pool is created with one user
+*
+* @details 
+* No slab is allocated yet, the first call to 'allocateNode' allocates it.
+* 
+* ***PSEUDOCODE***
+* 1. Allocate memory for pool
+* 2. If successfully allocated, then;
+*		- set slabs and free list to NULL
+*		- set users to 1
+* 3. return pool, end.
+* *****************
+* 
+* @return: Pointer to created NodePool if successful,
+*		   Pointer to NULL if it fails.
+*/
+NodePool* createNodePool() {
+	NodePool* pool = (NodePool*)malloc(sizeof(NodePool)); // allocates enough memory to hold a 'NodePool' structure
+
+	if (pool != NULL) { // Checks if pool allocation was successful
+		pool->slabs = NULL;		// No slab is allocated until the first node is needed
+		pool->used = 0;			// Nothing handed out yet
+		pool->freeList = NULL;	// No recycled nodes yet
+		pool->users = 1;		// The creator is the first user
+	}
+	return pool;
+}
+
+
+/**
+* @brief Registers one more list as a user of the pool.
+* 
+* @pre valid node pool exists
+* @post the pool is only freed after one more call to 'releaseNodePool'
+* 
+* @param pool - A pointer to the 'NodePool' to be shared
+*/
+void retainNodePool(NodePool* pool) {
+	pool->users++; // One more list takes its nodes from this pool
+}
+
+
+/**
+* @brief Unregisters a user of the pool and frees all slabs when it was the last one.
+* 
+* @pre valid node pool exists
+* @post if no list uses the pool anymore, the pool and all of its slabs are freed.
+* 
+* @details 
+* Every node lives in a slab, so freeing the slabs frees all nodes at once, however many there are.
+* 
+* ***PSEUDOCODE***
+* 0. dont do anything if pool is NULL
+* 1. decrement the number of users
+* 2. if there are no users left, then;
+*		- free every slab in the slab chain
+*		- free the pool
+* *****************
+* 
+* @param pool - A pointer to the 'NodePool' to be released
+* 
+* @warning once the last user releases the pool, all nodes allocated from it become invalid.
+*/
+void releaseNodePool(NodePool* pool) {
+	NodeSlab* toFree; // temporary pointer to hold the slab to free
+
+	if (pool == NULL) {
+		return; // If the pool is NULL, there is nothing to release
+	}
+
+	pool->users--; // One less list uses the pool
+	if (pool->users == 0) {
+		// Free the slabs, which frees every node handed out by the pool
+		while (pool->slabs != NULL) {
+			toFree = pool->slabs;			// Store the newest slab
+			pool->slabs = toFree->next;		// Move on to the slab allocated before it
+			free(toFree);					// Free the slab and all nodes in it
+			STATS_COUNT(slabFrees, 1);
+		}
+		free(pool); // Free the pool itself
+	}
+}
+
+
+/**
+* @brief Hands out an unused node from the pool.
+* 
+* @pre valid node pool exists
+* @post the returned node is owned by the caller until it is given back with 'recycleNode'
+* 
+* @details
+* Recycled nodes are reused first. Otherwise the next node of the newest slab is used,
+* and when that slab is full a new slab twice the size of the previous one is allocated (up to 'NODE_POOL_MAX_SLAB').
+* 
+* ***PSEUDOCODE***
+* 1. If the free list is not empty, then;
+*		- remove and return its first node
+* 2. If there is no slab or the newest slab is full, then;
+*		- allocate a new slab and put it in front of the slab chain
+*		- if its unsuccessfull, return NULL
+* 3. return the next unused node of the newest slab
+* ****************
+* 
+* @param pool - A pointer to the 'NodePool'
+* 
+* @return A pointer to an uninitialised node, or NULL if memory could not be allocated.
+*/
+Node* allocateNode(NodePool* pool) {
+	Node* node;			// node that is handed out
+	NodeSlab* slab;		// temp pointer for a new slab
+	size_t capacity;	// number of nodes in a new slab
+
+	// Reuse a node given back by 'recycleNode' if there is one
+	if (pool->freeList != NULL) {
+		node = pool->freeList;			// Take the first recycled node
+		pool->freeList = node->next;	// The free list continues at its successor
+		STATS_COUNT(nodeAllocations, 1);
+		return node;
+	}
+
+	// Allocate a new slab if there is none yet or the newest one is full
+	if (pool->slabs == NULL || pool->used == pool->slabs->capacity) {
+		capacity = NODE_POOL_FIRST_SLAB;
+		if (pool->slabs != NULL && pool->slabs->capacity < NODE_POOL_MAX_SLAB) {
+			capacity = pool->slabs->capacity * 2; // Grow geometrically so large lists need few slabs
+		}
+		else if (pool->slabs != NULL) {
+			capacity = NODE_POOL_MAX_SLAB;
+		}
+
+		// The nodes are stored directly after the slab header
+		slab = (NodeSlab*)malloc(sizeof(NodeSlab) + capacity * sizeof(Node));
+		if (slab == NULL) {
+			return NULL; // allocation failure
+		}
+		STATS_COUNT(slabAllocations, 1);
+		slab->capacity = capacity;
+		slab->next = pool->slabs;	// Chain the older slabs behind the new one
+		pool->slabs = slab;
+		pool->used = 0;
+	}
+
+	// Hand out the next unused node of the newest slab
+	node = (Node*)(pool->slabs + 1) + pool->used;
+	pool->used++;
+	STATS_COUNT(nodeAllocations, 1);
+	return node;
+}
+
+
+/**
+* @brief Gives a node that is no longer linked into a list back to its pool.
+* 
+* @pre the node was allocated from this pool and is no longer used
+* @post the node is reused by a later call to 'allocateNode'
+* 
+* @details The node is pushed on the free list, using its 'next' pointer as the link.
+* 
+* @param node - A pointer to the 'Node' to give back
+* @param pool - A pointer to the 'NodePool' it was allocated from
+*/
+void recycleNode(Node* node, NodePool* pool) {
+	node->next = pool->freeList;	// Put the node in front of the free list
+	pool->freeList = node;
+}
+
+/**
+* @brief Makes sure the next 'count' calls to 'allocateNode' are served without allocating memory.
+* 
+* @pre valid node pool exists
+* @post at least 'count' nodes are available in the newest slab
+* 
+* @details
+* Used when the number of nodes needed is known in advance, e.g. when a whole list is built at once.
+* If the newest slab is too small, one slab holding exactly 'count' nodes is allocated.
+* The unused rest of the previous slab is moved to the free list so it is not lost.
+* 
+* ***PSEUDOCODE***
+* 1. If the newest slab has at least 'count' unused nodes, return ok
+* 2. Put the unused nodes of the newest slab on the free list
+* 3. Allocate a slab of 'count' nodes and put it in front of the slab chain
+*		- if its unsuccessfull, return no memory error
+* ****************
+* 
+* @param pool - A pointer to the 'NodePool'
+* @param count - Number of nodes that will be needed
+* 
+* @return 'llError' status code
+*/
+llError reserveNodes(NodePool* pool, size_t count) {
+	NodeSlab* slab; // temp pointer for the new slab
+
+	// Nothing to do if the newest slab is big enough
+	if (count == 0 || (pool->slabs != NULL && pool->slabs->capacity - pool->used >= count)) {
+		return ok;
+	}
+
+	// Keep the rest of the newest slab usable through the free list
+	while (pool->slabs != NULL && pool->used < pool->slabs->capacity) {
+		recycleNode((Node*)(pool->slabs + 1) + pool->used, pool);
+		pool->used++;
+	}
+
+	// One slab holding all requested nodes
+	slab = (NodeSlab*)malloc(sizeof(NodeSlab) + count * sizeof(Node));
+	if (slab == NULL) {
+		return noMemory; // allocation failure
+	}
+	STATS_COUNT(slabAllocations, 1);
+	slab->capacity = count;
+	slab->next = pool->slabs;	// Chain the older slabs behind the new one
+	pool->slabs = slab;
+	pool->used = 0;
+	return ok;
+}
+
+/**
+* @brief Moves every slab and recycled node of one pool into another.
+* 
+* @pre both pools are valid, and no list will allocate from or recycle into 'other' while it is being absorbed
+* @post 'pool' owns all nodes of both pools; 'other' is empty and is freed as usual by its last 'releaseNodePool'
+* 
+* @details
+* Used when the nodes of a list are moved into another list, e.g. when partial results built in parallel, each
+* in its own pool, are joined into one list. Only the slab chains and free lists are relinked, no node moves.
+* The unused rest of the newest slab of 'other' goes onto the free list, so 'pool' keeps handing out from its own.
+* 
+* ***PSEUDOCODE***
+* 0. dont do anything if both pools are the same
+* 1. Put the unused nodes of the newest slab of 'other' on the free list of 'pool'
+* 2. Move the free list of 'other' in front of the free list of 'pool'
+* 3. If 'other' has slabs, then;
+*		- if 'pool' has none, 'pool' takes the whole chain (its newest slab is full)
+*		- else link the chain of 'other' right behind the newest slab of 'pool'
+* 4. Leave 'other' without slabs and free list
+* ****************
+* 
+* @param pool - A pointer to the 'NodePool' that takes the nodes
+* @param other - A pointer to the 'NodePool' that gives them up
+*/
+void absorbNodePool(NodePool* pool, NodePool* other) {
+	NodeSlab* last;		// last (oldest) slab of the other pool
+	Node* freeNode;		// walks the free list of the other pool
+
+	if (pool == other) {
+		return; // The nodes already belong to the pool
+	}
+
+	// The rest of the newest slab of 'other' is reused through the free list
+	while (other->slabs != NULL && other->used < other->slabs->capacity) {
+		recycleNode((Node*)(other->slabs + 1) + other->used, pool);
+		other->used++;
+	}
+
+	// Put the recycled nodes of 'other' in front of the free list
+	if (other->freeList != NULL) {
+		freeNode = other->freeList;
+		while (freeNode->next != NULL) {
+			freeNode = freeNode->next;
+		}
+		freeNode->next = pool->freeList;
+		pool->freeList = other->freeList;
+	}
+
+	// Relink the slab chain, keeping the newest slab of 'pool' in front so 'used' stays valid
+	if (other->slabs != NULL) {
+		if (pool->slabs == NULL) {
+			pool->slabs = other->slabs;
+			pool->used = other->slabs->capacity; // Everything left in it went onto the free list
+		}
+		else {
+			last = other->slabs;
+			while (last->next != NULL) {
+				last = last->next;
+			}
+			last->next = pool->slabs->next;
+			pool->slabs->next = other->slabs;
+		}
+	}
+
+	other->slabs = NULL;
+	other->used = 0;
+	other->freeList = NULL;
+}
+
+// 
+
+// END OF NODEPOOLFUNCTIONS.C
\ No newline at end of file
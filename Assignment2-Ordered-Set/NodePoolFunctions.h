@@ -0,0 +1,31 @@
+/** 
+* @file NodePoolFunctions.h
+* 
+* @brief Header file for defining function declarations for the node pool used by the double linked list.
+* 
+* @details
+* This header file includes function declarations only, while function definitions are implemented in 'NodePoolFunctions.c'.
+* A node pool carves nodes out of large slabs instead of calling 'malloc' once per node, keeps the nodes
+* given back by 'deleteCurrent' for reuse, and frees every slab at once when the last list using it is deleted.
+* 
+* @note the 'NodePool' and 'NodeSlab' structures used by these functions are defined in 'DoubleLinkedListTypeDefs.h'
+* 
+* @date 17/10/2026
+*/
+
+#ifndef NodePoolFunctions_h
+#define NodePoolFunctions_h
+
+NodePool* createNodePool();
+void retainNodePool(NodePool* pool);
+void releaseNodePool(NodePool* pool);
+Node* allocateNode(NodePool* pool);
+void recycleNode(Node* node, NodePool* pool);
+llError reserveNodes(NodePool* pool, size_t count);
+void absorbNodePool(NodePool* pool, NodePool* other);
+
+#endif //NodePoolFunctions_h
+
+// 
+
+// END OF NODEPOOLFUNCTIONS.H
\ No newline at end of file
@@ -15,6 +15,9 @@
  * @note
  * - The `orderedIntSet` structure maintains the size of the set and a pointer to the double-linked list storing the elements.
  * - Return values for operations are represented by the `ReturnValues` enumeration.
+ * - Functions that do not modify a set (lookups, set operations, printing, and reading through a `SetCursor`) never
+ *   write to it, so any number of threads may call them on the same sets at the same time. A set that is being
+ *   modified must not be read or modified by other threads until the modifying call returns.
  *
  * @author Rory Huynh - 23374624
  * @note Coding
@@ -28,16 +31,61 @@
 #define OrderedList_h
 #include "DoubleLinkedListTypeDefs.h"
 #include "DoubleLinkedListFunctions.h"
+#include "SkipListIndex.h"
+#include "SortedArray.h"
+#include "RoaringBitmap.h"
+#include "ThreadPool.h"
+
+#define SET_CURSOR_BATCH 256 /**< Elements a `SetCursor` decodes from a roaring bitmap at a time. */
+/**
+ * @enum SetBackend
+ * @brief The data structures an ordered set can store its elements in.
+ */
+typedef enum {
+    SET_BACKEND_LIST, /* 0 */ /**< Double linked list, optionally indexed: cheap inserts and removals anywhere. */
+    SET_BACKEND_ARRAY, /* 1 */ /**< Contiguous sorted array: fast lookups and scans for read-mostly sets. */
+    SET_BACKEND_BITMAP /* 2 */ /**< Roaring compressed bitmap: a fraction of the memory and word-wise set algebra for dense sets. */
+} SetBackend;
 /**
  * @struct orderedIntSet
  * @brief Represents an ordered set of integers.
  *
- * Contains the size of the set and a pointer to a double-linked list that stores the elements.
+ * Contains the size of the set and the data structure that stores the elements, selected by `backend`:
+ * either a double-linked list, optionally with a skip list index that speeds up finding an element from O(n) to
+ * O(log n), a sorted array, or a roaring bitmap.
  */
 typedef struct orderedIntSet {
     int size;
-    DoubleLinkedList *list;
+    SetBackend backend; /**< Which of `list`, `array` and `bitmap` stores the elements. */
+    DoubleLinkedList *list; /**< Elements of a list backed set, NULL for the other backends. */
+    SkipListIndex *index; /**< Skip list index over `list`, or NULL if the set is not indexed. */
+    SortedArray *array; /**< Elements of an array backed set, NULL for the other backends. */
+    RoaringBitmap *bitmap; /**< Elements of a bitmap backed set, NULL for the other backends. */
+    struct setFileMapping *mapping; /**< File the `array` of a read-only set is mapped from, see `SetFile.h`; NULL if the set owns its storage. */
 } orderedIntSet;
+/**
+ * @struct SetCursor
+ * @brief Reads the elements of an ordered set in ascending order, whatever its backend.
+ *
+ * Only one of the two positions is in use: `node` and `stop` for a list backed set, `next` and `end` for an array
+ * backed set. The unused one is kept empty (`node` equal to `stop`, or `next` equal to `end`), so no backend check
+ * is needed per element. Cursors over part of a set start and stop in the middle, see `positionCursor()`.
+ * A bitmap backed set is decoded `SET_CURSOR_BATCH` elements at a time into `batch`, which `next` and `end` then walk
+ * like an array; a cursor over a range stops decoding at `last`.
+ * The cursor is owned by the caller, so reading a set never writes to it; use the `setCursor` functions rather than
+ * the fields.
+ */
+typedef struct {
+    Node *node; /**< Node holding the next element (list backend), equal to `stop` when done. */
+    Node *stop; /**< Node the cursor stops at, NULL to read to the end of the list (list backend). */
+    const int *next; /**< Next element (array and bitmap backends). */
+    const int *end; /**< One past the last element (array backend) or decoded element (bitmap backend). */
+    int fromBitmap; /**< 1 if `batch` has to be refilled from `bits` when `next` reaches `end`. */
+    int last; /**< Largest element decoded from `bits` (bitmap backend), see `startSetRangeCursor()`. */
+    RoaringIterator bits; /**< Position in the bitmap (bitmap backend). */
+    int batch[SET_CURSOR_BATCH]; /**< Elements decoded from the bitmap (bitmap backend). */
+} SetCursor;
+
 /**
  * @enum ReturnValues
  * @brief Enumeration of possible return values for set operations.
@@ -47,15 +95,54 @@ typedef enum {
     NUMBER_NOT_IN_SET, /* 1 */ /**< Element is not found in the set. */
     NUMBER_ADDED, /* 2 */ /**< Element was successfully added to the set. */
     NUMBER_REMOVED, /* 3 */ /**< Element was successfully removed from the set. */
-    ALLOCATION_ERROR /* 4 */ /**< Memory allocation error occurred. */
+    ALLOCATION_ERROR, /* 4 */ /**< Memory allocation error occurred. */
+    SET_IS_READ_ONLY /* 5 */ /**< The set is mapped from a file and cannot be modified. */
 } ReturnValues;
 
+/**
+ * @enum CreateFlags
+ * @brief Flags describing the input of `createOrderedSetFromArray()`, combined with `|`.
+ */
+typedef enum {
+    CREATE_FROM_UNSORTED = 0, /**< Elements may come in any order and may repeat; they are sorted first. */
+    CREATE_FROM_SORTED = 1, /**< Elements are in ascending order (repeats allowed) and are linked in one pass. */
+    CREATE_INDEXED = 2, /**< The new set maintains a skip list index, see `createIndexedOrderedSet()`. */
+    CREATE_ARRAY_BACKEND = 4, /**< The new set stores its elements in a sorted array, see `SET_BACKEND_ARRAY`. */
+    CREATE_BITMAP_BACKEND = 8 /**< The new set stores its elements in a roaring bitmap, see `SET_BACKEND_BITMAP`. */
+} CreateFlags;
+
 orderedIntSet* createOrderedSet();
+orderedIntSet* createOrderedSetWithBackend(SetBackend backend);
+int convertOrderedSet(orderedIntSet* s, SetBackend backend);
+orderedIntSet* createIndexedOrderedSet();
+orderedIntSet* createOrderedSetFromArray(const int* elems, size_t count, int flags);
+int enableSetIndex(orderedIntSet* s);
+void disableSetIndex(orderedIntSet* s);
 ReturnValues deleteOrderedSet(orderedIntSet* s);
 ReturnValues addElement(orderedIntSet* s, int elem);
 ReturnValues removeElement(orderedIntSet* s, int elem);
+int containsElement(orderedIntSet* s, int elem);
+int fingerContainsElement(orderedIntSet* s, SetCursor* finger, int elem);
+ReturnValues addRange(orderedIntSet* s, int first, int last);
+ReturnValues removeRange(orderedIntSet* s, int first, int last);
+int countInRange(orderedIntSet* s, int first, int last);
+int rankElement(orderedIntSet* s, int elem);
+int selectElement(orderedIntSet* s, int position, int* elem);
+void startSetCursor(SetCursor* cursor, orderedIntSet* s);
+void startSetRangeCursor(SetCursor* cursor, orderedIntSet* s, int first, int last);
+int setCursorHasElement(const SetCursor* cursor);
+int setCursorElement(const SetCursor* cursor);
+void setCursorAdvance(SetCursor* cursor);
 orderedIntSet* setIntersection(orderedIntSet* s1, orderedIntSet* s2);
 orderedIntSet* setUnion(orderedIntSet* s1, orderedIntSet* s2);
 orderedIntSet* setDifference(orderedIntSet* s1, orderedIntSet* s2);
+ReturnValues unionInto(orderedIntSet* dst, orderedIntSet* src);
+ReturnValues intersectInPlace(orderedIntSet* dst, orderedIntSet* src);
+ReturnValues differenceInPlace(orderedIntSet* dst, orderedIntSet* src);
+orderedIntSet* setUnionMany(orderedIntSet** sets, int count);
+orderedIntSet* setIntersectionMany(orderedIntSet** sets, int count);
+orderedIntSet* setIntersectionParallel(orderedIntSet* s1, orderedIntSet* s2, ThreadPool* pool);
+orderedIntSet* setUnionParallel(orderedIntSet* s1, orderedIntSet* s2, ThreadPool* pool);
+orderedIntSet* setDifferenceParallel(orderedIntSet* s1, orderedIntSet* s2, ThreadPool* pool);
 int printToStdout(orderedIntSet* s);
 #endif
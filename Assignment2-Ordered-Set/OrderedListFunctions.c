@@ -4,9 +4,9 @@
  * @brief Implementation of functions for managing/operating on an ordered integer set.
  *
  * @details This file provides the implementation for:
- *   - Creating and deleting ordered sets.
+ *   - Creating and deleting ordered sets, including building a set from an array in one go.
  *   - Adding, removing, and searching elements.
- *   - Performing set operations such as union, intersection, and difference.
+ *   - Performing set operations such as union, intersection, and difference, also on several threads.
  *   - Printing set contents.
  *
  *
@@ -21,7 +21,18 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
 #include "OrderedList.h"
+#include "NodePoolFunctions.h"
+#include "SetKernels.h"
+#include "SetFile.h"
+#include "SetFormat.h"
+#include "SetStats.h"
+
+#define GALLOP_RATIO 32 // Size ratio above which setIntersection() looks elements up instead of merging
+#define PARALLEL_MIN_SIZE 65536 // Combined size below which the parallel set operations stay on the calling thread
+#define PARALLEL_PARTS_PER_THREAD 4 // Key ranges a parallel set operation is split into per thread
 /**
  * @brief Creates a new ordered integer set.
  *
@@ -29,22 +40,40 @@
  * @post A new ordered set is initialized and ready for operations.
  *
  * @details 
+ * - The set stores its elements in a double linked list, see `createOrderedSetWithBackend()`.
+ *
+ * @return A pointer to the newly created ordered set, or exits the program on allocation failure.
+*/
+orderedIntSet *createOrderedSet() {
+    return createOrderedSetWithBackend(SET_BACKEND_LIST);
+}
+/**
+ * @brief Creates a new ordered integer set stored in the given backend.
+ *
+ * @pre None.
+ * @post A new ordered set is initialized and ready for operations.
+ *
+ * @details 
  * - Allocates memory for a new `orderedIntSet` structure. 
- * - Initializes the set's size to zero and creates an underlying double linked list to manage the set elements.
+ * - Initializes the set's size to zero and creates the underlying double linked list, sorted array or roaring
+ *   bitmap to manage the set elements.
  *
  * ***Pseudocode:***
  * 1. Allocate memory for `orderedIntSet`
  * 2. If memory allocation successful, then:
  *      - Initialize `size` to 0
- *      - Create a double-linked list and assign to `list`
- * 3. If list creation fails:
+ *      - Create a double-linked list and assign to `list`, a sorted array and assign to `array`, or a roaring
+ *        bitmap and assign to `bitmap`
+ * 3. If allocation fails:
  *      - Print error message
  *      - Exit program
  * 4. Return `orderedIntSet`
  * 
+ * @param backend The `SetBackend` to store the elements in.
+ *
  * @return A pointer to the newly created ordered set, or exits the program on allocation failure.
 */
-orderedIntSet *createOrderedSet() {
+orderedIntSet *createOrderedSetWithBackend(SetBackend backend) {
     orderedIntSet *returnSet = (orderedIntSet *) malloc(sizeof(orderedIntSet));
     // Check if memory allocation failed
     if (returnSet == NULL) {
@@ -55,12 +84,121 @@ orderedIntSet *createOrderedSet() {
 
     // Initialize the size of the ordered set to 0 (empty set)
     returnSet->size = 0;
-    // Initialize the list field with a newly created double linked list
-    returnSet->list = createDoubleLinkedList();
+    returnSet->backend = backend;
+    // Initialize the storage of the chosen backend, the other ones stay unused
+    returnSet->list = NULL;
+    returnSet->array = NULL;
+    returnSet->bitmap = NULL;
+    if (backend == SET_BACKEND_ARRAY) {
+        returnSet->array = createSortedArray(0);
+    }
+    else if (backend == SET_BACKEND_BITMAP) {
+        returnSet->bitmap = createRoaringBitmap();
+    }
+    else {
+        returnSet->list = createDoubleLinkedList();
+    }
+    // Sets are not indexed unless asked for, and own their storage unless mapped from a file
+    returnSet->index = NULL;
+    returnSet->mapping = NULL;
+
+    // Check if the storage could be created
+    if (returnSet->list == NULL && returnSet->array == NULL && returnSet->bitmap == NULL) {
+        // Print an error message and terminate the program if allocation fails
+        printf("[ERROR] Could not allocate heap memory when creating ordered set. Exiting...\n");
+        exit(-1);
+    }
+
+    // Return the pointer to the newly created ordered set
+    return returnSet;
+}
+/**
+ * @brief Creates a new ordered integer set that maintains a skip list index.
+ *
+ * @pre None.
+ * @post A new, indexed, ordered set is initialized and ready for operations.
+ *
+ * @details 
+ * - Works like `createOrderedSet()`, but `addElement()` and `removeElement()` on the new set find the position
+ *   of an element through the index in O(log n) instead of walking the list.
+ *
+ * ***Pseudocode:***
+ * 1. Create an ordered set
+ * 2. Enable its index:
+ *      - If that fails, print error message and exit program
+ * 3. Return `orderedIntSet`
+ * 
+ * @return A pointer to the newly created ordered set, or exits the program on allocation failure.
+*/
+orderedIntSet *createIndexedOrderedSet() {
+    orderedIntSet *returnSet = createOrderedSet();
+
+    // Check if the index could be created
+    if (!enableSetIndex(returnSet)) {
+        // Print an error message and terminate the program if allocation fails
+        printf("[ERROR] Could not allocate heap memory when creating ordered set. Exiting...\n");
+        exit(-1);
+    }
 
     // Return the pointer to the newly created ordered set
     return returnSet;
 }
+/**
+ * @brief Starts maintaining a skip list index for an ordered set.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post `s` is indexed; its elements and their order are unchanged.
+ *
+ * @details 
+ * - The index is built over the existing elements in a single O(n) pass.
+ * - Enabling the index of a set that is already indexed does nothing.
+ * - Array and bitmap backed sets are already searched in O(log n) and never get an index.
+ *
+ * ***Pseudocode:***
+ * 1. If `s` is NULL, return 0
+ * 2. If `s` is not list backed, return 1
+ * 3. If `s` has no index yet:
+ *      - Build the index over `s->list`
+ * 4. Return 1 if `s` has an index, otherwise 0
+ * 
+ * @param s A pointer to the `orderedIntSet`.
+ *
+ * @return 1 if the set is indexed or not list backed, 0 if the index could not be allocated.
+*/
+int enableSetIndex(orderedIntSet *s) {
+    // Check if the input set pointer is NULL
+    if (s == NULL) {
+        return 0;
+    }
+    // A sorted array or bitmap is binary searched and needs no index
+    if (s->backend != SET_BACKEND_LIST) {
+        return 1;
+    }
+
+    // Build the index over the elements already in the set
+    if (s->index == NULL) {
+        s->index = createSkipListIndex(s->list);
+    }
+
+    return s->index != NULL;
+}
+/**
+ * @brief Stops maintaining the skip list index of an ordered set and frees it.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post `s` is not indexed; its elements and their order are unchanged.
+ *
+ * @param s A pointer to the `orderedIntSet`.
+*/
+void disableSetIndex(orderedIntSet *s) {
+    // Check if the input set pointer is NULL
+    if (s == NULL) {
+        return;
+    }
+
+    deleteSkipListIndex(s->index);
+    s->index = NULL;
+}
 /**
  * @brief Deletes an ordered integer set and frees associated memory.
  *
@@ -68,13 +206,17 @@ orderedIntSet *createOrderedSet() {
  * @post The set and its elements are deallocated.
  *
  * @details 
- * - Frees all memory associated with the set, including its underlying double linked list.
+ * - Frees all memory associated with the set, including its underlying double linked list and its index, or its
+ *   sorted array or roaring bitmap.
+ * - The elements of a set mapped from a file are not freed; the file is unmapped instead.
  *
  * ***Pseudocode:***
  * 1. If `s` is NULL:
  *      - Return `ALLOCATION_ERROR`
  * 2. Otherwise:
- *      - Delete the double-linked list in `s->list`
+ *      - If `s` is mapped from a file, unmap it and detach the elements from `s->array`
+ *      - Delete the index and the double-linked list in `s->list`, the sorted array in `s->array`, or the roaring
+ *        bitmap in `s->bitmap`
  *      - Free memory allocated for `s`
  * 3. Return `NUMBER_REMOVED`
  * 
@@ -88,8 +230,16 @@ ReturnValues deleteOrderedSet(orderedIntSet *s) {
         return ALLOCATION_ERROR;// Return an error if the set doesn't exist
     }
 
-    // Delete the double-linked list associated with the set
+    // The elements of a mapped set belong to the file
+    if (s->mapping != NULL) {
+        s->array->elems = NULL;
+        unmapSetFile(s->mapping);
+    }
+    // Delete the index and the double-linked list, the sorted array or the bitmap associated with the set
+    deleteSkipListIndex(s->index);
     deleteDoubleLinkedList(s->list);
+    deleteSortedArray(s->array);
+    deleteRoaringBitmap(s->bitmap);
     // Free the memory allocated for the orderedIntSet structure
     free(s);
 
@@ -102,50 +252,121 @@ ReturnValues deleteOrderedSet(orderedIntSet *s) {
  * @post The integer `elem` is inserted in sorted order if not already present.
  *
  * @details 
- * - Traverses the list to find the correct position for `elem`. 
+ * - Traverses the list to find the correct position for `elem`, or asks the index for it if `s` is indexed. 
+ * - An `elem` larger than the last element of an unindexed list is appended without a traversal, so adding
+ *   elements in ascending order costs O(1) each.
+ * - Array backed sets binary search for the position and shift the larger elements up.
+ * - Bitmap backed sets set the element's bit (or value) in the container of its upper 16 bits.
  * - If `elem` already exists, the function returns an error code. 
  * - Otherwise, `elem` is inserted, and the set's size is incremented.
+ * - Sets mapped from a file cannot be modified.
  * 
  * ***Pseudocode:***
  * 1. If `s` is NULL:
  *      - Return `ALLOCATION_ERROR`
- * 2. Move to the head of `s->list`
- * 3. Traverse list while `current->next` is not NULL:
+ *    If `s` is mapped from a file:
+ *      - Return `SET_IS_READ_ONLY`
+ * 1.5. If `s` is array backed:
+ *      - Binary search the position of `elem`, return `NUMBER_ALREADY_IN_SET` if it holds `elem`
+ *      - Insert `elem` there, increment `s->size` and return `NUMBER_ADDED` (or `ALLOCATION_ERROR`)
+ *    If `s` is bitmap backed:
+ *      - Add `elem` to the bitmap, return `NUMBER_ALREADY_IN_SET` if it was there
+ *      - Otherwise increment `s->size` and return `NUMBER_ADDED` (or `ALLOCATION_ERROR`)
+ * 2. If `s` is indexed:
+ *      - Move current to the predecessor of `elem` found through the index
+ *      - If the next element equals `elem`, return `NUMBER_ALREADY_IN_SET`
+ * 2.5. If the last element of `s->list` is smaller than `elem`:
+ *      - Move current to the last node
+ * 3. Otherwise, move to the head of `s->list` and traverse list while `current->next` is not NULL:
  *      - If `currentElement` equals `elem`, return `NUMBER_ALREADY_IN_SET`
  *      - If `currentElement` is greater than `elem`, break loop
  * 4. Create `newData` for `elem`
  * 5. Insert `newData` after the current node:
  *      - If insertion fails, return `ALLOCATION_ERROR`
- * 6. Increment `s->size`
- * 7. Return `NUMBER_ADDED`
+ * 6. If `s` is indexed, add the new node to the index
+ * 7. Increment `s->size`
+ * 8. Return `NUMBER_ADDED`
  *
  * @param s A pointer to the `orderedIntSet`.
  * @param elem The integer element to be added.
  *
- * @return `NUMBER_ADDED` if successful, `NUMBER_ALREADY_IN_SET` if `elem` exists, or `ALLOCATION_ERROR` on failure.
+ * @return `NUMBER_ADDED` if successful, `NUMBER_ALREADY_IN_SET` if `elem` exists, `SET_IS_READ_ONLY` if `s` is mapped
+ *         from a file, or `ALLOCATION_ERROR` on failure.
 */
-ReturnValues addElement(orderedIntSet *s, int elem) {
+static ReturnValues addToSet(orderedIntSet *s, int elem) {
     // Check if the input set pointer is NULL
     if (s == NULL) {
         return ALLOCATION_ERROR;// Return an error if the set doesn't exist
     }
+    // The elements of a mapped set are in read-only memory
+    if (s->mapping != NULL) {
+        return SET_IS_READ_ONLY;
+    }
 
-    // Traverse the list to find the correct position for the new element
-    gotoHead(s->list);
-    while (s->list->current->next != NULL) {
-        int currentElement = s->list->current->next->d.i;
+    SkipTower *update[SKIP_LIST_MAX_LEVEL];
+
+    if (s->backend == SET_BACKEND_ARRAY) {
+        // Binary search the position of the new element
+        int pos = sortedArrayLowerBound(s->array, elem);
 
         // If the element is already in the set, return a specific error
-        if (currentElement == elem) {
+        if (pos < s->array->count && s->array->elems[pos] == elem) {
             return NUMBER_ALREADY_IN_SET;
         }
-        // Stop if we find an element greater than the one being added
-        else if (currentElement > elem) {
-            break;
+        // Shift the larger elements up and store the new one
+        if (sortedArrayInsertAt(s->array, pos, elem) != ok) {
+            return ALLOCATION_ERROR;// Return an error if insertion fails
         }
+        s->size++;// Increment the set size
+        return NUMBER_ADDED;// Indicate successful addition
+    }
+    if (s->backend == SET_BACKEND_BITMAP) {
+        int added;
 
-        // Move to the next node
-        gotoNextNode(s->list);
+        // Add the element to the container of its upper 16 bits
+        if (roaringAdd(s->bitmap, elem, &added) != ok) {
+            return ALLOCATION_ERROR;// Return an error if the container could not grow
+        }
+        if (!added) {
+            return NUMBER_ALREADY_IN_SET;// If the element is already in the set, return a specific error
+        }
+        s->size++;// Increment the set size
+        return NUMBER_ADDED;// Indicate successful addition
+    }
+
+    if (s->index != NULL) {
+        // Let the index find the correct position for the new element
+        s->list->current = skipListFindPredecessor(s->index, elem, update);
+
+        // If the element is already in the set, return a specific error
+        if (s->list->current->next != NULL && s->list->current->next->d.i == elem) {
+            return NUMBER_ALREADY_IN_SET;
+        }
+    }
+    else if (s->list->tail != s->list->head && s->list->tail->d.i < elem) {
+        // Elements arriving in ascending order go straight after the last node
+        gotoTail(s->list);
+        STATS_COUNT(comparisons, 1);
+    }
+    else {
+        // Traverse the list to find the correct position for the new element
+        gotoHead(s->list);
+        while (s->list->current->next != NULL) {
+            int currentElement = s->list->current->next->d.i;
+
+            STATS_COUNT(comparisons, 1);
+            // If the element is already in the set, return a specific error
+            if (currentElement == elem) {
+                return NUMBER_ALREADY_IN_SET;
+            }
+            // Stop if we find an element greater than the one being added
+            else if (currentElement > elem) {
+                break;
+            }
+
+            // Move to the next node
+            gotoNextNode(s->list);
+        }
     }
 
     // Prepare the new data to be inserted
@@ -154,11 +375,34 @@ ReturnValues addElement(orderedIntSet *s, int elem) {
     if (insertAfter(&newData, s->list) != ok) {
         return ALLOCATION_ERROR;// Return an error if insertion fails
     }
+    // Keep the index up to date
+    if (s->index != NULL) {
+        skipListInsert(s->index, s->list->current->next, update);
+    }
 
     s->size++;// Increment the set size
 
     return NUMBER_ADDED;// Indicate successful addition
 }
+
+/**
+ * @brief Adds an integer element to the ordered set.
+ *
+ * @details
+ * - See `addToSet()`. With `ORDERED_SET_STATS` defined, the call is counted as `STATS_ADD`, see `SetStats.h`.
+ *
+ * @param s A pointer to the `orderedIntSet`.
+ * @param elem The integer element to be added.
+ *
+ * @return The `ReturnValues` of `addToSet()`.
+*/
+ReturnValues addElement(orderedIntSet *s, int elem) {
+    ReturnValues result;
+
+    STATS_MEASURE(result, STATS_ADD, addToSet(s, elem));
+
+    return result;
+}
 /**
  * @brief Removes an integer element from the ordered set.
  *
@@ -166,15 +410,28 @@ ReturnValues addElement(orderedIntSet *s, int elem) {
  * @post If `elem` is present, it is removed and the set's size is decremented.
  *
  * @details 
- * - Searches for `elem` in the set.
+ * - Searches for `elem` in the set, through the index if `s` is indexed, or by binary search if it is array or
+ *   bitmap backed.
  * - If found, it removes the corresponding node.
  * - If not found, an error code is returned.
+ * - Sets mapped from a file cannot be modified.
  *
  * ***Pseudocode:***
  * 1. If `s` is NULL:
  *      - Return `ALLOCATION_ERROR`
- * 2. Move to the head of `s->list`
- * 3. Traverse list using `gotoNextNode()`:
+ *    If `s` is mapped from a file:
+ *      - Return `SET_IS_READ_ONLY`
+ * 1.5. If `s` is array backed:
+ *      - Binary search `elem`, return `NUMBER_NOT_IN_SET` if it is not there
+ *      - Shift the larger elements down over it, decrement `s->size` and return `NUMBER_REMOVED`
+ *    If `s` is bitmap backed:
+ *      - Remove `elem` from the bitmap, return `NUMBER_NOT_IN_SET` if it was not there
+ *      - Otherwise decrement `s->size` and return `NUMBER_REMOVED` (or `ALLOCATION_ERROR`)
+ * 2. If `s` is indexed:
+ *      - Find the predecessor of `elem` through the index
+ *      - If the next node holds `elem`, remove it from the index, delete it, decrement `s->size`
+ *        and return `NUMBER_REMOVED`, otherwise return `NUMBER_NOT_IN_SET`
+ * 3. Move to the head of `s->list` and traverse list using `gotoNextNode()`:
  *      - If `currentData` equals `elem`:
  *          - Delete current node
  *          - Decrement `s->size`
@@ -185,19 +442,71 @@ ReturnValues addElement(orderedIntSet *s, int elem) {
  * @param s A pointer to the `orderedIntSet`.
  * @param elem The integer element to be removed.
  *
- * @return `NUMBER_REMOVED` if `elem` was removed, `NUMBER_NOT_IN_SET` if not found, or `ALLOCATION_ERROR` on failure.
+ * @return `NUMBER_REMOVED` if `elem` was removed, `NUMBER_NOT_IN_SET` if not found, `SET_IS_READ_ONLY` if `s` is
+ *         mapped from a file, or `ALLOCATION_ERROR` on failure.
 */
-ReturnValues removeElement(orderedIntSet *s, int elem) {
+static ReturnValues removeFromSet(orderedIntSet *s, int elem) {
     // Check if the input set pointer is NULL
     if (s == NULL) {
         return ALLOCATION_ERROR;// Return an error if the set doesn't exist
     }
+    // The elements of a mapped set are in read-only memory
+    if (s->mapping != NULL) {
+        return SET_IS_READ_ONLY;
+    }
+
+    if (s->backend == SET_BACKEND_ARRAY) {
+        // Binary search the element
+        int pos = sortedArrayLowerBound(s->array, elem);
+
+        if (pos == s->array->count || s->array->elems[pos] != elem) {
+            return NUMBER_NOT_IN_SET;// Return a specific error if the element is not found
+        }
+        // Shift the larger elements down over it
+        sortedArrayRemoveAt(s->array, pos);
+        s->size--;// Decrement the set size
+        return NUMBER_REMOVED;// Indicate successful removal
+    }
+    if (s->backend == SET_BACKEND_BITMAP) {
+        int removed;
+
+        // Remove the element from the container of its upper 16 bits
+        if (roaringRemove(s->bitmap, elem, &removed) != ok) {
+            return ALLOCATION_ERROR;// Return an error if a run could not be split
+        }
+        if (!removed) {
+            return NUMBER_NOT_IN_SET;// Return a specific error if the element is not found
+        }
+        s->size--;// Decrement the set size
+        return NUMBER_REMOVED;// Indicate successful removal
+    }
+
+    if (s->index != NULL) {
+        SkipTower *update[SKIP_LIST_MAX_LEVEL];
+        // Let the index find the node before the element
+        Node *predecessor = skipListFindPredecessor(s->index, elem, update);
+        Node *found = predecessor->next;
+
+        if (found == NULL || found->d.i != elem) {
+            return NUMBER_NOT_IN_SET;// Return a specific error if the element is not found
+        }
+
+        // Drop the node from the index before it is deleted
+        skipListRemove(s->index, found, update);
+        s->list->current = found;
+        if (deleteCurrent(s->list) != ok) {
+            return ALLOCATION_ERROR;// Return an error if deletion fails
+        }
+        s->size--;// Decrement the set size
+        return NUMBER_REMOVED;// Indicate successful removal
+    }
 
     // Traverse the list to find the element to remove
     gotoHead(s->list);
     while (gotoNextNode(s->list) == ok) {
         int currentData = s->list->current->d.i;
 
+        STATS_COUNT(comparisons, 1);
         // If the element is found, delete it
         if (currentData == elem) {
             if (deleteCurrent(s->list) != ok) {
@@ -212,266 +521,2737 @@ ReturnValues removeElement(orderedIntSet *s, int elem) {
 }
 
 /**
- * @brief Computes the intersection of two ordered sets.
- *
- * @pre Both sets `s1` and `s2` must be valid (non-NULL).
- * @post Returns a new set containing elements common to both `s1` and `s2`.
+ * @brief Removes an integer element from the ordered set.
  *
- * @details 
- * - Iterates over both sets to identify common elements and adds them to a new set.
- * 
- * Pseudocode:
- * 1. If `s1` or `s2` is NULL:
- *      - Return NULL
- * 2. If `s1` equals `s2`:
- *      - Return `s1`
- * 3. Create new ordered set `intersectionResult`
- * 4. Traverse `s1->list` from head:
- *      - For each element in `s1`, traverse `s2->list` from head:
- *          - If an element in `s1` equals an element in `s2`:
- *              - Add element to `intersectionResult`
- * 5. Return `intersectionResult`
+ * @details
+ * - See `removeFromSet()`. With `ORDERED_SET_STATS` defined, the call is counted as `STATS_REMOVE`, see `SetStats.h`.
  *
- * @param s1 A pointer to the first `orderedIntSet`.
- * @param s2 A pointer to the second `orderedIntSet`.
+ * @param s A pointer to the `orderedIntSet`.
+ * @param elem The integer element to be removed.
  *
- * @return A pointer to the resulting set, or `NULL` on failure.
+ * @return The `ReturnValues` of `removeFromSet()`.
 */
-orderedIntSet *setIntersection(orderedIntSet *s1, orderedIntSet *s2) {
-    // Check if either input set pointer is NULL
-    if (s1 == NULL || s2 == NULL) {
-        return NULL;// Return NULL if inputs are invalid
-    }
-    // If both sets are the same, return the original set
-    else if (s1 == s2) {
-        return s1;
-    }
+ReturnValues removeElement(orderedIntSet *s, int elem) {
+    ReturnValues result;
 
-    // Create a new set to store the intersection result
-    orderedIntSet *intersectionResult = createOrderedSet();
-    
-    // Traverse through the first set
-    gotoHead(s1->list);
-    while (s1->list->current->next != NULL) {
-        int s1Data = s1->list->current->next->d.i;
+    STATS_MEASURE(result, STATS_REMOVE, removeFromSet(s, elem));
 
-        // Traverse through the second set
-        gotoHead(s2->list);
-        while (s2->list->current->next != NULL) {
-            int s2Data = s2->list->current->next->d.i;
+    return result;
+}
 
-            // If a match is found, add it to the intersection result
-            if (s1Data == s2Data) {
-                if (addElement(intersectionResult, s1Data) == ALLOCATION_ERROR) {
-                    // Clean up and return NULL if memory allocation fails
-                    deleteOrderedSet(intersectionResult);
+/**
+ * @brief Finds the last node of a list backed set holding an element smaller than `elem`.
+ *
+ * @details
+ * - The index finds the node if `s` is indexed; otherwise the list is walked from the head, or not at all if
+ *   `elem` is larger than the last element. The current node of the list is not moved.
+ *
+ * @param s A pointer to the list backed `orderedIntSet`.
+ * @param elem The integer element to find the predecessor of.
+ *
+ * @return The predecessor node of `elem`, which is the list's head node if every element is greater or equal.
+*/
+static Node *findListPredecessor(orderedIntSet *s, int elem) {
+    Node *predecessor = s->list->head;
 
-                    return NULL;
-                }
-            }
+    if (s->index != NULL) {
+        return skipListFindPredecessor(s->index, elem, NULL);// Let the index find the node before the element
+    }
 
-            // Move to the next node in the second set
-            gotoNextNode(s2->list);
-        }
-        // Move to the next node in the first set
-        gotoNextNode(s1->list);
+    // No walk at all if elem is past the last node
+    if (s->list->tail != s->list->head && s->list->tail->d.i < elem) {
+        return s->list->tail;
+    }
+    while (predecessor->next != NULL && predecessor->next->d.i < elem) {
+        predecessor = predecessor->next;
+        STATS_COUNT(nodeHops, 1);
+        STATS_COUNT(comparisons, 1);
     }
 
-    return intersectionResult;// Return the resulting set
+    return predecessor;
 }
+
 /**
- * @brief Computes the union of two ordered sets and returns the result as a new set.
+ * @brief Checks whether an integer element is in the ordered set.
  *
- * @pre Two valid ordered sets exist.
- * @post A new ordered set is created containing all unique elements from both input sets.
+ * @pre The set `s` must be valid (non-NULL).
+ * @post The set is unchanged, including its current node.
  *
- * @details
- * - The union operation combines all elements from set `s1` and set `s2`.
- * - The resulting set contains only unique elements, maintaining sorted order.
- * - Both input sets remain unchanged.
- * 
- * Pseudocode:
- * 1. If `s1` or `s2` is NULL:
- *      - Return NULL
- * 2. Create new ordered set `unionResult`
- * 3. Traverse `s1->list` from head:
- *      - Add each element to `unionResult`
- * 4. Traverse `s2->list` from head:
- *      - Add each element to `unionResult`
- * 5. Return `unionResult`
+ * @details 
+ * - If `s` is array backed, a binary search finds the position of `elem` in O(log n).
+ * - If `s` is bitmap backed, the container of `elem` is binary searched and then tests one bit (or binary searches
+ *   its values or runs).
+ * - If `s` is indexed, the index finds the position of `elem` in O(log n).
+ * - Otherwise the list is walked from the first element until an element greater than or equal to `elem`, unless
+ *   `elem` is larger than the last element.
  *
- * @param s1 - A pointer to the first 'orderedIntSet'.
- * @param s2 - A pointer to the second 'orderedIntSet'.
+ * ***Pseudocode:***
+ * 1. If `s` is NULL, return 0
+ * 1.5. If `s` is array or bitmap backed, look `elem` up and return whether it was found
+ * 2. If `s` is indexed, find the predecessor of `elem` through the index
+ * 3. Otherwise, walk from the head (from the last node if its element is smaller than `elem`) while the next
+ *    element is smaller than `elem`
+ * 4. Return 1 if the next element equals `elem`, otherwise 0
  *
- * @return A pointer to a new 'orderedIntSet' representing the union of `s1` and `s2`.
- *         Returns NULL if both input sets are NULL.
+ * @param s A pointer to the `orderedIntSet`.
+ * @param elem The integer element to look for.
  *
- * @note Memory allocation is performed for the new set. The caller is responsible for freeing this memory.
+ * @return 1 if `elem` is in the set, otherwise 0.
 */
-orderedIntSet *setUnion(orderedIntSet *s1, orderedIntSet *s2) {
-    // Check if either input set pointer is NULL
-    if (s1 == NULL || s2 == NULL) {
-        return NULL;// Return NULL if inputs are invalid
+static int findInSet(orderedIntSet *s, int elem) {
+    // Check if the input set pointer is NULL
+    if (s == NULL) {
+        return 0;
     }
 
-    // Create a new set to store the union result
-    orderedIntSet *unionResult = createOrderedSet();
-
-    // Add all elements from the first set to the union result
-    gotoHead(s1->list);
-    while (s1->list->current->next != NULL) {
-        int s1Data = s1->list->current->next->d.i;
-
-        if (addElement(unionResult, s1Data) == ALLOCATION_ERROR) {
-            // Clean up and return NULL if memory allocation fails
-            deleteOrderedSet(unionResult);
-
-            return NULL;
-        }
-
-        // Move to the next node in the first set
-        gotoNextNode(s1->list);
+    if (s->backend == SET_BACKEND_ARRAY) {
+        int pos = sortedArrayLowerBound(s->array, elem);
+        return pos < s->array->count && s->array->elems[pos] == elem;
     }
-
-    // Add all elements from the second set to the union result
-    gotoHead(s2->list);
-    while (s2->list->current->next != NULL) {
-        int s2Data = s2->list->current->next->d.i;
-
-        if (addElement(unionResult, s2Data) == ALLOCATION_ERROR) {
-            // Clean up and return NULL if memory allocation fails
-            deleteOrderedSet(unionResult);
-            return NULL;
-        }
-
-        // Move to the next node in the second set
-        gotoNextNode(s2->list);
+    if (s->backend == SET_BACKEND_BITMAP) {
+        return roaringContains(s->bitmap, elem);
     }
 
-    return unionResult;// Return the resulting set
+    // Find the node before the element without moving the current node
+    Node *predecessor = findListPredecessor(s, elem);
+
+    return predecessor->next != NULL && predecessor->next->d.i == elem;
 }
 
 /**
- * @brief Computes the difference between two ordered sets and returns the result as a new set.
- *
- * @pre Two valid ordered sets exist.
- * @post A new ordered set is created containing elements in `s1` that are not in `s2`.
+ * @brief Checks whether an integer element is in the ordered set.
  *
  * @details
- * - The difference operation returns a set containing all elements that are present in `s1` but not in `s2`.
- * - The resulting set is sorted, and both input sets remain unchanged.
- * 
- * Pseudocode:
- * 1. If `s1` or `s2` is NULL:
- *      - Return NULL
- * 2. Create new ordered set `differenceResult`
- * 3. Traverse `s1->list` from head:
- *      - For each element in `s1`, traverse `s2->list`:
- *          - If element is not found in `s2`, add it to `differenceResult`
- * 4. Return `differenceResult`
- *
- * @param s1 - A pointer to the first 'orderedIntSet' (the minuend set).
- * @param s2 - A pointer to the second 'orderedIntSet' (the subtrahend set).
+ * - See `findInSet()`. With `ORDERED_SET_STATS` defined, the call is counted as `STATS_CONTAINS`, see `SetStats.h`.
  *
- * @return A pointer to a new 'orderedIntSet' representing the difference of `s1` and `s2`.
- *         Returns NULL if `s1` is NULL. If `s2` is NULL, the result is a copy of `s1`.
+ * @param s A pointer to the `orderedIntSet`.
+ * @param elem The integer element to look for.
  *
- * @note Memory allocation is performed for the new set. The caller is responsible for freeing this memory.
+ * @return 1 if `elem` is in the set, otherwise 0.
 */
-orderedIntSet *setDifference(orderedIntSet *s1, orderedIntSet *s2) {
-    // Check if either input set pointer is NULL
-    if (s1 == NULL || s2 == NULL) {
-        return NULL;// Return NULL if inputs are invalid
-    }
-
-    // Create a new set to store the difference result
-    orderedIntSet *differenceResult = createOrderedSet();
+int containsElement(orderedIntSet *s, int elem) {
+    int result;
 
-    // Traverse through the first set
-    gotoHead(s1->list);
-    while (s1->list->current->next != NULL) {
-        int s1Data = s1->list->current->next->d.i;
-        int foundInS2 = 0;
+    STATS_MEASURE(result, STATS_CONTAINS, findInSet(s, elem));
 
-        // Check if the current element is in the second set
-        gotoHead(s2->list);
-        while (s2->list->current->next != NULL) {
-            int s2Data = s2->list->current->next->d.i;
-
-            if (s1Data == s2Data) {
-                foundInS2 = 1;// Mark as found and break the inner loop
-                break;
-            }
+    return result;
+}
+/**
+ * @enum MergeOperation
+ * @brief Selects which elements the merge engine keeps while walking two sorted sets.
+ */
+typedef enum {
+    MERGE_INTERSECTION, /**< Keep elements present in both sets. */
+    MERGE_UNION, /**< Keep elements present in either set. */
+    MERGE_DIFFERENCE /**< Keep elements present in the first set only. */
+} MergeOperation;
 
-            // Move to the next node in the second set
-            gotoNextNode(s2->list);
-        }
+/**
+ * @brief Decodes the next batch of elements of a bitmap backed set into a cursor.
+*/
+static void refillCursor(SetCursor *cursor) {
+    int count = roaringRead(&cursor->bits, cursor->batch, SET_CURSOR_BATCH);
 
-        // If the element is not found in the second set, add it to the difference result
-        if (!foundInS2) {
-            if (addElement(differenceResult, s1Data) == ALLOCATION_ERROR) {
-                // Clean up and return NULL if memory allocation fails
-                deleteOrderedSet(differenceResult);
-                
-                return NULL;
-            }
+    // A cursor over a range stops at the first element past its end
+    if (count > 0 && cursor->batch[count - 1] > cursor->last) {
+        while (count > 0 && cursor->batch[count - 1] > cursor->last) {
+            count--;
         }
-        // Move to the next node in the first set
-        gotoNextNode(s1->list);
+        cursor->fromBitmap = 0;
     }
-
-    return differenceResult;// Return the resulting set
+    cursor->next = cursor->batch;
+    cursor->end = cursor->batch + count;
 }
+
 /**
- * @brief Computes and prints the contents of the given ordered set to the standard output.
+ * @brief Positions a cursor on the first element of a set.
  *
- * @pre A valid ordered set exists.
- * @post The elements of the set are printed in ascending order.
+ * @pre The set `s` must be valid (non-NULL).
+ * @post `cursor` is on the smallest element of `s`, or done if `s` is empty. The set is unchanged.
  *
  * @details
- * - Iterates through all elements in the ordered set and prints their values.
- * - Elements are printed in the format `{e1, e2, e3, ...}`.
- * - If the set is empty or NULL, prints `{}`.
- * 
- * Pseudocode:
- * 1. If `s` is NULL:
- *      - Print "{}" and return
- * 2. Move to head of `s->list`
- * 3. Print "{"
- * 4. Traverse `s->list` and print each element:
- *      - If not last element, print ", "
- * 5. Print "}" and new line
- * 6. Return
+ * - The cursor belongs to the caller and all reading state lives in it, so any number of threads may read the same
+ *   set through cursors of their own at the same time, as long as no thread modifies the set.
+ * - Modifying the set makes its cursors invalid; start them again afterwards.
  *
- * @param s - A pointer to the 'orderedIntSet' to be printed.
+ * ***Pseudocode:***
+ * 1. Empty both positions of `cursor`
+ * 2. If `s` is array backed, walk its array from the first element
+ * 3. If `s` is bitmap backed, start an iterator on the bitmap and decode the first batch
+ * 4. Otherwise, start at the first node after the head of the list
  *
- * @return The number of elements in the set.
- * 
- * @note This function does not modify the structure of the set.
+ * @param cursor The `SetCursor` to start.
+ * @param s A pointer to the `orderedIntSet` to read; it is not modified while reading.
 */
-int printToStdout(orderedIntSet* s) {
-    // Check if the input set pointer is NULL
-    if (s == NULL) {
-        printf("{}\n");// Print an empty set if the input is NULL
+void startSetCursor(SetCursor *cursor, orderedIntSet *s) {
+    cursor->node = NULL;
+    cursor->stop = NULL;
+    cursor->next = NULL;
+    cursor->end = NULL;
+    cursor->fromBitmap = s->backend == SET_BACKEND_BITMAP;
+    cursor->last = INT_MAX;
+    if (s->backend == SET_BACKEND_ARRAY) {
+        cursor->next = s->array->elems;
+        cursor->end = s->array->elems + s->array->count;
+    }
+    else if (s->backend == SET_BACKEND_BITMAP) {
+        roaringStartIterator(&cursor->bits, s->bitmap);
+        refillCursor(cursor);
+    }
+    else {
+        cursor->node = s->list->head->next;
+    }
+}
+
+/**
+ * @brief Checks whether a cursor has an element left.
+ *
+ * @param cursor The `SetCursor`.
+ *
+ * @return 1 if `setCursorElement()` may be called, 0 once every element was read.
+*/
+int setCursorHasElement(const SetCursor *cursor) {
+    return cursor->node != cursor->stop || cursor->next != cursor->end;
+}
+
+/**
+ * @brief Returns the element a cursor is on.
+ *
+ * @pre `setCursorHasElement(cursor)` is 1.
+ *
+ * @param cursor The `SetCursor`.
+ *
+ * @return The element.
+*/
+int setCursorElement(const SetCursor *cursor) {
+    return cursor->node != cursor->stop ? cursor->node->d.i : *cursor->next;
+}
+
+/**
+ * @brief Moves a cursor on to the next element.
+ *
+ * @pre `setCursorHasElement(cursor)` is 1.
+ * @post The cursor is on the next larger element, or done.
+ *
+ * @param cursor The `SetCursor`.
+*/
+void setCursorAdvance(SetCursor *cursor) {
+    if (cursor->node != cursor->stop) {
+        cursor->node = cursor->node->next;
+        STATS_COUNT(nodeHops, 1);
+    }
+    else {
+        cursor->next++;
+        // A bitmap is decoded a batch at a time
+        if (cursor->next == cursor->end && cursor->fromBitmap) {
+            refillCursor(cursor);
+        }
+    }
+}
+
+/**
+ * @brief Checks whether an integer element is in the ordered set, searching from the position of a cursor.
+ *
+ * @pre The set `s` must be valid (non-NULL) and `finger` was started on it with `startSetCursor()`.
+ * @post `finger` is on the first element greater than or equal to `elem`, or done if there is none. The set is
+ *       unchanged.
+ *
+ * @details 
+ * - The cursor acts as a "finger": the search walks forward from it if `elem` is larger, and backward through the
+ *   `prev` pointers if it is smaller, so a lookup in a list costs O(distance from the previous lookup).
+ * - A stream of lookups in ascending (or descending) order therefore walks the list only once in total.
+ * - An array backed set gallops forward from the finger and binary searches backward; a bitmap backed set moves
+ *   its iterator straight to the container of `elem`.
+ * - The finger belongs to the caller, so several threads may search the same set at once, each with a finger of
+ *   its own, as long as no thread modifies the set.
+ *
+ * ***Pseudocode:***
+ * 1. If `s` or `finger` is NULL, return 0
+ * 1.5. If `s` is array backed:
+ *      - Gallop forward from the finger if its element is smaller than `elem`, else binary search before it
+ *    If `s` is bitmap backed:
+ *      - Move the iterator to `elem` and decode a batch from there
+ * 2. Otherwise, start at the node of the finger (at the last node if the finger is done):
+ *      - If its element is smaller than `elem`, walk forward while the element is smaller than `elem`
+ *      - Otherwise, walk backward while the previous element is greater than or equal to `elem`
+ * 3. Return 1 if the finger is on `elem`, otherwise 0
+ *
+ * @param s A pointer to the `orderedIntSet`.
+ * @param finger The `SetCursor` to search from and move.
+ * @param elem The integer element to look for.
+ *
+ * @return 1 if `elem` is in the set, otherwise 0.
+*/
+int fingerContainsElement(orderedIntSet *s, SetCursor *finger, int elem) {
+    // Check if the input pointers are NULL
+    if (s == NULL || finger == NULL) {
         return 0;
     }
 
-    // Start iterating from the head of the list
-    gotoHead(s->list);
-    printf("{");
-    // Traverse the list and print each element
-    while (s->list->current->next != NULL) {
-        printf("%d", s->list->current->next->d.i);// Print the current element
-        // Print a comma if more elements follow
-        if (s->list->current->next->next != NULL) {
-            printf(", ");
-        }
-        // Move to the next node
+    if (s->backend == SET_BACKEND_ARRAY) {
+        int position = (int) (finger->next - s->array->elems);
+
+        if (position < s->array->count && s->array->elems[position] < elem) {
+            // The element can only be further on
+            position = sortedArrayGallop(s->array, position, elem);
+        }
+        else if (position > 0 && s->array->elems[position - 1] >= elem) {
+            // The element can only be further back
+            position = sortedArrayLowerBound(s->array, elem);
+        }
+        finger->next = s->array->elems + position;
+    }
+    else if (s->backend == SET_BACKEND_BITMAP) {
+        // Jump straight to the container of the element
+        roaringSeekIterator(&finger->bits, elem);
+        finger->fromBitmap = 1;
+        refillCursor(finger);
+    }
+    else {
+        Node *head = s->list->head;
+        // A finger that is done searches back from the last node
+        Node *node = finger->node != NULL ? finger->node : head->next != NULL ? s->list->tail : NULL;
+
+        if (node != NULL && node->d.i < elem) {
+            // The element can only be further on
+            while (node != NULL && node->d.i < elem) {
+                node = node->next;
+                STATS_COUNT(nodeHops, 1);
+                STATS_COUNT(comparisons, 1);
+            }
+        }
+        else if (node != NULL) {
+            // The element can only be further back
+            while (node->prev != head && node->prev->d.i >= elem) {
+                node = node->prev;
+                STATS_COUNT(nodeHops, 1);
+                STATS_COUNT(comparisons, 1);
+            }
+        }
+        // The next lookup starts where this one ended
+        finger->node = node;
+    }
+
+    return setCursorHasElement(finger) && setCursorElement(finger) == elem;
+}
+/**
+ * @brief Positions a cursor on the elements of a set from `first` to `last`.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post `cursor` is on the smallest element of `s` that is at least `first`, and is done after the largest element
+ *       that is at most `last`. The set is unchanged.
+ *
+ * @details
+ * - The cursor is read with `setCursorHasElement()`, `setCursorElement()` and `setCursorAdvance()` like any other.
+ * - An array backed set binary searches both ends of the range, and a bitmap backed set moves its iterator straight
+ *   to `first` and stops decoding after `last`.
+ * - A list backed set finds the start of the range through its index, or by walking the list; the end of the range
+ *   is found through the index as well, and otherwise by walking the range once.
+ *
+ * ***Pseudocode:***
+ * 1. Empty both positions of `cursor`; if `first` is greater than `last`, leave the cursor done
+ * 2. If `s` is array backed, walk its array from the first element not smaller than `first` up to the first
+ *    element greater than `last`
+ * 3. If `s` is bitmap backed, move an iterator on the bitmap to `first` and decode the first batch, up to `last`
+ * 4. Otherwise, start at the node after the predecessor of `first`:
+ *      - If the last element of the list is not greater than `last`, read to the end of the list
+ *      - Else stop at the node after the predecessor of `last + 1`, found through the index or by walking
+ *
+ * @param cursor The `SetCursor` to start.
+ * @param s A pointer to the `orderedIntSet` to read; it is not modified while reading.
+ * @param first The smallest element to read.
+ * @param last The largest element to read.
+*/
+void startSetRangeCursor(SetCursor *cursor, orderedIntSet *s, int first, int last) {
+    cursor->node = NULL;
+    cursor->stop = NULL;
+    cursor->next = NULL;
+    cursor->end = NULL;
+    cursor->fromBitmap = 0;
+    cursor->last = last;
+    // An empty range reads nothing
+    if (first > last) {
+        return;
+    }
+
+    if (s->backend == SET_BACKEND_ARRAY) {
+        int from = sortedArrayLowerBound(s->array, first);
+        int to = last == INT_MAX ? s->array->count : sortedArrayLowerBound(s->array, last + 1);
+
+        cursor->next = s->array->elems + from;
+        cursor->end = s->array->elems + to;
+    }
+    else if (s->backend == SET_BACKEND_BITMAP) {
+        cursor->fromBitmap = 1;
+        roaringStartIterator(&cursor->bits, s->bitmap);
+        roaringSeekIterator(&cursor->bits, first);
+        refillCursor(cursor);
+    }
+    else {
+        cursor->node = findListPredecessor(s, first)->next;
+        // The range reaches the end of the list unless the last element is greater than last
+        if (s->list->tail != s->list->head && s->list->tail->d.i > last) {
+            if (s->index != NULL) {
+                cursor->stop = skipListFindPredecessor(s->index, last + 1, NULL)->next;
+            }
+            else {
+                cursor->stop = cursor->node;
+                while (cursor->stop->d.i <= last) {
+                    cursor->stop = cursor->stop->next;
+                    STATS_COUNT(nodeHops, 1);
+                    STATS_COUNT(comparisons, 1);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Counts the elements of an ordered set from `first` to `last`.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post The set is unchanged.
+ *
+ * @details
+ * - Array backed sets, bitmap backed sets and indexed sets count the elements before each end of the range, see
+ *   `rankElement()`, and subtract; none of them reads the range itself.
+ * - An unindexed list is walked once from the predecessor of `first` to the first element after `last`.
+ *
+ * @param s A pointer to the `orderedIntSet`.
+ * @param first The smallest element to count.
+ * @param last The largest element to count.
+ *
+ * @return Number of elements of `s` from `first` to `last`, 0 if `s` is NULL or `first` is greater than `last`.
+*/
+int countInRange(orderedIntSet *s, int first, int last) {
+    int count = 0;
+
+    // Check if the input set pointer is NULL
+    if (s == NULL || first > last) {
+        return 0;
+    }
+
+    // The ranks of both ends are found without reading the range
+    if (s->backend != SET_BACKEND_LIST || s->index != NULL) {
+        int upTo = last == INT_MAX ? s->size : rankElement(s, last + 1);
+
+        return upTo - rankElement(s, first);
+    }
+
+    for (Node *node = findListPredecessor(s, first)->next; node != NULL && node->d.i <= last; node = node->next) {
+        count++;
+        STATS_COUNT(nodeHops, 1);
+        STATS_COUNT(comparisons, 1);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Counts the elements of an ordered set that are smaller than `elem`.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post The set is unchanged.
+ *
+ * @details
+ * - Array backed sets binary search `elem`, and indexed sets add up the widths of the index links on the way to
+ *   `elem`, see `skipListRank()`; both are O(log n).
+ * - Bitmap backed sets add up the cardinalities of the containers before the one of `elem`, see `roaringRank()`.
+ * - Unindexed lists are walked from the head, unless `elem` is larger than the last element; enable the index of
+ *   a list backed set that answers many positional queries, see `enableSetIndex()`.
+ *
+ * @param s A pointer to the `orderedIntSet`.
+ * @param elem The integer element to count the smaller elements of.
+ *
+ * @return Number of elements smaller than `elem` (the position `elem` has or would have in the set), 0 if `s` is
+ *         NULL.
+*/
+int rankElement(orderedIntSet *s, int elem) {
+    int rank = 0;
+
+    // Check if the input set pointer is NULL
+    if (s == NULL) {
+        return 0;
+    }
+
+    if (s->backend == SET_BACKEND_ARRAY) {
+        return sortedArrayLowerBound(s->array, elem);
+    }
+    if (s->backend == SET_BACKEND_BITMAP) {
+        return roaringRank(s->bitmap, elem);
+    }
+    if (s->index != NULL) {
+        return skipListRank(s->index, elem);
+    }
+
+    // Every element is smaller if the last one is
+    if (s->list->tail != s->list->head && s->list->tail->d.i < elem) {
+        return s->size;
+    }
+    for (Node *node = s->list->head->next; node != NULL && node->d.i < elem; node = node->next) {
+        rank++;
+        STATS_COUNT(nodeHops, 1);
+        STATS_COUNT(comparisons, 1);
+    }
+
+    return rank;
+}
+
+/**
+ * @brief Finds the element at a position of an ordered set, such as the smallest, the median or the k-th element.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post The set is unchanged.
+ *
+ * @details
+ * - Array backed sets read the element straight from the array, and indexed sets follow the index links whose
+ *   widths do not pass the position, see `skipListSelect()`, in O(log n).
+ * - Bitmap backed sets skip whole containers by their cardinality, see `roaringSelect()`.
+ * - Unindexed lists are walked from the head, or back from the last node if `position` is in the upper half.
+ *
+ * @param s A pointer to the `orderedIntSet`.
+ * @param position Number of smaller elements the wanted element has, 0 for the smallest element.
+ * @param elem Set to the element if `position` is in the set.
+ *
+ * @return 1 if `position` is from 0 to `s->size - 1`, otherwise 0 (and `elem` is not set).
+*/
+int selectElement(orderedIntSet *s, int position, int *elem) {
+    Node *node;
+
+    // Check if the input pointers are NULL and the position is in the set
+    if (s == NULL || elem == NULL || position < 0 || position >= s->size) {
+        return 0;
+    }
+
+    if (s->backend == SET_BACKEND_ARRAY) {
+        *elem = s->array->elems[position];
+        return 1;
+    }
+    if (s->backend == SET_BACKEND_BITMAP) {
+        return roaringSelect(s->bitmap, position, elem);
+    }
+
+    if (s->index != NULL) {
+        // The index counts the head as position 0
+        node = skipListSelect(s->index, position + 1);
+    }
+    else if (position < s->size / 2) {
+        node = s->list->head->next;
+        for (int i = 0; i < position; i++) {
+            node = node->next;
+            STATS_COUNT(nodeHops, 1);
+        }
+    }
+    else {
+        // The upper half is closer to the last node
+        node = s->list->tail;
+        for (int i = s->size - 1; i > position; i--) {
+            node = node->prev;
+            STATS_COUNT(nodeHops, 1);
+        }
+    }
+    *elem = node->d.i;
+
+    return 1;
+}
+
+/**
+ * @brief Adds every integer from `first` to `last` to the ordered set.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post Every integer from `first` to `last` is in the set; the elements outside the range are unchanged.
+ *
+ * @details
+ * - Unlike calling `addElement()` for each integer, the position of `first` is found only once:
+ *   - A list backed set reserves the missing nodes in one slab, then walks the range once, linking a new node in
+ *     wherever an integer is missing. An index is kept up to date by finger searches from one integer to the next.
+ *   - An array backed set moves the elements after the range up once and writes the range in.
+ *   - A bitmap backed set fills one container per chunk of 65536 integers, see `roaringAddRange()`.
+ * - Sets mapped from a file cannot be modified.
+ *
+ * ***Pseudocode:***
+ * 1. If `s` is NULL, return `ALLOCATION_ERROR`; if `s` is mapped from a file, return `SET_IS_READ_ONLY`
+ * 2. If `first` is greater than `last`, return `NUMBER_ALREADY_IN_SET`
+ * 3. If the set could not count every integer of the range on top of its elements, return `ALLOCATION_ERROR`
+ * 4. If `s` is array backed:
+ *      - Find the elements of the range already in the array, return `NUMBER_ALREADY_IN_SET` if it is full
+ *      - Grow the array, move the elements after the range up and write the range
+ *    If `s` is bitmap backed:
+ *      - Add the range to the bitmap chunk by chunk, counting the integers that were missing
+ * 5. Otherwise:
+ *      - Count the integers of the range missing from the list, return `NUMBER_ALREADY_IN_SET` if there are none
+ *      - Reserve that many nodes, return `ALLOCATION_ERROR` if that fails
+ *      - Move current to the predecessor of `first`
+ *      - For each integer of the range, move on to the next node if it holds the integer, else insert the integer
+ *        after current (adding it to the index) and move on to it
+ * 6. Add the number of new elements to `s->size`
+ * 7. Return `NUMBER_ADDED` if an element was added, `NUMBER_ALREADY_IN_SET` if none was, or `ALLOCATION_ERROR`
+ *
+ * @param s A pointer to the `orderedIntSet`.
+ * @param first The smallest integer to add.
+ * @param last The largest integer to add.
+ *
+ * @return `NUMBER_ADDED` if an integer was added, `NUMBER_ALREADY_IN_SET` if the whole range already was in the
+ *         set, `SET_IS_READ_ONLY` if `s` is mapped from a file, or `ALLOCATION_ERROR` on failure. Every backend
+ *         allocates what it needs before it changes the set, so on failure the set is unchanged.
+*/
+ReturnValues addRange(orderedIntSet *s, int first, int last) {
+    ReturnValues status = NUMBER_ALREADY_IN_SET;
+    int added = 0;
+
+    // Check if the input set pointer is NULL
+    if (s == NULL) {
+        return ALLOCATION_ERROR;// Return an error if the set doesn't exist
+    }
+    // The elements of a mapped set are in read-only memory
+    if (s->mapping != NULL) {
+        return SET_IS_READ_ONLY;
+    }
+    // An empty range adds nothing
+    if (first > last) {
+        return NUMBER_ALREADY_IN_SET;
+    }
+
+    long long width = (long long) last - first + 1;// Number of integers in the range
+    // The size of the set has to stay countable
+    if (width > INT_MAX - s->size) {
+        return ALLOCATION_ERROR;
+    }
+
+    if (s->backend == SET_BACKEND_ARRAY) {
+        int from = sortedArrayLowerBound(s->array, first);
+        int to = last == INT_MAX ? s->array->count : sortedArrayLowerBound(s->array, last + 1);
+
+        if (to - from == width) {
+            return NUMBER_ALREADY_IN_SET;// Every integer of the range is already in the set
+        }
+        added = (int) width - (to - from);
+        if (reserveSortedArray(s->array, s->array->count + added) != ok) {
+            return ALLOCATION_ERROR;// Return an error if growing the array fails
+        }
+        // Make room for the whole range and write it
+        memmove(s->array->elems + from + width, s->array->elems + to, (size_t) (s->array->count - to) * sizeof(int));
+        for (int i = 0; i < width; i++) {
+            s->array->elems[from + i] = first + i;
+        }
+        s->array->count += added;
+        status = NUMBER_ADDED;
+    }
+    else if (s->backend == SET_BACKEND_BITMAP) {
+        if (roaringAddRange(s->bitmap, first, last, &added) != ok) {
+            return ALLOCATION_ERROR;// The bitmap is unchanged
+        }
+    }
+    else {
+        SkipTower *update[SKIP_LIST_MAX_LEVEL];
+        int missing = (int) width - countInRange(s, first, last);
+
+        if (missing == 0) {
+            return NUMBER_ALREADY_IN_SET;// Every integer of the range is already in the set
+        }
+        // Take all new nodes from one slab
+        if (reserveNodes(s->list->pool, (size_t) missing) != ok) {
+            return ALLOCATION_ERROR;
+        }
+
+        s->list->current = s->index != NULL ? skipListFindPredecessor(s->index, first, update)
+                                            : findListPredecessor(s, first);
+        for (long long elem = first; elem <= last; elem++) {
+            Node *next = s->list->current->next;
+
+            STATS_COUNT(comparisons, 1);
+            if (next != NULL && next->d.i == elem) {
+                gotoNextNode(s->list);// Already in the set
+                continue;
+            }
+
+            data newData = {(int) elem};
+            if (s->index != NULL) {
+                // Move the towers before the integer on, past the integers added since the last search
+                skipListFindPredecessorFrom(s->index, (int) elem, update);
+            }
+            if (insertAfter(&newData, s->list) != ok) {
+                status = ALLOCATION_ERROR;// The integers added so far stay in the set
+                break;
+            }
+            if (s->index != NULL) {
+                skipListInsert(s->index, s->list->current->next, update);
+            }
+            gotoNextNode(s->list);
+            added++;
+        }
+    }
+
+    s->size += added;// Increment the set size
+    if (status != ALLOCATION_ERROR && added > 0) {
+        status = NUMBER_ADDED;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Removes every element from `first` to `last` from the ordered set.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post The set holds no element from `first` to `last`; the elements outside the range are unchanged.
+ *
+ * @details
+ * - Unlike calling `removeElement()` for each element, the position of `first` is found only once:
+ *   - A list backed set unlinks the run of nodes in the range one after the other, giving each back to the node
+ *     pool. The towers of the index found for `first` stay valid for every node of the run.
+ *   - An array backed set moves the elements after the range down once.
+ *   - A bitmap backed set drops the containers the range covers whole and rebuilds only the containers of its
+ *     ends, see `roaringRemoveRange()`.
+ * - Sets mapped from a file cannot be modified.
+ *
+ * ***Pseudocode:***
+ * 1. If `s` is NULL, return `ALLOCATION_ERROR`; if `s` is mapped from a file, return `SET_IS_READ_ONLY`
+ * 2. If `first` is greater than `last`, return `NUMBER_NOT_IN_SET`
+ * 3. If `s` is array backed:
+ *      - Find the elements of the range and move the elements after it down over them
+ *    If `s` is bitmap backed:
+ *      - Remove the range from the bitmap chunk by chunk, counting the elements that were in it
+ * 4. Otherwise:
+ *      - Find the predecessor of `first`, with the towers before it if `s` is indexed
+ *      - While the node after it holds an element not greater than `last`, remove the node from the index and
+ *        delete it
+ * 5. Subtract the number of removed elements from `s->size`
+ * 6. Return `NUMBER_REMOVED` if an element was removed, `NUMBER_NOT_IN_SET` if none was, or `ALLOCATION_ERROR`
+ *
+ * @param s A pointer to the `orderedIntSet`.
+ * @param first The smallest element to remove.
+ * @param last The largest element to remove.
+ *
+ * @return `NUMBER_REMOVED` if an element was removed, `NUMBER_NOT_IN_SET` if the set held no element of the range,
+ *         `SET_IS_READ_ONLY` if `s` is mapped from a file, or `ALLOCATION_ERROR` on failure. On failure the set is
+ *         unchanged.
+*/
+ReturnValues removeRange(orderedIntSet *s, int first, int last) {
+    ReturnValues status = NUMBER_NOT_IN_SET;
+    int removed = 0;
+
+    // Check if the input set pointer is NULL
+    if (s == NULL) {
+        return ALLOCATION_ERROR;// Return an error if the set doesn't exist
+    }
+    // The elements of a mapped set are in read-only memory
+    if (s->mapping != NULL) {
+        return SET_IS_READ_ONLY;
+    }
+    // An empty range removes nothing
+    if (first > last) {
+        return NUMBER_NOT_IN_SET;
+    }
+
+    if (s->backend == SET_BACKEND_ARRAY) {
+        int from = sortedArrayLowerBound(s->array, first);
+        int to = last == INT_MAX ? s->array->count : sortedArrayLowerBound(s->array, last + 1);
+
+        // Close the gap the range leaves
+        memmove(s->array->elems + from, s->array->elems + to, (size_t) (s->array->count - to) * sizeof(int));
+        removed = to - from;
+        s->array->count -= removed;
+    }
+    else if (s->backend == SET_BACKEND_BITMAP) {
+        if (roaringRemoveRange(s->bitmap, first, last, &removed) != ok) {
+            return ALLOCATION_ERROR;// The bitmap is unchanged
+        }
+    }
+    else {
+        SkipTower *update[SKIP_LIST_MAX_LEVEL];
+        Node *predecessor = s->index != NULL ? skipListFindPredecessor(s->index, first, update)
+                                             : findListPredecessor(s, first);
+
+        // The run of nodes in the range follows the predecessor
+        while (predecessor->next != NULL && predecessor->next->d.i <= last) {
+            STATS_COUNT(comparisons, 1);
+            if (s->index != NULL) {
+                // The towers before first are also the last ones before every node of the run
+                skipListRemove(s->index, predecessor->next, update);
+            }
+            s->list->current = predecessor->next;
+            if (deleteCurrent(s->list) != ok) {
+                status = ALLOCATION_ERROR;// Return an error if deletion fails
+                break;
+            }
+            removed++;
+        }
+    }
+
+    s->size -= removed;// Decrement the set size
+    if (status != ALLOCATION_ERROR && removed > 0) {
+        status = NUMBER_REMOVED;
+    }
+
+    return status;
+}
+/**
+ * @brief Appends an element to the end of a set that is being built in ascending order.
+ *
+ * @pre `elem` is greater than every element already in `s`, and for a list backed set `s->list->current` is the
+ *      last node of the list.
+ * @post `elem` is the last element of `s` and, for a list backed set, `current` points at its node.
+ *
+ * @details
+ * - Because the caller guarantees ascending order, no search is needed: the new node is linked straight
+ *   after `current`, which is then advanced so the next append is also O(1).
+ * - An array backed set stores the element after its last one, doubling the array when it is full.
+ * - A bitmap backed set adds the element to its last container, which is found without a search.
+ *
+ * ***Pseudocode:***
+ * 1. If `s` is array backed, append `elem` to the array; if it is bitmap backed, add `elem` to the bitmap:
+ *      - If that fails, return `ALLOCATION_ERROR`
+ * 2. Otherwise, insert `elem` after the current node and move current to the new node:
+ *      - If insertion fails, return `ALLOCATION_ERROR`
+ * 3. Increment `s->size`
+ * 4. Return `NUMBER_ADDED`
+ *
+ * @param s A pointer to the `orderedIntSet` being built.
+ * @param elem The integer element to append.
+ *
+ * @return `NUMBER_ADDED` if successful, or `ALLOCATION_ERROR` on failure.
+*/
+static ReturnValues appendElement(orderedIntSet *s, int elem) {
+    if (s->backend == SET_BACKEND_ARRAY) {
+        // Store the element after the last one
+        if (sortedArrayAppend(s->array, elem) != ok) {
+            return ALLOCATION_ERROR;// Return an error if growing the array fails
+        }
+    }
+    else if (s->backend == SET_BACKEND_BITMAP) {
+        int added;
+
+        // The last container is checked first, so this is no search
+        if (roaringAdd(s->bitmap, elem, &added) != ok) {
+            return ALLOCATION_ERROR;// Return an error if the container could not grow
+        }
+    }
+    else {
+        data newData = {elem};
+
+        // Link the new node straight after the last node
+        if (insertAfter(&newData, s->list) != ok) {
+            return ALLOCATION_ERROR;// Return an error if insertion fails
+        }
+        // Keep current on the last node so the next append does not have to search
         gotoNextNode(s->list);
     }
-    printf("}\n");// Close the set representation
+    s->size++;// Increment the set size
+
+    return NUMBER_ADDED;// Indicate successful addition
+}
+
+/**
+ * @brief Intersects or subtracts the elements of two array cursors with the SIMD kernels.
+ *
+ * @pre `result` is an empty array backed set, both cursors read arrays and `op` is `MERGE_INTERSECTION` or
+ *      `MERGE_DIFFERENCE`.
+ * @post `result` holds the result of `op` over the elements left in both cursors.
+ *
+ * @details
+ * - The result array is sized for the largest possible result up front, so the kernel writes straight into it,
+ *   see `intersectSortedArrays()` and `differenceSortedArrays()`.
+ *
+ * ***Pseudocode:***
+ * 1. Reserve room for the largest possible result plus the kernel padding
+ * 2. Run the kernel for `op` into the array of `result` and set its size
+ *
+ * @param result A pointer to the empty array backed `orderedIntSet` to fill.
+ * @param a Cursor of the first array.
+ * @param b Cursor of the second array.
+ * @param op The set operation to perform.
+ *
+ * @return `NUMBER_ADDED` if successful, or `ALLOCATION_ERROR` on failure.
+*/
+static ReturnValues kernelMerge(orderedIntSet *result, const SetCursor *a, const SetCursor *b, MergeOperation op) {
+    int countA = (int) (a->end - a->next);
+    int countB = (int) (b->end - b->next);
+    int bound = (op == MERGE_INTERSECTION && countB < countA) ? countB : countA;
+
+    if (bound > INT_MAX - SET_KERNEL_PADDING || reserveSortedArray(result->array, bound + SET_KERNEL_PADDING) != ok) {
+        return ALLOCATION_ERROR;// Return an error if the result array cannot be allocated
+    }
 
-    return 0;// Indicate successful print
+    if (op == MERGE_INTERSECTION) {
+        result->array->count = intersectSortedArrays(a->next, countA, b->next, countB, result->array->elems);
+    }
+    else {
+        result->array->count = differenceSortedArrays(a->next, countA, b->next, countB, result->array->elems);
+    }
+    result->size = result->array->count;
+
+    return NUMBER_ADDED;
+}
+
+/**
+ * @brief Combines two bitmap backed sets container by container.
+ *
+ * @pre Both sets are bitmap backed.
+ * @post A new bitmap backed set is created holding the result of `op`; both input sets remain unchanged.
+ *
+ * @details
+ * - Chunks found in one bitmap only are copied or skipped whole; dense chunks found in both are combined
+ *   64 elements per word with AND, OR or AND NOT, see `roaringAnd()`, `roaringOr()` and `roaringAndNot()`.
+ *
+ * ***Pseudocode:***
+ * 1. Create new bitmap backed set `result`
+ * 2. Combine the bitmaps of `s1` and `s2` with the operation of `op`
+ * 3. Replace the empty bitmap of `result` with the combined one and count its elements
+ * 4. Return `result`
+ *
+ * @param s1 A pointer to the first bitmap backed `orderedIntSet`.
+ * @param s2 A pointer to the second bitmap backed `orderedIntSet`.
+ * @param op The set operation to perform.
+ *
+ * @return A pointer to the resulting set, or `NULL` on allocation failure.
+*/
+static orderedIntSet *bitmapMerge(orderedIntSet *s1, orderedIntSet *s2, MergeOperation op) {
+    // Create a new set to store the result
+    orderedIntSet *result = createOrderedSetWithBackend(SET_BACKEND_BITMAP);
+    RoaringBitmap *bitmap;
+
+    if (op == MERGE_INTERSECTION) {
+        bitmap = roaringAnd(s1->bitmap, s2->bitmap);
+    }
+    else if (op == MERGE_UNION) {
+        bitmap = roaringOr(s1->bitmap, s2->bitmap);
+    }
+    else {
+        bitmap = roaringAndNot(s1->bitmap, s2->bitmap);
+    }
+
+    if (bitmap == NULL) {
+        // Clean up and return NULL if memory allocation fails
+        deleteOrderedSet(result);
+        return NULL;
+    }
+    deleteRoaringBitmap(result->bitmap);
+    result->bitmap = bitmap;
+    result->size = roaringCardinality(bitmap);
+
+    return result;// Return the resulting set
+}
+
+/**
+ * @brief Appends the result of a set operation over the elements left in two cursors to a set.
+ *
+ * @pre Every element left in the cursors is greater than the elements already in `result`, and `result` can be
+ *      appended to, see `appendElement()`.
+ * @post `result` additionally holds the result of `op`; both cursors are used up.
+ *
+ * @details
+ * - Both inputs are sorted, so a merge walks them side by side, always advancing the side with the smaller
+ *   element (both sides on a tie), exactly as in the merge step of merge sort.
+ * - Every kept element is larger than the previous one, so it is appended to the result's tail in O(1).
+ * - Intersections and differences of two arrays into an array go to the SIMD kernels instead, see `kernelMerge()`.
+ *
+ * ***Pseudocode:***
+ * 1. If `result` is array backed, both cursors read arrays and `op` is not a union:
+ *      - Return the `kernelMerge()` of the cursors
+ * 2. While `a` has an element:
+ *      - If `b` is done or `a` < `b`: keep `a` unless intersecting, advance `a`
+ *      - Else if `b` < `a`: keep `b` if uniting, advance `b`
+ *      - Else (equal): keep `a` unless taking the difference, advance both
+ * 3. If uniting, append the rest of `b`
+ *
+ * @param result A pointer to the `orderedIntSet` being built.
+ * @param a Cursor of the first set.
+ * @param b Cursor of the second set.
+ * @param op The set operation to perform.
+ *
+ * @return `NUMBER_ADDED` if successful, or `ALLOCATION_ERROR` on failure.
+*/
+static ReturnValues mergeRange(orderedIntSet *result, SetCursor *a, SetCursor *b, MergeOperation op) {
+    ReturnValues status = NUMBER_ADDED;
+
+    // Arrays are compared a vector at a time
+    if (op != MERGE_UNION && result->backend == SET_BACKEND_ARRAY && result->size == 0
+        && a->node == a->stop && !a->fromBitmap && b->node == b->stop && !b->fromBitmap) {
+        return kernelMerge(result, a, b, op);
+    }
+
+    // Walk both sorted sets once, always advancing the side holding the smaller element
+    while (setCursorHasElement(a) && status != ALLOCATION_ERROR) {
+        int aData = setCursorElement(a);
+
+        STATS_COUNT(comparisons, 1);
+        if (!setCursorHasElement(b) || aData < setCursorElement(b)) {
+            // Element only in the first set
+            if (op != MERGE_INTERSECTION) {
+                status = appendElement(result, aData);
+            }
+            setCursorAdvance(a);
+        }
+        else if (setCursorElement(b) < aData) {
+            // Element only in the second set
+            if (op == MERGE_UNION) {
+                status = appendElement(result, setCursorElement(b));
+            }
+            setCursorAdvance(b);
+        }
+        else {
+            // Element in both sets
+            if (op != MERGE_DIFFERENCE) {
+                status = appendElement(result, aData);
+            }
+            setCursorAdvance(a);
+            setCursorAdvance(b);
+        }
+    }
+
+    // Whatever is left of the second set belongs only to the union
+    while (op == MERGE_UNION && setCursorHasElement(b) && status != ALLOCATION_ERROR) {
+        status = appendElement(result, setCursorElement(b));
+        setCursorAdvance(b);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Combines two ordered sets into a new set with a single simultaneous pass over both.
+ *
+ * @pre Both sets `s1` and `s2` must be valid (non-NULL).
+ * @post A new ordered set is created holding the result of `op`; both input sets remain unchanged.
+ *
+ * @details
+ * - Both sets are merged in one O(n + m) pass, see `mergeRange()`, instead of the O(n * m) nested scans it
+ *   replaces.
+ * - The inputs are read through `SetCursor`s, so any mix of backends works and the `current` nodes of list backed
+ *   inputs are not moved.
+ * - The result uses the backend of `s1`. If either input set is indexed, a list backed result is indexed as well;
+ *   the index is built in one pass at the end.
+ * - Two bitmap backed sets are combined container by container instead, see `bitmapMerge()`.
+ *
+ * ***Pseudocode:***
+ * 1. If both sets are bitmap backed:
+ *      - Return the `bitmapMerge()` of `s1` and `s2`
+ * 2. Create new ordered set `result` with the backend of `s1`
+ * 3. Start cursors on the first element of `s1` and `s2` and merge them into `result`
+ * 4. If `s1` or `s2` is indexed, build the index of `result`
+ * 5. Return `result`
+ *
+ * @param s1 A pointer to the first `orderedIntSet`.
+ * @param s2 A pointer to the second `orderedIntSet`.
+ * @param op The set operation to perform.
+ *
+ * @return A pointer to the resulting set, or `NULL` on allocation failure.
+*/
+static orderedIntSet *mergeSets(orderedIntSet *s1, orderedIntSet *s2, MergeOperation op) {
+    // Bitmaps are combined a word at a time
+    if (s1->backend == SET_BACKEND_BITMAP && s2->backend == SET_BACKEND_BITMAP) {
+        return bitmapMerge(s1, s2, op);
+    }
+
+    // Create a new set to store the result
+    orderedIntSet *result = createOrderedSetWithBackend(s1->backend);
+    SetCursor a;
+    SetCursor b;
+
+    startSetCursor(&a, s1);
+    startSetCursor(&b, s2);
+    ReturnValues status = mergeRange(result, &a, &b, op);
+
+    // Indexed inputs give an indexed result
+    if (status != ALLOCATION_ERROR && (s1->index != NULL || s2->index != NULL) && !enableSetIndex(result)) {
+        status = ALLOCATION_ERROR;
+    }
+
+    if (status == ALLOCATION_ERROR) {
+        // Clean up and return NULL if memory allocation fails
+        deleteOrderedSet(result);
+        return NULL;
+    }
+
+    return result;// Return the resulting set
+}
+
+/**
+ * @brief Checks whether `setIntersection()` looks the elements of `small` up in `large` instead of merging them.
+ *
+ * @return 1 if `large` can be searched directly and is more than `GALLOP_RATIO` times the size of `small`, else 0.
+*/
+static int gallopsInto(orderedIntSet *small, orderedIntSet *large) {
+    return (large->index != NULL || large->backend != SET_BACKEND_LIST)
+        && (long long) small->size * GALLOP_RATIO < large->size;
+}
+
+/**
+ * @brief Computes the intersection of a small set and a much larger set that can be searched directly.
+ *
+ * @pre `large` is indexed, array backed or bitmap backed, and both sets are valid.
+ * @post A new ordered set is created holding the elements in both sets; both input sets remain unchanged.
+ *
+ * @details
+ * - Instead of walking the large set, each element of the small set is looked up in it, continuing from where the
+ *   previous lookup ended: a finger search on the skip list index (see `skipListFindPredecessorFrom()`), or a
+ *   galloping search on the sorted array (see `sortedArrayGallop()`), or a lookup in the container of the element
+ *   (see `roaringContains()`).
+ * - The cost is O(m log(n / m)) for a small set of m and a large set of n elements, rather than O(n + m).
+ * - The result uses the given backend and, like the result of `mergeSets()`, is indexed if either input is indexed.
+ *
+ * ***Pseudocode:***
+ * 1. Create new ordered set `result`
+ * 2. Start the finger at the beginning of `large`
+ * 3. For each element of `small`:
+ *      - Find its position in `large` from the finger
+ *      - If `large` holds it there, append it to `result`
+ * 4. If `small` or `large` is indexed, build the index of `result`
+ * 5. Return `result`
+ *
+ * @param small A pointer to the smaller `orderedIntSet`.
+ * @param large A pointer to the larger, indexed, array or bitmap backed, `orderedIntSet`.
+ * @param backend The `SetBackend` of the result.
+ *
+ * @return A pointer to the resulting set, or `NULL` on allocation failure.
+*/
+static orderedIntSet *gallopIntersection(orderedIntSet *small, orderedIntSet *large, SetBackend backend) {
+    // Create a new set to store the result
+    orderedIntSet *result = createOrderedSetWithBackend(backend);
+    SkipTower *finger[SKIP_LIST_MAX_LEVEL];
+    int position = 0;// Finger into an array backed large set
+    SetCursor a;
+    ReturnValues status = NUMBER_ADDED;
+
+    // The first lookup starts at the beginning of the large set
+    for (int level = 0; level < SKIP_LIST_MAX_LEVEL; level++) {
+        finger[level] = large->index != NULL ? large->index->head : NULL;
+    }
+
+    // Look up every element of the small set, each search continuing from the last one
+    for (startSetCursor(&a, small); setCursorHasElement(&a) && status != ALLOCATION_ERROR; setCursorAdvance(&a)) {
+        int aData = setCursorElement(&a);
+        int found;
+
+        if (large->backend == SET_BACKEND_ARRAY) {
+            position = sortedArrayGallop(large->array, position, aData);
+            found = position < large->array->count && large->array->elems[position] == aData;
+        }
+        else if (large->backend == SET_BACKEND_BITMAP) {
+            found = roaringContains(large->bitmap, aData);
+        }
+        else {
+            Node *predecessor = skipListFindPredecessorFrom(large->index, aData, finger);
+            found = predecessor->next != NULL && predecessor->next->d.i == aData;
+        }
+
+        if (found) {
+            status = appendElement(result, aData);
+        }
+    }
+
+    // Indexed inputs give an indexed result
+    if (status != ALLOCATION_ERROR && (small->index != NULL || large->index != NULL) && !enableSetIndex(result)) {
+        status = ALLOCATION_ERROR;
+    }
+
+    if (status == ALLOCATION_ERROR) {
+        // Clean up and return NULL if memory allocation fails
+        deleteOrderedSet(result);
+        return NULL;
+    }
+
+    return result;// Return the resulting set
+}
+
+/**
+ * @brief Computes the intersection of two ordered sets.
+ *
+ * @pre Both sets `s1` and `s2` must be valid (non-NULL).
+ * @post Returns a new set containing elements common to both `s1` and `s2`.
+ *
+ * @details 
+ * - Merges both sorted sets in a single pass and keeps the elements found in both, see `mergeSets()`.
+ * - If one set is more than `GALLOP_RATIO` times larger than the other and indexed or not list backed, the
+ *   elements of the small set are looked up in the large one instead, see `gallopIntersection()`.
+ * - Two bitmap backed sets are always combined container by container, which skips chunks only one of them has.
+ * - The result uses the backend of `s1`.
+ * 
+ * Pseudocode:
+ * 1. If `s1` or `s2` is NULL:
+ *      - Return NULL
+ * 2. If `s1` equals `s2`:
+ *      - Return `s1`
+ * 2.5. If both sets are bitmap backed:
+ *      - Return the `MERGE_INTERSECTION` merge of `s1` and `s2`
+ * 3. If the larger set is indexed or not list backed and more than `GALLOP_RATIO` times the size of the smaller one:
+ *      - Return the galloping intersection of the smaller set with the larger one
+ * 4. Return the `MERGE_INTERSECTION` merge of `s1` and `s2`
+ *
+ * @param s1 A pointer to the first `orderedIntSet`.
+ * @param s2 A pointer to the second `orderedIntSet`.
+ *
+ * @return A pointer to the resulting set, or `NULL` on failure.
+*/
+static orderedIntSet *intersectSets(orderedIntSet *s1, orderedIntSet *s2) {
+    // Check if either input set pointer is NULL
+    if (s1 == NULL || s2 == NULL) {
+        return NULL;// Return NULL if inputs are invalid
+    }
+    // If both sets are the same, return the original set
+    else if (s1 == s2) {
+        return s1;
+    }
+    // Two bitmaps only compare the chunks both of them have
+    else if (s1->backend == SET_BACKEND_BITMAP && s2->backend == SET_BACKEND_BITMAP) {
+        return mergeSets(s1, s2, MERGE_INTERSECTION);
+    }
+
+    // Under heavy size skew, look the small set's elements up in the large set instead of walking it
+    if (gallopsInto(s1, s2)) {
+        return gallopIntersection(s1, s2, s1->backend);
+    }
+    else if (gallopsInto(s2, s1)) {
+        return gallopIntersection(s2, s1, s1->backend);
+    }
+
+    return mergeSets(s1, s2, MERGE_INTERSECTION);// Return the resulting set
+}
+
+/**
+ * @brief Computes the intersection of two ordered sets.
+ *
+ * @details
+ * - See `intersectSets()`. With `ORDERED_SET_STATS` defined, the call is counted as `STATS_INTERSECTION`, see `SetStats.h`.
+ *
+ * @param s1 A pointer to the first `orderedIntSet`.
+ * @param s2 A pointer to the second `orderedIntSet`.
+ *
+ * @return The set returned by `intersectSets()`.
+*/
+orderedIntSet *setIntersection(orderedIntSet *s1, orderedIntSet *s2) {
+    orderedIntSet *result;
+
+    STATS_MEASURE(result, STATS_INTERSECTION, intersectSets(s1, s2));
+
+    return result;
+}
+/**
+ * @brief Computes the union of two ordered sets and returns the result as a new set.
+ *
+ * @pre Two valid ordered sets exist.
+ * @post A new ordered set is created containing all unique elements from both input sets.
+ *
+ * @details
+ * - The union operation combines all elements from set `s1` and set `s2`.
+ * - The resulting set contains only unique elements, maintaining sorted order.
+ * - Both input sets remain unchanged.
+ * - Both sets are merged in a single pass, see `mergeSets()`; the result uses the backend of `s1`.
+ * 
+ * Pseudocode:
+ * 1. If `s1` or `s2` is NULL:
+ *      - Return NULL
+ * 2. Return the `MERGE_UNION` merge of `s1` and `s2`
+ *
+ * @param s1 - A pointer to the first 'orderedIntSet'.
+ * @param s2 - A pointer to the second 'orderedIntSet'.
+ *
+ * @return A pointer to a new 'orderedIntSet' representing the union of `s1` and `s2`.
+ *         Returns NULL if both input sets are NULL.
+ *
+ * @note Memory allocation is performed for the new set. The caller is responsible for freeing this memory.
+*/
+static orderedIntSet *uniteSets(orderedIntSet *s1, orderedIntSet *s2) {
+    // Check if either input set pointer is NULL
+    if (s1 == NULL || s2 == NULL) {
+        return NULL;// Return NULL if inputs are invalid
+    }
+
+    return mergeSets(s1, s2, MERGE_UNION);// Return the resulting set
+}
+
+/**
+ * @brief Computes the union of two ordered sets.
+ *
+ * @details
+ * - See `uniteSets()`. With `ORDERED_SET_STATS` defined, the call is counted as `STATS_UNION`, see `SetStats.h`.
+ *
+ * @param s1 A pointer to the first `orderedIntSet`.
+ * @param s2 A pointer to the second `orderedIntSet`.
+ *
+ * @return The set returned by `uniteSets()`.
+*/
+orderedIntSet *setUnion(orderedIntSet *s1, orderedIntSet *s2) {
+    orderedIntSet *result;
+
+    STATS_MEASURE(result, STATS_UNION, uniteSets(s1, s2));
+
+    return result;
+}
+
+/**
+ * @brief Computes the difference between two ordered sets and returns the result as a new set.
+ *
+ * @pre Two valid ordered sets exist.
+ * @post A new ordered set is created containing elements in `s1` that are not in `s2`.
+ *
+ * @details
+ * - The difference operation returns a set containing all elements that are present in `s1` but not in `s2`.
+ * - The resulting set is sorted, and both input sets remain unchanged.
+ * - Both sets are merged in a single pass, see `mergeSets()`; the result uses the backend of `s1`.
+ * 
+ * Pseudocode:
+ * 1. If `s1` or `s2` is NULL:
+ *      - Return NULL
+ * 2. Return the `MERGE_DIFFERENCE` merge of `s1` and `s2`
+ *
+ * @param s1 - A pointer to the first 'orderedIntSet' (the minuend set).
+ * @param s2 - A pointer to the second 'orderedIntSet' (the subtrahend set).
+ *
+ * @return A pointer to a new 'orderedIntSet' representing the difference of `s1` and `s2`.
+ *         Returns NULL if `s1` is NULL. If `s2` is NULL, the result is a copy of `s1`.
+ *
+ * @note Memory allocation is performed for the new set. The caller is responsible for freeing this memory.
+*/
+static orderedIntSet *subtractSets(orderedIntSet *s1, orderedIntSet *s2) {
+    // Check if either input set pointer is NULL
+    if (s1 == NULL || s2 == NULL) {
+        return NULL;// Return NULL if inputs are invalid
+    }
+
+    return mergeSets(s1, s2, MERGE_DIFFERENCE);// Return the resulting set
+}
+
+/**
+ * @brief Computes the difference of two ordered sets.
+ *
+ * @details
+ * - See `subtractSets()`. With `ORDERED_SET_STATS` defined, the call is counted as `STATS_DIFFERENCE`, see `SetStats.h`.
+ *
+ * @param s1 A pointer to the first `orderedIntSet` (the minuend set).
+ * @param s2 A pointer to the second `orderedIntSet` (the subtrahend set).
+ *
+ * @return The set returned by `subtractSets()`.
+*/
+orderedIntSet *setDifference(orderedIntSet *s1, orderedIntSet *s2) {
+    orderedIntSet *result;
+
+    STATS_MEASURE(result, STATS_DIFFERENCE, subtractSets(s1, s2));
+
+    return result;
+}
+
+/**
+ * @brief Moves the elements of one set into another, deleting the old elements of the other set.
+ *
+ * @pre `s` and `result` are valid, different sets, and `s` is not mapped from a file.
+ * @post `s` holds the elements, backend and index of `result`, and `result` is deleted.
+ *
+ * @details
+ * - Used by the in-place set operations that fall back to computing their result as a new set.
+ *
+ * @param s A pointer to the `orderedIntSet` that takes the elements.
+ * @param result A pointer to the `orderedIntSet` that gives them up.
+*/
+static void replaceSetContents(orderedIntSet *s, orderedIntSet *result) {
+    orderedIntSet old = *s;
+
+    // Swap the storage, so deleting result frees what s held before
+    *s = *result;
+    *result = old;
+    deleteOrderedSet(result);
+}
+
+/**
+ * @brief Moves every node of one list backed set into another in sorted order, without copying any.
+ *
+ * @pre `dst` and `src` are list backed, not indexed, and `src` shares the node pool of `dst` or is the only user of
+ *      its own.
+ * @post `dst` holds the union of both sets; `src` is left without elements and its node pool is absorbed by the
+ *       pool of `dst`.
+ *
+ * @details
+ * - Each node of `src` is linked in before the first larger node of `dst`, so both lists are walked only once.
+ * - Nodes of `src` holding an element that `dst` already has are given back to the node pool.
+ * - Once `dst` has no larger element left, the rest of `src` is linked in as a whole.
+ *
+ * ***Pseudocode:***
+ * 1. Start before the first node of `dst` and at the first node of `src`
+ * 2. While `src` has nodes left:
+ *      - Move forward in `dst` while its next element is smaller than the element of the `src` node
+ *      - If `dst` has no next element, link the rest of `src` after the last node of `dst` and stop
+ *      - If the next element of `dst` equals it, give the `src` node back to the pool
+ *      - Otherwise, link the `src` node in before the next node of `dst`
+ * 3. Leave `src` empty and let `dst` absorb its node pool
+ * 4. Update the size of `dst`
+ *
+ * @param dst A pointer to the `orderedIntSet` that takes the nodes.
+ * @param src A pointer to the `orderedIntSet` that gives them up.
+*/
+static void spliceSets(orderedIntSet *dst, orderedIntSet *src) {
+    Node *prev = dst->list->head;// Last node of dst known to be smaller than the next node of src
+    Node *node = src->list->head->next;
+    int duplicates = 0;
+
+    while (node != NULL) {
+        Node *next = node->next;
+
+        // Find the first node of dst that is not smaller
+        while (prev->next != NULL && prev->next->d.i < node->d.i) {
+            prev = prev->next;
+            STATS_COUNT(nodeHops, 1);
+            STATS_COUNT(comparisons, 1);
+        }
+        STATS_COUNT(comparisons, 1);
+
+        if (prev->next == NULL) {
+            // Everything left in src is larger than every element of dst
+            prev->next = node;
+            node->prev = prev;
+            dst->list->tail = src->list->tail;
+            break;
+        }
+        else if (prev->next->d.i == node->d.i) {
+            // The element is already in dst
+            recycleNode(node, src->list->pool);
+            STATS_COUNT(nodeFrees, 1);
+            duplicates++;
+        }
+        else {
+            // Link the node in between prev and its successor
+            node->prev = prev;
+            node->next = prev->next;
+            prev->next->prev = node;
+            prev->next = node;
+            prev = node;
+        }
+        node = next;
+    }
+
+    // The moved nodes and the recycled duplicates now belong to the pool of dst
+    src->list->head->next = NULL;
+    src->list->tail = src->list->head;
+    src->list->current = src->list->head;
+    absorbNodePool(dst->list->pool, src->list->pool);
+    dst->size += src->size - duplicates;
+    src->size = 0;
+}
+
+/**
+ * @brief Gives a list backed set whose nodes were taken by `spliceSets()` a new, empty list.
+ *
+ * @details
+ * - The old list may no longer hold the set: its head node sits in a slab now owned by the node pool of the other
+ *   set.
+*/
+static void emptyTakenSet(orderedIntSet *s, int indexed) {
+    replaceSetContents(s, indexed ? createIndexedOrderedSet() : createOrderedSetWithBackend(s->backend));
+}
+
+/**
+ * @brief Adds every element of one ordered set to another, moving its nodes instead of copying them if it can.
+ *
+ * @pre Both sets `dst` and `src` must be valid (non-NULL).
+ * @post `dst` holds the union of both sets. If the nodes of `src` were moved into `dst`, `src` is empty, otherwise
+ *       it is unchanged; on failure both sets are left unchanged.
+ *
+ * @details
+ * - Unlike `setUnion()`, no new set is created: if both sets are list backed, the nodes of `src` are linked into
+ *   `dst` where they belong, so no node is allocated or copied, see `spliceSets()`.
+ * - Otherwise, or if the node pool of `src` is shared with other lists, the union is computed as by `setUnion()`
+ *   and replaces the elements of `dst`.
+ * - `dst` keeps its backend, and is indexed if either set was.
+ * - Like `intersectInPlace()` and `differenceInPlace()`, `src` stays a valid set that the caller deletes. Only when
+ *   its nodes were moved is it left empty, with its backend and index; when the union was copied it keeps its
+ *   elements.
+ * - Sets mapped from a file cannot be modified, but may be given as `src`.
+ *
+ * ***Pseudocode:***
+ * 1. If `dst` or `src` is NULL:
+ *      - Return `ALLOCATION_ERROR`
+ *    If `dst` is mapped from a file:
+ *      - Return `SET_IS_READ_ONLY`
+ *    If `dst` and `src` are the same set:
+ *      - Return `NUMBER_ADDED`, the set already holds the union
+ * 2. If both sets are list backed and the node pool of `src` is not shared:
+ *      - Drop the indexes of both sets
+ *      - Splice the nodes of `src` into `dst`
+ *      - Give `src` a new, empty list
+ *      - Rebuild the index of `dst` if either set was indexed; return `ALLOCATION_ERROR` if that fails
+ * 3. Otherwise:
+ *      - Merge both sets into a new set, return `ALLOCATION_ERROR` if that fails
+ *      - Replace the elements of `dst` by the new set
+ * 4. Return `NUMBER_ADDED`
+ *
+ * @param dst A pointer to the `orderedIntSet` that takes the elements.
+ * @param src A pointer to the `orderedIntSet` whose elements are added to `dst`.
+ *
+ * @return `NUMBER_ADDED` if successful, `SET_IS_READ_ONLY` if `dst` is mapped from a file, or `ALLOCATION_ERROR` on
+ *         failure. If only rebuilding the index of `dst` fails, `dst` holds the union without an index and `src` is
+ *         empty.
+*/
+ReturnValues unionInto(orderedIntSet *dst, orderedIntSet *src) {
+    // Check if either input set pointer is NULL
+    if (dst == NULL || src == NULL) {
+        return ALLOCATION_ERROR;// Return an error if inputs are invalid
+    }
+    // The elements of a mapped set belong to the file
+    if (dst->mapping != NULL) {
+        return SET_IS_READ_ONLY;
+    }
+    // A set united with itself stays as it is
+    if (dst == src) {
+        return NUMBER_ADDED;
+    }
+
+    if (dst->backend == SET_BACKEND_LIST && src->backend == SET_BACKEND_LIST
+        && (src->list->pool == dst->list->pool || src->list->pool->users == 1)) {
+        int srcIndexed = src->index != NULL;
+        int indexed = dst->index != NULL || srcIndexed;
+
+        // The nodes are relinked, so the indexes are rebuilt afterwards
+        disableSetIndex(dst);
+        disableSetIndex(src);
+        spliceSets(dst, src);
+        emptyTakenSet(src, srcIndexed);
+
+        if (indexed && !enableSetIndex(dst)) {
+            return ALLOCATION_ERROR;// Return an error if the index could not be rebuilt
+        }
+    }
+    else {
+        orderedIntSet *result = mergeSets(dst, src, MERGE_UNION);
+
+        if (result == NULL) {
+            return ALLOCATION_ERROR;// Return an error if the union could not be computed
+        }
+        replaceSetContents(dst, result);
+    }
+
+    return NUMBER_ADDED;// Indicate successful addition
+}
+
+/**
+ * @brief Removes the elements of an ordered set that are, or are not, in another set.
+ *
+ * @pre Both sets `dst` and `src` must be valid (non-NULL), and `dst` is not mapped from a file.
+ * @post `dst` holds the intersection or the difference of both sets; `src` is unchanged.
+ *
+ * @details
+ * - A list backed `dst` is walked once next to a `SetCursor` over `src`, and its nodes that do not belong to the
+ *   result are deleted, so no node is allocated or copied. Its index is rebuilt afterwards.
+ * - An array backed `dst` moves the elements it keeps down over the ones it drops.
+ * - A bitmap backed `dst` is replaced by the result of merging both sets, see `mergeSets()`.
+ *
+ * ***Pseudocode:***
+ * 1. If `dst` equals `src`, keep every element for an intersection and none for a difference
+ * 2. If `dst` is bitmap backed, replace it by the merge of both sets, return `ALLOCATION_ERROR` if that fails
+ * 3. Otherwise, for each element of `dst`:
+ *      - Advance the cursor over `src` while its element is smaller
+ *      - Drop the element if it is in `src` for a difference, or not in `src` for an intersection
+ *      - For a difference, stop once `src` has no elements left
+ * 4. Rebuild the index of a list backed `dst` that was indexed; return `ALLOCATION_ERROR` if that fails
+ * 5. Return `NUMBER_REMOVED`
+ *
+ * @param dst A pointer to the `orderedIntSet` to remove elements from.
+ * @param src A pointer to the `orderedIntSet` to compare with.
+ * @param op `MERGE_INTERSECTION` or `MERGE_DIFFERENCE`.
+ *
+ * @return `NUMBER_REMOVED` if successful, or `ALLOCATION_ERROR` on failure.
+*/
+static ReturnValues filterSet(orderedIntSet *dst, orderedIntSet *src, MergeOperation op) {
+    int keepFound = op == MERGE_INTERSECTION;// Whether elements that are in src are kept
+    SetCursor cursor;
+
+    // A set intersected with itself stays as it is, subtracted from itself it becomes empty
+    if (dst == src) {
+        if (op == MERGE_DIFFERENCE) {
+            orderedIntSet *empty = createOrderedSetWithBackend(dst->backend);
+
+            if (dst->index != NULL && !enableSetIndex(empty)) {
+                deleteOrderedSet(empty);
+                return ALLOCATION_ERROR;// Return an error if the index could not be created
+            }
+            replaceSetContents(dst, empty);
+        }
+        return NUMBER_REMOVED;
+    }
+
+    // Bitmaps are combined a word at a time into a new bitmap
+    if (dst->backend == SET_BACKEND_BITMAP) {
+        orderedIntSet *result = mergeSets(dst, src, op);
+
+        if (result == NULL) {
+            return ALLOCATION_ERROR;// Return an error if the result could not be computed
+        }
+        replaceSetContents(dst, result);
+        return NUMBER_REMOVED;
+    }
+
+    startSetCursor(&cursor, src);
+    if (dst->backend == SET_BACKEND_ARRAY) {
+        int *elems = dst->array->elems;
+        int kept = 0;
+        int i;
+
+        for (i = 0; i < dst->array->count; i++) {
+            // A difference keeps everything after the last element of src
+            if (!keepFound && !setCursorHasElement(&cursor)) {
+                break;
+            }
+            while (setCursorHasElement(&cursor) && setCursorElement(&cursor) < elems[i]) {
+                setCursorAdvance(&cursor);
+                STATS_COUNT(comparisons, 1);
+            }
+            STATS_COUNT(comparisons, 1);
+            if ((setCursorHasElement(&cursor) && setCursorElement(&cursor) == elems[i]) == keepFound) {
+                elems[kept++] = elems[i];
+            }
+        }
+        // Move down whatever was kept without looking at it
+        memmove(elems + kept, elems + i, (size_t) (dst->array->count - i) * sizeof(int));
+        dst->array->count = kept + dst->array->count - i;
+        dst->size = dst->array->count;
+    }
+    else {
+        int indexed = dst->index != NULL;
+
+        // Deleted nodes would be left in the index, so it is rebuilt afterwards
+        disableSetIndex(dst);
+        gotoHead(dst->list);
+        while (gotoNextNode(dst->list) == ok) {
+            int currentData = dst->list->current->d.i;
+
+            // A difference keeps everything after the last element of src
+            if (!keepFound && !setCursorHasElement(&cursor)) {
+                break;
+            }
+            while (setCursorHasElement(&cursor) && setCursorElement(&cursor) < currentData) {
+                setCursorAdvance(&cursor);
+                STATS_COUNT(comparisons, 1);
+            }
+            STATS_COUNT(comparisons, 1);
+            if ((setCursorHasElement(&cursor) && setCursorElement(&cursor) == currentData) != keepFound) {
+                deleteCurrent(dst->list);// Current moves back to the previous node
+                dst->size--;
+            }
+        }
+
+        if (indexed && !enableSetIndex(dst)) {
+            return ALLOCATION_ERROR;// Return an error if the index could not be rebuilt
+        }
+    }
+
+    return NUMBER_REMOVED;// Indicate successful removal
+}
+
+/**
+ * @brief Removes every element of an ordered set that is not in another set.
+ *
+ * @pre Both sets `dst` and `src` must be valid (non-NULL).
+ * @post `dst` holds the intersection of both sets; `src` is unchanged.
+ *
+ * @details
+ * - Unlike `setIntersection()`, no new set is created: the elements of `dst` that are not in `src` are deleted
+ *   from it, see `filterSet()`. `dst` keeps its backend and index.
+ * - Sets mapped from a file cannot be modified, but may be given as `src`.
+ *
+ * @param dst A pointer to the `orderedIntSet` to remove elements from.
+ * @param src A pointer to the `orderedIntSet` to intersect with.
+ *
+ * @return `NUMBER_REMOVED` if successful, `SET_IS_READ_ONLY` if `dst` is mapped from a file, or `ALLOCATION_ERROR`
+ *         on failure. If only rebuilding the index of `dst` fails, `dst` holds the intersection without an index.
+*/
+ReturnValues intersectInPlace(orderedIntSet *dst, orderedIntSet *src) {
+    // Check if either input set pointer is NULL
+    if (dst == NULL || src == NULL) {
+        return ALLOCATION_ERROR;// Return an error if inputs are invalid
+    }
+    // The elements of a mapped set belong to the file
+    if (dst->mapping != NULL) {
+        return SET_IS_READ_ONLY;
+    }
+
+    return filterSet(dst, src, MERGE_INTERSECTION);
+}
+
+/**
+ * @brief Removes every element of an ordered set that is in another set.
+ *
+ * @pre Both sets `dst` and `src` must be valid (non-NULL).
+ * @post `dst` holds the difference of both sets; `src` is unchanged.
+ *
+ * @details
+ * - Unlike `setDifference()`, no new set is created: the elements of `dst` that are in `src` are deleted from it,
+ *   see `filterSet()`. `dst` keeps its backend and index.
+ * - Sets mapped from a file cannot be modified, but may be given as `src`.
+ *
+ * @param dst A pointer to the `orderedIntSet` to remove elements from (the minuend set).
+ * @param src A pointer to the `orderedIntSet` whose elements are removed (the subtrahend set).
+ *
+ * @return `NUMBER_REMOVED` if successful, `SET_IS_READ_ONLY` if `dst` is mapped from a file, or `ALLOCATION_ERROR`
+ *         on failure. If only rebuilding the index of `dst` fails, `dst` holds the difference without an index.
+*/
+ReturnValues differenceInPlace(orderedIntSet *dst, orderedIntSet *src) {
+    // Check if either input set pointer is NULL
+    if (dst == NULL || src == NULL) {
+        return ALLOCATION_ERROR;// Return an error if inputs are invalid
+    }
+    // The elements of a mapped set belong to the file
+    if (dst->mapping != NULL) {
+        return SET_IS_READ_ONLY;
+    }
+
+    return filterSet(dst, src, MERGE_DIFFERENCE);
+}
+
+/**
+ * @brief Moves the cursor at `position` of a k-way merge heap down until no cursor below it is on a smaller element.
+*/
+static void siftDownCursor(const SetCursor *cursors, int *heap, int count, int position) {
+    int top = heap[position];
+    int elem = setCursorElement(&cursors[top]);
+
+    while (2 * position + 1 < count) {
+        int child = 2 * position + 1;
+
+        // Follow the child on the smaller element
+        if (child + 1 < count
+            && setCursorElement(&cursors[heap[child + 1]]) < setCursorElement(&cursors[heap[child]])) {
+            child++;
+        }
+        STATS_COUNT(comparisons, 1);
+        if (setCursorElement(&cursors[heap[child]]) >= elem) {
+            break;
+        }
+        heap[position] = heap[child];
+        position = child;
+    }
+    heap[position] = top;
+}
+
+/**
+ * @brief Checks that none of the sets given to a multi-way set operation is NULL.
+ *
+ * @return 1 if `sets` holds `count` sets and `count` is at least 1, else 0.
+*/
+static int validSetArray(orderedIntSet **sets, int count) {
+    if (sets == NULL || count < 1) {
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        if (sets[i] == NULL) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Checks whether any of the sets given to a multi-way set operation is indexed.
+ *
+ * @return 1 if one of the `count` sets has a skip list index, else 0.
+*/
+static int anySetIndexed(orderedIntSet **sets, int count) {
+    for (int i = 0; i < count; i++) {
+        if (sets[i]->index != NULL) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Computes the union of any number of ordered sets and returns the result as a new set.
+ *
+ * @pre `sets` holds `count` valid ordered sets, `count` is at least 1.
+ * @post A new ordered set is created containing every element found in at least one of the sets; the input sets
+ *       remain unchanged.
+ *
+ * @details
+ * - All sets are merged in a single pass instead of `count - 1` calls to `setUnion()`, which would copy the
+ *   elements of the first sets once per call. A min-heap holds one `SetCursor` per set, ordered by the element the
+ *   cursor is on, so each element costs O(log count) comparisons.
+ * - Equal elements of different sets leave the heap one after another, so only the first of them is appended.
+ * - The result uses the backend of `sets[0]` and is indexed if any of the sets is indexed.
+ *
+ * ***Pseudocode:***
+ * 1. If `sets` is NULL, `count` is less than 1 or any set is NULL:
+ *      - Return NULL
+ * 2. Create new ordered set `result` with the backend of `sets[0]`
+ * 3. Start a cursor on every set and put the cursors that are not done in a min-heap
+ * 4. While the heap is not empty:
+ *      - Take the element of the cursor at the top of the heap and append it to `result` unless it was appended last
+ *      - Advance that cursor; drop it from the heap if it is done
+ *      - Move the cursor at the top of the heap down to its place
+ * 5. If any set is indexed, build the index of `result`
+ * 6. Return `result`
+ *
+ * @param sets An array of pointers to the `orderedIntSet`s to unite.
+ * @param count Number of sets in `sets`.
+ *
+ * @return A pointer to a new `orderedIntSet` holding the union, or NULL if the input is invalid or on allocation
+ *         failure.
+ *
+ * @note Memory allocation is performed for the new set. The caller is responsible for freeing this memory.
+*/
+orderedIntSet *setUnionMany(orderedIntSet **sets, int count) {
+    if (!validSetArray(sets, count)) {
+        return NULL;// Return NULL if inputs are invalid
+    }
+
+    // Create a new set to store the result
+    orderedIntSet *result = createOrderedSetWithBackend(sets[0]->backend);
+    SetCursor *cursors = malloc((size_t) count * sizeof(SetCursor));
+    int *heap = malloc((size_t) count * sizeof(int));
+    ReturnValues status = NUMBER_ADDED;
+
+    if (cursors == NULL || heap == NULL) {
+        status = ALLOCATION_ERROR;
+    }
+    else {
+        int heapSize = 0;
+        int last = 0;
+
+        for (int i = 0; i < count; i++) {
+            startSetCursor(&cursors[i], sets[i]);
+            if (setCursorHasElement(&cursors[i])) {
+                heap[heapSize++] = i;
+            }
+        }
+        for (int i = heapSize / 2 - 1; i >= 0; i--) {
+            siftDownCursor(cursors, heap, heapSize, i);
+        }
+
+        while (heapSize > 0 && status != ALLOCATION_ERROR) {
+            SetCursor *smallest = &cursors[heap[0]];
+            int elem = setCursorElement(smallest);
+
+            // Skip the copies of the element in the other sets
+            if (result->size == 0 || elem != last) {
+                status = appendElement(result, elem);
+                last = elem;
+            }
+            setCursorAdvance(smallest);
+            if (!setCursorHasElement(smallest)) {
+                heap[0] = heap[--heapSize];
+            }
+            if (heapSize > 0) {
+                siftDownCursor(cursors, heap, heapSize, 0);
+            }
+        }
+    }
+    free(cursors);
+    free(heap);
+
+    // Indexed inputs give an indexed result
+    if (status != ALLOCATION_ERROR && anySetIndexed(sets, count) && !enableSetIndex(result)) {
+        status = ALLOCATION_ERROR;
+    }
+
+    if (status == ALLOCATION_ERROR) {
+        // Clean up and return NULL if memory allocation fails
+        deleteOrderedSet(result);
+        return NULL;
+    }
+
+    return result;// Return the resulting set
+}
+
+/**
+ * @brief Orders two set pointers by the size of their sets, for `qsort()`.
+*/
+static int compareSetSizes(const void *a, const void *b) {
+    int sizeA = (*(orderedIntSet *const *) a)->size;
+    int sizeB = (*(orderedIntSet *const *) b)->size;
+
+    return (sizeA > sizeB) - (sizeA < sizeB);
+}
+
+/**
+ * @brief Computes the intersection of any number of ordered sets and returns the result as a new set.
+ *
+ * @pre `sets` holds `count` valid ordered sets, `count` is at least 1.
+ * @post A new ordered set is created containing the elements found in every one of the sets; the input sets remain
+ *       unchanged.
+ *
+ * @details
+ * - The sets are taken smallest first: the elements of the smallest set are the candidates, and each candidate is
+ *   looked up in the other sets in order of size, see `fingerContainsElement()`. The smaller sets rule most
+ *   candidates out, so the larger sets are searched least.
+ * - Every set keeps its own finger, so no set is read more than once and no intermediate result is built.
+ * - A lookup that fails leaves its finger on the next element of that set; the candidates up to that element are
+ *   skipped, and once any set has no elements left the intersection is complete. An empty set ends it at once.
+ * - The result uses the backend of `sets[0]` and is indexed if any of the sets is indexed.
+ *
+ * ***Pseudocode:***
+ * 1. If `sets` is NULL, `count` is less than 1 or any set is NULL:
+ *      - Return NULL
+ * 2. Create new ordered set `result` with the backend of `sets[0]`
+ * 3. Sort a copy of `sets` by size and start a finger on every set
+ * 4. While the finger on the smallest set is not done:
+ *      - Look its element up in the other sets, smallest first, until a lookup fails
+ *      - If every lookup succeeded, append the element to `result` and advance the finger
+ *      - Else if the set whose lookup failed has no elements left, stop
+ *      - Else move the finger on the smallest set to the element the failed finger is on
+ * 5. If any set is indexed, build the index of `result`
+ * 6. Return `result`
+ *
+ * @param sets An array of pointers to the `orderedIntSet`s to intersect.
+ * @param count Number of sets in `sets`.
+ *
+ * @return A pointer to a new `orderedIntSet` holding the intersection, or NULL if the input is invalid or on
+ *         allocation failure.
+ *
+ * @note Memory allocation is performed for the new set. The caller is responsible for freeing this memory.
+*/
+orderedIntSet *setIntersectionMany(orderedIntSet **sets, int count) {
+    if (!validSetArray(sets, count)) {
+        return NULL;// Return NULL if inputs are invalid
+    }
+
+    // Create a new set to store the result
+    orderedIntSet *result = createOrderedSetWithBackend(sets[0]->backend);
+    orderedIntSet **bySize = malloc((size_t) count * sizeof(orderedIntSet *));
+    SetCursor *fingers = malloc((size_t) count * sizeof(SetCursor));
+    ReturnValues status = NUMBER_ADDED;
+
+    if (bySize == NULL || fingers == NULL) {
+        status = ALLOCATION_ERROR;
+    }
+    else {
+        memcpy(bySize, sets, (size_t) count * sizeof(orderedIntSet *));
+        qsort(bySize, (size_t) count, sizeof(orderedIntSet *), compareSetSizes);
+        for (int i = 0; i < count; i++) {
+            startSetCursor(&fingers[i], bySize[i]);
+        }
+
+        while (setCursorHasElement(&fingers[0]) && status != ALLOCATION_ERROR) {
+            int elem = setCursorElement(&fingers[0]);
+            int i = 1;
+
+            while (i < count && fingerContainsElement(bySize[i], &fingers[i], elem)) {
+                i++;
+            }
+
+            if (i == count) {
+                // Found in every set
+                status = appendElement(result, elem);
+                setCursorAdvance(&fingers[0]);
+            }
+            else if (!setCursorHasElement(&fingers[i])) {
+                break;// No later candidate can be in this set either
+            }
+            else {
+                // Nothing smaller than the next element of that set can be in the intersection
+                fingerContainsElement(bySize[0], &fingers[0], setCursorElement(&fingers[i]));
+            }
+        }
+    }
+    free(bySize);
+    free(fingers);
+
+    // Indexed inputs give an indexed result
+    if (status != ALLOCATION_ERROR && anySetIndexed(sets, count) && !enableSetIndex(result)) {
+        status = ALLOCATION_ERROR;
+    }
+
+    if (status == ALLOCATION_ERROR) {
+        // Clean up and return NULL if memory allocation fails
+        deleteOrderedSet(result);
+        return NULL;
+    }
+
+    return result;// Return the resulting set
+}
+/**
+ * @struct SetPosition
+ * @brief A position between two elements of a list or array backed set, where one part of the set ends and the next
+ *        starts.
+ */
+typedef struct {
+    Node *node; /**< First node of the part, NULL for the end of the list (list backend). */
+    const int *elem; /**< First element of the part (array backend). */
+} SetPosition;
+
+/**
+ * @struct MergePart
+ * @brief One key range of a parallel set operation: the parts of both input sets in the range, and the result
+ *        computed for them.
+ */
+typedef struct {
+    orderedIntSet *s1; /**< The first set; the result uses its backend. */
+    orderedIntSet *s2; /**< The second set. */
+    SetPosition from1; /**< Start of the part of the first set. */
+    SetPosition to1; /**< End of the part of the first set. */
+    SetPosition from2; /**< Start of the part of the second set. */
+    SetPosition to2; /**< End of the part of the second set. */
+    MergeOperation op; /**< The set operation to perform. */
+    orderedIntSet *result; /**< Result for the range, NULL if it could not be allocated. */
+} MergePart;
+
+/**
+ * @struct CopyPart
+ * @brief The elements of one array backed part result, and where they go in the joined result.
+ */
+typedef struct {
+    int *to; /**< Destination in the joined array. */
+    const int *from; /**< Elements of the part. */
+    int count; /**< Number of elements to copy. */
+} CopyPart;
+
+/**
+ * @brief Checks whether an operation on two sets is worth splitting over the threads of a pool.
+ *
+ * @return 1 if the pool has more than one thread, neither set is bitmap backed, and together the sets hold at
+ *         least `PARALLEL_MIN_SIZE` elements, else 0.
+*/
+static int mergesInParallel(orderedIntSet *s1, orderedIntSet *s2, ThreadPool *pool) {
+    return pool != NULL && getThreadPoolSize(pool) > 1
+        && s1->backend != SET_BACKEND_BITMAP && s2->backend != SET_BACKEND_BITMAP
+        && (long long) s1->size + s2->size >= PARALLEL_MIN_SIZE;
+}
+
+/**
+ * @brief Positions a cursor on one part of a list or array backed set.
+ *
+ * @param cursor The `SetCursor` to start.
+ * @param s A pointer to the `orderedIntSet` to read; it is not modified while reading.
+ * @param from Position of the first element to read.
+ * @param to Position after the last element to read.
+*/
+static void positionCursor(SetCursor *cursor, orderedIntSet *s, SetPosition from, SetPosition to) {
+    cursor->node = NULL;
+    cursor->stop = NULL;
+    cursor->next = NULL;
+    cursor->end = NULL;
+    cursor->fromBitmap = 0;
+    cursor->last = INT_MAX;
+    if (s->backend == SET_BACKEND_ARRAY) {
+        cursor->next = from.elem;
+        cursor->end = to.elem;
+    }
+    else {
+        cursor->node = from.node;
+        cursor->stop = to.node;
+    }
+}
+
+/**
+ * @brief Picks the elements a set operation is split at, so that the parts of a set are about equally large.
+ *
+ * @pre `sample` is list or array backed and holds at least `parts` elements.
+ * @post `splitters` holds `parts - 1` elements of `sample` in ascending order.
+ *
+ * @details
+ * - An array backed set is split at every `size / parts`-th element.
+ * - An indexed set is split at evenly spaced towers of the highest index level that still has `parts` of them,
+ *   so only a small fraction of the set is visited. Towers are placed at random, so the parts are about equal.
+ * - Any other list is walked once and split at every `size / parts`-th element.
+ *
+ * ***Pseudocode:***
+ * 1. If `sample` is array backed:
+ *      - Take the element at position `k * size / parts` as splitter `k`
+ * 2. Else if `sample` is indexed:
+ *      - Find the highest level holding at least `parts` towers, count them as `towers`
+ *      - Walk that level and take the element of tower `k * towers / parts` as splitter `k`
+ *      - Return if that worked, otherwise continue with step 3
+ * 3. Walk the list and take the element at position `k * size / parts` as splitter `k`
+ *
+ * @param sample A pointer to the `orderedIntSet` to pick the splitters from.
+ * @param splitters Array of `parts - 1` elements to fill.
+ * @param parts Number of parts to split into.
+*/
+static void chooseSplitters(orderedIntSet *sample, int *splitters, int parts) {
+    if (sample->backend == SET_BACKEND_ARRAY) {
+        for (int k = 1; k < parts; k++) {
+            splitters[k - 1] = sample->array->elems[(long long) k * sample->size / parts];
+        }
+        return;
+    }
+
+    if (sample->index != NULL) {
+        SkipTower *head = sample->index->head;
+
+        // Use the highest level with enough towers, the lower ones are up to 4 times longer each
+        for (int level = sample->index->levels - 1; level >= 0; level--) {
+            int towers = 0;
+            for (SkipTower *tower = head->link[level].next; tower != NULL; tower = tower->link[level].next) {
+                towers++;
+            }
+            if (towers < parts) {
+                continue;
+            }
+
+            SkipTower *tower = head->link[level].next;
+            int position = 0;
+            for (int k = 1; k < parts; k++) {
+                while (position < (long long) k * towers / parts) {
+                    tower = tower->link[level].next;
+                    position++;
+                }
+                splitters[k - 1] = tower->node->d.i;
+            }
+            return;
+        }
+    }
+
+    // Fall back on walking the list
+    Node *node = sample->list->head->next;
+    int position = 0;
+    for (int k = 1; k < parts; k++) {
+        while (position < (long long) k * sample->size / parts) {
+            node = node->next;
+            position++;
+        }
+        splitters[k - 1] = node->d.i;
+    }
+}
+
+/**
+ * @brief Finds where the parts of a set split at the given elements start and end.
+ *
+ * @pre `s` is list or array backed and `splitters` is in ascending order.
+ * @post `positions[0]` is the start of `s`, `positions[count + 1]` its end, and `positions[k + 1]` the first element
+ *       greater than or equal to `splitters[k]`.
+ *
+ * @details
+ * - An array backed set is binary searched and an indexed set is searched through its index, once per splitter.
+ * - Any other list is walked once up to the last splitter.
+ *
+ * @param s A pointer to the `orderedIntSet` to split.
+ * @param splitters The elements to split at.
+ * @param count Number of splitters.
+ * @param positions Array of `count + 2` positions to fill.
+*/
+static void findPositions(orderedIntSet *s, const int *splitters, int count, SetPosition *positions) {
+    Node *node = s->list != NULL ? s->list->head->next : NULL;
+
+    for (int k = 0; k <= count + 1; k++) {
+        positions[k].node = NULL;
+        positions[k].elem = NULL;
+    }
+
+    if (s->backend == SET_BACKEND_ARRAY) {
+        positions[0].elem = s->array->elems;
+        for (int k = 0; k < count; k++) {
+            positions[k + 1].elem = s->array->elems + sortedArrayLowerBound(s->array, splitters[k]);
+        }
+        positions[count + 1].elem = s->array->elems + s->array->count;
+        return;
+    }
+
+    positions[0].node = node;
+    for (int k = 0; k < count; k++) {
+        if (s->index != NULL) {
+            node = skipListFindPredecessor(s->index, splitters[k], NULL)->next;
+        }
+        else {
+            while (node != NULL && node->d.i < splitters[k]) {
+                node = node->next;
+            }
+        }
+        positions[k + 1].node = node;
+    }
+}
+
+/**
+ * @brief Task computing the result of one `MergePart`, run on a `ThreadPool`.
+ *
+ * @param arg A pointer to the `MergePart`; its `result` is set, or NULL if memory could not be allocated.
+*/
+static void mergePart(void *arg) {
+    MergePart *part = (MergePart *) arg;
+    orderedIntSet *result = createOrderedSetWithBackend(part->s1->backend);
+    SetCursor a;
+    SetCursor b;
+
+    // The inputs are only read, so all parts of a set can be read at the same time
+    positionCursor(&a, part->s1, part->from1, part->to1);
+    positionCursor(&b, part->s2, part->from2, part->to2);
+
+    if (mergeRange(result, &a, &b, part->op) == ALLOCATION_ERROR) {
+        deleteOrderedSet(result);
+        result = NULL;
+    }
+    part->result = result;
+}
+
+/**
+ * @brief Task copying the elements of one array backed part result into the joined result, run on a `ThreadPool`.
+ *
+ * @param arg A pointer to the `CopyPart`.
+*/
+static void copyPart(void *arg) {
+    CopyPart *part = (CopyPart *) arg;
+
+    memcpy(part->to, part->from, (size_t) part->count * sizeof(int));
+}
+
+/**
+ * @brief Joins the results of the parts of a parallel set operation, in key order, into one set.
+ *
+ * @pre Every part has a result, each holding only elements greater than those of the parts before it.
+ * @post The joined set is returned and the results of the parts are deleted, or everything is deleted on failure.
+ *
+ * @details
+ * - List backed results are not copied: the nodes of every part are linked behind those of the first part, which
+ *   takes over their node pools as well, see `appendDoubleLinkedList()`. Each part is joined in O(1), since the
+ *   current node of a list built by appending is its last node.
+ * - Array backed results are copied into one array that holds them all, with the threads of the pool copying
+ *   one part each.
+ *
+ * ***Pseudocode:***
+ * 1. If the results are list backed:
+ *      - Append the list of every other part to the list of the first part, adding up the sizes
+ *      - Return the first part's result
+ * 2. Otherwise:
+ *      - Create array backed set `result` with room for the elements of all parts
+ *      - Copy the elements of every part to their place in `result`, in parallel
+ *      - Delete the parts and return `result`
+ *
+ * @param parts Array of `count` parts, in key order.
+ * @param count Number of parts.
+ * @param pool The `ThreadPool` to copy on.
+ *
+ * @return A pointer to the joined set, or `NULL` on allocation failure.
+*/
+static orderedIntSet *joinParts(MergePart *parts, int count, ThreadPool *pool) {
+    orderedIntSet *result = parts[0].result;
+    int failed = 0;
+
+    if (result->backend == SET_BACKEND_LIST) {
+        for (int k = 1; k < count; k++) {
+            orderedIntSet *part = parts[k].result;
+
+            if (appendDoubleLinkedList(result->list, part->list) != ok) {
+                failed = 1;// Never happens: every part has a pool of its own
+                break;
+            }
+            result->size += part->size;
+            part->list = NULL;// Deleted by appendDoubleLinkedList()
+            deleteOrderedSet(part);
+            parts[k].result = NULL;
+        }
+    }
+    else {
+        CopyPart *copies = (CopyPart *) malloc((size_t) count * sizeof(CopyPart));
+        long long total = 0;
+
+        for (int k = 0; k < count; k++) {
+            total += parts[k].result->size;
+        }
+        result = createOrderedSetWithBackend(SET_BACKEND_ARRAY);
+        if (copies == NULL || total > INT_MAX || reserveSortedArray(result->array, (int) total) != ok) {
+            failed = 1;
+        }
+        else {
+            // Every part knows where its elements go, so they can be copied at the same time
+            for (int k = 0; k < count; k++) {
+                copies[k].to = result->array->elems + result->size;
+                copies[k].from = parts[k].result->array->elems;
+                copies[k].count = parts[k].result->size;
+                result->size += parts[k].result->size;
+            }
+            runThreadPool(pool, copyPart, copies, sizeof(CopyPart), count);
+            result->array->count = result->size;
+        }
+        free(copies);
+
+        for (int k = 0; k < count; k++) {
+            deleteOrderedSet(parts[k].result);
+            parts[k].result = NULL;
+        }
+    }
+
+    if (failed) {
+        // Clean up and return NULL if memory allocation fails
+        for (int k = 0; k < count; k++) {
+            deleteOrderedSet(parts[k].result);
+        }
+        if (result != parts[0].result) {
+            deleteOrderedSet(result);
+        }
+        return NULL;
+    }
+
+    return result;// Return the joined set
+}
+
+/**
+ * @brief Combines two ordered sets into a new set, splitting the work over the threads of a pool.
+ *
+ * @pre Both sets are valid and neither is bitmap backed.
+ * @post A new ordered set is created holding the result of `op`; both input sets remain unchanged.
+ *
+ * @details
+ * - Both sets are split into `PARALLEL_PARTS_PER_THREAD` parts per thread at the same splitter elements, so the
+ *   parts with the same number cover the same range of keys and can be merged independently, see `mergeRange()`.
+ *   Having more parts than threads keeps every thread busy when some ranges turn out larger than others.
+ * - The splitters are sampled from the larger set, or from the smaller one if only that one can be sampled without
+ *   walking it, see `chooseSplitters()`.
+ * - The parts only read the input sets, so they are merged at the same time without locking.
+ * - The results of the parts are joined into one set afterwards, see `joinParts()`. Like `mergeSets()`, the result
+ *   uses the backend of `s1` and a list backed result is indexed if either input set is indexed.
+ *
+ * ***Pseudocode:***
+ * 1. Pick `parts - 1` splitters from the larger set, or from the smaller one if only that one is array backed or
+ *    indexed
+ * 2. Find the position of every splitter in `s1` and `s2`
+ * 3. Merge part `k` of `s1` with part `k` of `s2` for every `k` on the pool
+ * 4. If a part failed, delete the parts and return NULL
+ * 5. Join the results of the parts into `result`
+ * 6. If `s1` or `s2` is indexed, build the index of `result`
+ * 7. Return `result`
+ *
+ * @param s1 A pointer to the first `orderedIntSet`.
+ * @param s2 A pointer to the second `orderedIntSet`.
+ * @param op The set operation to perform.
+ * @param pool The `ThreadPool` to run the parts on.
+ *
+ * @return A pointer to the resulting set, or `NULL` on allocation failure.
+*/
+static orderedIntSet *parallelMerge(orderedIntSet *s1, orderedIntSet *s2, MergeOperation op, ThreadPool *pool) {
+    orderedIntSet *sample = s1->size >= s2->size ? s1 : s2;
+    orderedIntSet *other = sample == s1 ? s2 : s1;
+    int parts = getThreadPoolSize(pool) * PARALLEL_PARTS_PER_THREAD;
+
+    // Sampling a plain list means walking it, which the other set may not need
+    if (sample->backend == SET_BACKEND_LIST && sample->index == NULL
+        && (other->backend == SET_BACKEND_ARRAY || other->index != NULL) && other->size >= parts) {
+        sample = other;
+    }
+    if (parts > sample->size) {
+        parts = sample->size;
+    }
+
+    // Zeroed, so the splitters are written before they are read even if `chooseSplitters()` picks none
+    int *splitters = (int *) calloc((size_t) parts, sizeof(int));
+    SetPosition *positions1 = (SetPosition *) malloc((size_t) (parts + 1) * sizeof(SetPosition));
+    SetPosition *positions2 = (SetPosition *) malloc((size_t) (parts + 1) * sizeof(SetPosition));
+    MergePart *part = (MergePart *) malloc((size_t) parts * sizeof(MergePart));
+    orderedIntSet *result = NULL;
+
+    if (splitters != NULL && positions1 != NULL && positions2 != NULL && part != NULL) {
+        int failed = 0;
+
+        // Split both sets at the same keys
+        chooseSplitters(sample, splitters, parts);
+        findPositions(s1, splitters, parts - 1, positions1);
+        findPositions(s2, splitters, parts - 1, positions2);
+        for (int k = 0; k < parts; k++) {
+            part[k].s1 = s1;
+            part[k].s2 = s2;
+            part[k].from1 = positions1[k];
+            part[k].to1 = positions1[k + 1];
+            part[k].from2 = positions2[k];
+            part[k].to2 = positions2[k + 1];
+            part[k].op = op;
+            part[k].result = NULL;
+        }
+
+        runThreadPool(pool, mergePart, part, sizeof(MergePart), parts);
+
+        for (int k = 0; k < parts; k++) {
+            failed |= part[k].result == NULL;
+        }
+        if (failed) {
+            for (int k = 0; k < parts; k++) {
+                deleteOrderedSet(part[k].result);
+            }
+        }
+        else {
+            result = joinParts(part, parts, pool);
+        }
+    }
+    free(splitters);
+    free(positions1);
+    free(positions2);
+    free(part);
+
+    // Indexed inputs give an indexed result, built in one pass now that every element is in place
+    if (result != NULL && (s1->index != NULL || s2->index != NULL) && !enableSetIndex(result)) {
+        // Clean up and return NULL if memory allocation fails
+        deleteOrderedSet(result);
+        return NULL;
+    }
+
+    return result;// Return the resulting set
+}
+
+/**
+ * @brief Computes the intersection of two ordered sets on the threads of a pool.
+ *
+ * @pre Both sets `s1` and `s2` must be valid (non-NULL); `pool` may be NULL.
+ * @post Returns a new set containing elements common to both `s1` and `s2`.
+ *
+ * @details
+ * - Gives the same result as `setIntersection()`, but splits both sets into matching key ranges that are
+ *   intersected at the same time, see `parallelMerge()`.
+ * - Small inputs, bitmap backed inputs and inputs of very different size are handled by `setIntersection()` on the
+ *   calling thread, as is everything if `pool` is NULL or has one thread.
+ * - The input sets are only read, but must not be modified by other threads during the call.
+ *
+ * Pseudocode:
+ * 1. If `s1` or `s2` is NULL:
+ *      - Return NULL
+ * 2. If the sets are not worth splitting, or `setIntersection()` would gallop:
+ *      - Return the `setIntersection()` of `s1` and `s2`
+ * 3. Return the `MERGE_INTERSECTION` parallel merge of `s1` and `s2`
+ *
+ * @param s1 A pointer to the first `orderedIntSet`.
+ * @param s2 A pointer to the second `orderedIntSet`.
+ * @param pool A pointer to the `ThreadPool` to run on.
+ *
+ * @return A pointer to the resulting set, or `NULL` on failure.
+*/
+orderedIntSet *setIntersectionParallel(orderedIntSet *s1, orderedIntSet *s2, ThreadPool *pool) {
+    // Check if either input set pointer is NULL
+    if (s1 == NULL || s2 == NULL) {
+        return NULL;// Return NULL if inputs are invalid
+    }
+    // Small or skewed inputs are faster on one thread
+    else if (s1 == s2 || !mergesInParallel(s1, s2, pool) || gallopsInto(s1, s2) || gallopsInto(s2, s1)) {
+        return setIntersection(s1, s2);
+    }
+
+    return parallelMerge(s1, s2, MERGE_INTERSECTION, pool);// Return the resulting set
+}
+
+/**
+ * @brief Computes the union of two ordered sets on the threads of a pool.
+ *
+ * @pre Both sets `s1` and `s2` must be valid (non-NULL); `pool` may be NULL.
+ * @post A new ordered set is created containing all unique elements from both input sets.
+ *
+ * @details
+ * - Gives the same result as `setUnion()`, but splits both sets into matching key ranges that are united at the
+ *   same time, see `parallelMerge()`.
+ * - Small and bitmap backed inputs are handled by `setUnion()` on the calling thread, as is everything if `pool`
+ *   is NULL or has one thread.
+ * - The input sets are only read, but must not be modified by other threads during the call.
+ *
+ * Pseudocode:
+ * 1. If `s1` or `s2` is NULL:
+ *      - Return NULL
+ * 2. If the sets are not worth splitting:
+ *      - Return the `setUnion()` of `s1` and `s2`
+ * 3. Return the `MERGE_UNION` parallel merge of `s1` and `s2`
+ *
+ * @param s1 A pointer to the first `orderedIntSet`.
+ * @param s2 A pointer to the second `orderedIntSet`.
+ * @param pool A pointer to the `ThreadPool` to run on.
+ *
+ * @return A pointer to the resulting set, or `NULL` on failure.
+*/
+orderedIntSet *setUnionParallel(orderedIntSet *s1, orderedIntSet *s2, ThreadPool *pool) {
+    // Check if either input set pointer is NULL
+    if (s1 == NULL || s2 == NULL) {
+        return NULL;// Return NULL if inputs are invalid
+    }
+    // Small inputs are faster on one thread
+    else if (!mergesInParallel(s1, s2, pool)) {
+        return setUnion(s1, s2);
+    }
+
+    return parallelMerge(s1, s2, MERGE_UNION, pool);// Return the resulting set
+}
+
+/**
+ * @brief Computes the difference between two ordered sets on the threads of a pool.
+ *
+ * @pre Both sets `s1` and `s2` must be valid (non-NULL); `pool` may be NULL.
+ * @post A new ordered set is created containing elements in `s1` that are not in `s2`.
+ *
+ * @details
+ * - Gives the same result as `setDifference()`, but splits both sets into matching key ranges that are subtracted
+ *   at the same time, see `parallelMerge()`.
+ * - Small and bitmap backed inputs are handled by `setDifference()` on the calling thread, as is everything if
+ *   `pool` is NULL or has one thread.
+ * - The input sets are only read, but must not be modified by other threads during the call.
+ *
+ * Pseudocode:
+ * 1. If `s1` or `s2` is NULL:
+ *      - Return NULL
+ * 2. If the sets are not worth splitting:
+ *      - Return the `setDifference()` of `s1` and `s2`
+ * 3. Return the `MERGE_DIFFERENCE` parallel merge of `s1` and `s2`
+ *
+ * @param s1 A pointer to the first `orderedIntSet` (the minuend set).
+ * @param s2 A pointer to the second `orderedIntSet` (the subtrahend set).
+ * @param pool A pointer to the `ThreadPool` to run on.
+ *
+ * @return A pointer to the resulting set, or `NULL` on failure.
+*/
+orderedIntSet *setDifferenceParallel(orderedIntSet *s1, orderedIntSet *s2, ThreadPool *pool) {
+    // Check if either input set pointer is NULL
+    if (s1 == NULL || s2 == NULL) {
+        return NULL;// Return NULL if inputs are invalid
+    }
+    // Small inputs are faster on one thread
+    else if (!mergesInParallel(s1, s2, pool)) {
+        return setDifference(s1, s2);
+    }
+
+    return parallelMerge(s1, s2, MERGE_DIFFERENCE, pool);// Return the resulting set
+}
+/**
+ * @brief Sorts an array of integers in ascending order with an LSD radix sort.
+ *
+ * @details 
+ * - Sorts one byte at a time, lowest byte first, with a stable counting pass per byte: four O(n) passes in total.
+ * - The sign bit is flipped while computing the top byte's bucket, so negative numbers sort before positive ones.
+ * - Passes in which every element has the same byte are skipped.
+ *
+ * ***Pseudocode:***
+ * 1. For each of the 4 bytes, lowest first:
+ *      - Count how many elements have each byte value
+ *      - If all elements share one value, skip the pass
+ *      - Turn the counts into start positions and copy the elements to `buffer` in that order
+ *      - Swap `elems` and `buffer`
+ * 2. If the sorted elements ended up in `buffer`, copy them back
+ *
+ * @param elems The array to sort.
+ * @param buffer Scratch array of the same length.
+ * @param count Number of elements in both arrays.
+*/
+static void radixSort(int *elems, int *buffer, size_t count) {
+    int *from = elems;
+    int *to = buffer;
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        size_t position[256] = {0};
+        // Flipping the sign bit makes the unsigned order match the signed order
+        unsigned int flip = (shift == 24) ? 0x80u : 0u;
+
+        // Count the elements per byte value
+        for (size_t i = 0; i < count; i++) {
+            position[(((unsigned int) from[i] >> shift) & 0xFFu) ^ flip]++;
+        }
+        // Skip passes that would not move anything
+        if (count == 0 || position[(((unsigned int) from[0] >> shift) & 0xFFu) ^ flip] == count) {
+            continue;
+        }
+        // Turn the counts into the position of the first element of each byte value
+        size_t total = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t bucket = position[b];
+            position[b] = total;
+            total += bucket;
+        }
+        // Stable scatter into the other array
+        for (size_t i = 0; i < count; i++) {
+            to[position[(((unsigned int) from[i] >> shift) & 0xFFu) ^ flip]++] = from[i];
+        }
+
+        int *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    // The last pass may have left the result in the scratch array
+    if (from != elems) {
+        memcpy(elems, from, count * sizeof(int));
+    }
+}
+/**
+ * @brief Creates a new ordered integer set holding the elements of an array.
+ *
+ * @pre `elems` points to `count` integers (or `count` is 0).
+ * @post A new ordered set holds every distinct element of the array; the array itself is unchanged.
+ *
+ * @details 
+ * - Sorted input (`CREATE_FROM_SORTED`) is linked in a single O(n) pass, skipping repeated elements.
+ *   If the input turns out not to be sorted after all, it is treated as unsorted.
+ * - Unsorted input is copied, radix sorted in O(n) and the repeated elements are dropped.
+ * - The nodes for all elements are reserved from the set's node pool in one allocation before linking starts,
+ *   and each element is appended at the tail, so no element is ever searched for.
+ * - With `CREATE_INDEXED` the skip list index is built over the finished list.
+ * - With `CREATE_ARRAY_BACKEND` the distinct elements are copied into a sorted array of exactly the right size.
+ * - With `CREATE_BITMAP_BACKEND` the distinct elements are added to a roaring bitmap in ascending order, and its
+ *   containers are turned into runs where that is smaller.
+ *
+ * ***Pseudocode:***
+ * 1. If `count` does not fit the set's size, or `elems` is NULL while `count` is not 0, return NULL
+ * 2. If the input is not flagged sorted, or is not in ascending order:
+ *      - Copy it and radix sort the copy
+ * 3. Count the distinct elements and reserve that many nodes (or array slots)
+ * 4. Append every element that differs from its predecessor
+ * 5. If `CREATE_INDEXED` is set, enable the index; if the set is bitmap backed, convert containers to runs
+ * 6. Return the new set, or NULL if any allocation failed
+ *
+ * @param elems Array of elements to put in the set.
+ * @param count Number of elements in `elems`.
+ * @param flags `CreateFlags` combined with `|`.
+ *
+ * @return A pointer to the newly created ordered set, or `NULL` on failure.
+*/
+orderedIntSet *createOrderedSetFromArray(const int *elems, size_t count, int flags) {
+    int *sorted = NULL;// Sorted copy of unsorted input
+    const int *source = elems;
+    size_t distinct = 0;
+
+    // The size of a set is an int, and a NULL array can only be empty
+    if (count > INT_MAX || (elems == NULL && count != 0)) {
+        return NULL;
+    }
+
+    // Check whether input flagged as sorted really is; fewer than two elements are always sorted
+    int isSorted = (flags & CREATE_FROM_SORTED) != 0 || count < 2;
+    for (size_t i = 1; isSorted && i < count; i++) {
+        isSorted = elems[i - 1] <= elems[i];
+    }
+
+    if (!isSorted) {
+        // Sort a copy of the input
+        sorted = (int *) malloc(count * sizeof(int));
+        int *buffer = (int *) malloc(count * sizeof(int));
+        if (sorted == NULL || buffer == NULL) {
+            free(sorted);
+            free(buffer);
+            return NULL;// Return NULL if memory allocation fails
+        }
+        memcpy(sorted, elems, count * sizeof(int));
+        radixSort(sorted, buffer, count);
+        free(buffer);
+        source = sorted;
+    }
+
+    // Count the distinct elements so all nodes can be reserved at once
+    for (size_t i = 0; i < count; i++) {
+        if (i == 0 || source[i] != source[i - 1]) {
+            distinct++;
+        }
+    }
+
+    SetBackend backend = SET_BACKEND_LIST;
+    if (flags & CREATE_BITMAP_BACKEND) {
+        backend = SET_BACKEND_BITMAP;
+    }
+    else if (flags & CREATE_ARRAY_BACKEND) {
+        backend = SET_BACKEND_ARRAY;
+    }
+
+    orderedIntSet *result = createOrderedSetWithBackend(backend);
+    ReturnValues status = NUMBER_ADDED;
+    if (backend == SET_BACKEND_ARRAY && reserveSortedArray(result->array, (int) distinct) != ok) {
+        status = ALLOCATION_ERROR;
+    }
+    else if (backend == SET_BACKEND_LIST && reserveNodes(result->list->pool, distinct) != ok) {
+        status = ALLOCATION_ERROR;
+    }
+
+    // Link every distinct element at the tail
+    for (size_t i = 0; i < count && status != ALLOCATION_ERROR; i++) {
+        if (i == 0 || source[i] != source[i - 1]) {
+            status = appendElement(result, source[i]);
+        }
+    }
+    free(sorted);
+
+    if (status != ALLOCATION_ERROR && (flags & CREATE_INDEXED) && !enableSetIndex(result)) {
+        status = ALLOCATION_ERROR;
+    }
+    // Ranges of consecutive elements are stored as runs
+    if (status != ALLOCATION_ERROR && backend == SET_BACKEND_BITMAP) {
+        roaringRunOptimize(result->bitmap);
+    }
+
+    if (status == ALLOCATION_ERROR) {
+        // Clean up and return NULL if memory allocation fails
+        deleteOrderedSet(result);
+        return NULL;
+    }
+
+    return result;// Return the new set
+}
+/**
+ * @brief Moves the elements of an ordered set into another backend.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post `s` holds the same elements, stored in `backend`; on failure `s` is unchanged.
+ *
+ * @details 
+ * - The elements are copied in one ascending pass into storage of exactly the right size, then the old storage
+ *   (and the index of a list backed set) is freed. Converting to the backend the set already uses does nothing.
+ * - Lets a set be built with cheap inserts as a list and then frozen into an array for a read-mostly phase, or
+ *   compressed into a bitmap (with runs where they are smaller) once it is dense.
+ * - Converting a set mapped from a file to the list or bitmap backend copies it out of the file, which makes it
+ *   modifiable and unmaps the file.
+ *
+ * ***Pseudocode:***
+ * 1. If `s` is NULL, return 0; if it already uses `backend`, return 1
+ * 2. Create a temporary set with `backend` and reserve room for `s->size` elements
+ * 3. Append every element of `s` to it; if it is a bitmap, convert its containers to runs
+ * 4. If anything failed, delete the temporary set and return 0
+ * 5. Free the storage of `s` and move the storage of the temporary set into `s`
+ * 6. Return 1
+ *
+ * @param s A pointer to the `orderedIntSet`.
+ * @param backend The `SetBackend` to move the elements to.
+ *
+ * @return 1 on success, 0 if memory could not be allocated.
+*/
+int convertOrderedSet(orderedIntSet *s, SetBackend backend) {
+    // Check if the input set pointer is NULL
+    if (s == NULL) {
+        return 0;
+    }
+    if (s->backend == backend) {
+        return 1;// Nothing to convert
+    }
+
+    // Build the new storage next to the old one
+    orderedIntSet *converted = createOrderedSetWithBackend(backend);
+    ReturnValues status = NUMBER_ADDED;
+    if (backend == SET_BACKEND_ARRAY && reserveSortedArray(converted->array, s->size) != ok) {
+        status = ALLOCATION_ERROR;
+    }
+    else if (backend == SET_BACKEND_LIST && reserveNodes(converted->list->pool, (size_t) s->size) != ok) {
+        status = ALLOCATION_ERROR;
+    }
+
+    SetCursor cursor;
+    for (startSetCursor(&cursor, s); setCursorHasElement(&cursor) && status != ALLOCATION_ERROR; setCursorAdvance(&cursor)) {
+        status = appendElement(converted, setCursorElement(&cursor));
+    }
+    if (status != ALLOCATION_ERROR && backend == SET_BACKEND_BITMAP) {
+        roaringRunOptimize(converted->bitmap);
+    }
+
+    if (status == ALLOCATION_ERROR) {
+        // Clean up and leave the set as it was if memory allocation fails
+        deleteOrderedSet(converted);
+        return 0;
+    }
+
+    // Swap the storage: the old one goes with the temporary set
+    orderedIntSet old = *s;
+    *s = *converted;
+    *converted = old;
+    deleteOrderedSet(converted);
+
+    return 1;
+}
+/**
+ * @brief Computes and prints the contents of the given ordered set to the standard output.
+ *
+ * @pre A valid ordered set exists.
+ * @post The elements of the set are printed in ascending order.
+ *
+ * @details
+ * - Iterates through all elements in the ordered set and prints their values.
+ * - Elements are printed in the format `{e1, e2, e3, ...}`.
+ * - If the set is empty or NULL, prints `{}`.
+ * - The text is collected in blocks and written with one call per block, see `writeOrderedSet()`; other formats
+ *   and other files are written with that function directly.
+ * 
+ * Pseudocode:
+ * 1. Write `s` to the standard output in `SET_FORMAT_BRACES`
+ * 2. Return
+ *
+ * @param s - A pointer to the 'orderedIntSet' to be printed.
+ *
+ * @return 0, or -1 if the output could not be written.
+ * 
+ * @note This function does not modify the structure of the set.
+*/
+int printToStdout(orderedIntSet* s) {
+    // A NULL set is printed as an empty one
+    return writeOrderedSet(s, SET_FORMAT_BRACES, stdout);
 }
 // 
 
@@ -0,0 +1,107 @@
+/**
+ * @file RoaringBitmap.h
+ *
+ * @brief Header file for defining the compressed bitmap used as the storage of dense ordered sets.
+ *
+ * @details
+ * A roaring bitmap splits the 32-bit element domain into chunks of 65536 values that share their upper 16 bits.
+ * Every chunk that holds at least one element gets a container storing the lower 16 bits, in whichever of three
+ * forms is smallest:
+ *   - an array container, a sorted array of up to `ROARING_ARRAY_MAX` 16-bit values, for sparse chunks;
+ *   - a bitmap container, 65536 bits in `ROARING_BITMAP_WORDS` 64-bit words, for dense chunks;
+ *   - a run container, a sorted list of `[start, last]` ranges, for chunks made of long consecutive ranges.
+ *
+ * A dense set costs about one bit per possible value instead of a 24-byte list node per element, and
+ * intersection, union and difference of two bitmap containers are a word-wise AND, OR and AND NOT.
+ *
+ * The functions report errors with the `llError` codes of the double linked list.
+ *
+ * @date 17/10/2026
+ */
+#ifndef RoaringBitmap_h
+#define RoaringBitmap_h
+#include <stddef.h>
+#include <stdint.h>
+#include "DoubleLinkedListTypeDefs.h"
+
+#define ROARING_ARRAY_MAX 4096 /**< Most values an array container holds; beyond that a bitmap is smaller. */
+#define ROARING_BITMAP_WORDS 1024 /**< 64-bit words of a bitmap container, one bit for each of the 65536 values. */
+#define ROARING_RUN_MAX 2047 /**< Most runs a run container holds; beyond that a bitmap is smaller. */
+
+/**
+ * @enum ContainerType
+ * @brief The three forms a container can store its values in.
+ */
+typedef enum {
+    CONTAINER_ARRAY, /* 0 */ /**< Sorted array of values, see `Container::values`. */
+    CONTAINER_BITMAP, /* 1 */ /**< One bit per value, see `Container::words`. */
+    CONTAINER_RUN /* 2 */ /**< Sorted list of ranges, see `Container::runs`. */
+} ContainerType;
+
+/**
+ * @struct RunInterval
+ * @brief A range of consecutive values of a run container, both ends included.
+ */
+typedef struct {
+    uint16_t start; /**< First value of the run. */
+    uint16_t last; /**< Last value of the run. */
+} RunInterval;
+
+/**
+ * @struct Container
+ * @brief The lower 16 bits of the elements of one chunk.
+ *
+ * Only the storage of `type` is allocated, the other two pointers are NULL.
+ */
+typedef struct {
+    ContainerType type; /**< Which of `values`, `words` and `runs` holds the values. */
+    int cardinality; /**< Number of values in the container. */
+    int count; /**< Values (array) or runs (run) in use. */
+    int capacity; /**< Values (array) or runs (run) allocated. */
+    uint16_t *values; /**< Values in ascending order (array container). */
+    uint64_t *words; /**< `ROARING_BITMAP_WORDS` words, bit `v % 64` of word `v / 64` is value `v` (bitmap container). */
+    RunInterval *runs; /**< Disjoint, non-adjacent runs in ascending order (run container). */
+} Container;
+
+/**
+ * @struct RoaringBitmap
+ * @brief A set of integers stored as containers sorted by the upper 16 bits of their elements.
+ */
+typedef struct {
+    uint16_t *keys; /**< Upper 16 bits of the elements of each container, ascending. */
+    Container *containers; /**< The containers, `containers[i]` holds the elements with key `keys[i]`. */
+    int count; /**< Number of containers in use; none of them is empty. */
+    int capacity; /**< Number of keys and containers allocated. */
+} RoaringBitmap;
+
+/**
+ * @struct RoaringIterator
+ * @brief Reads the elements of a roaring bitmap in ascending order, see `roaringRead()`.
+ */
+typedef struct {
+    const RoaringBitmap *bitmap; /**< The bitmap being read; it must not be modified while reading. */
+    int container; /**< Container being read, `bitmap->count` when done. */
+    int position; /**< Next value (array), word (bitmap) or run (run) of the container. */
+    int next; /**< Next value of the current run (run container). */
+    uint64_t word; /**< Bits of the current word not read yet (bitmap container). */
+} RoaringIterator;
+
+RoaringBitmap *createRoaringBitmap();
+void deleteRoaringBitmap(RoaringBitmap *bitmap);
+int roaringContains(const RoaringBitmap *bitmap, int elem);
+llError roaringAdd(RoaringBitmap *bitmap, int elem, int *added);
+llError roaringAddRange(RoaringBitmap *bitmap, int first, int last, int *added);
+llError roaringRemove(RoaringBitmap *bitmap, int elem, int *removed);
+llError roaringRemoveRange(RoaringBitmap *bitmap, int first, int last, int *removed);
+int roaringCardinality(const RoaringBitmap *bitmap);
+int roaringRank(const RoaringBitmap *bitmap, int elem);
+int roaringSelect(const RoaringBitmap *bitmap, int position, int *elem);
+size_t roaringMemoryUsage(const RoaringBitmap *bitmap);
+void roaringRunOptimize(RoaringBitmap *bitmap);
+RoaringBitmap *roaringAnd(const RoaringBitmap *a, const RoaringBitmap *b);
+RoaringBitmap *roaringOr(const RoaringBitmap *a, const RoaringBitmap *b);
+RoaringBitmap *roaringAndNot(const RoaringBitmap *a, const RoaringBitmap *b);
+void roaringStartIterator(RoaringIterator *iterator, const RoaringBitmap *bitmap);
+void roaringSeekIterator(RoaringIterator *iterator, int elem);
+int roaringRead(RoaringIterator *iterator, int *out, int max);
+#endif
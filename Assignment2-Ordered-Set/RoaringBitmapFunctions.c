@@ -0,0 +1,1719 @@
+/**
+ * @file RoaringBitmapFunctions.c
+ *
+ * @brief Implementation of the compressed bitmap used as the storage of dense ordered sets.
+ *
+ * @details This file provides the implementation for:
+ *   - Creating and deleting roaring bitmaps.
+ *   - Adding, removing and looking up elements, converting containers between their three forms as they fill up.
+ *   - Intersection, union and difference, container by container.
+ *   - Converting containers to runs where that saves memory, and reading the elements back in order.
+ *
+ * @date 17/10/2026
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "RoaringBitmap.h"
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#define ALL_BITS (~(uint64_t) 0)
+
+/**
+ * @enum BitmapOperation
+ * @brief Selects what `combineBitmaps()` computes.
+ */
+typedef enum {
+    BITMAP_AND, /**< Elements in both bitmaps. */
+    BITMAP_OR, /**< Elements in either bitmap. */
+    BITMAP_ANDNOT /**< Elements in the first bitmap only. */
+} BitmapOperation;
+
+/**
+ * @brief Counts the bits set in a word.
+*/
+static int countBits(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    // Add up bit counts in ever wider fields: 2, 4, 8 bits, then sum the bytes with one multiply
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int) ((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief Returns the position of the lowest bit set in a word.
+ *
+ * @pre `word` is not 0.
+*/
+static int lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    unsigned long index;
+
+    // _BitScanForward64 is missing on 32-bit targets, so scan the halves
+    if (_BitScanForward(&index, (unsigned long) word)) {
+        return (int) index;
+    }
+    _BitScanForward(&index, (unsigned long) (word >> 32));
+    return (int) index + 32;
+#endif
+}
+
+/**
+ * @brief Maps an element to an unsigned value with the same order: flipping the sign bit puts negative elements
+ *        below positive ones.
+*/
+static uint32_t elementToValue(int elem) {
+    return (uint32_t) elem ^ 0x80000000u;
+}
+
+/**
+ * @brief Rebuilds an element from the key of its container and its value in the container.
+*/
+static int valueToElement(uint16_t key, int low) {
+    return (int) ((((uint32_t) key << 16) | (uint32_t) low) ^ 0x80000000u);
+}
+
+/**
+ * @brief Frees the storage of a container and leaves it empty.
+*/
+static void clearContainer(Container *container) {
+    free(container->values);
+    free(container->words);
+    free(container->runs);
+    container->type = CONTAINER_ARRAY;
+    container->cardinality = 0;
+    container->count = 0;
+    container->capacity = 0;
+    container->values = NULL;
+    container->words = NULL;
+    container->runs = NULL;
+}
+
+/**
+ * @brief Finds the first position of a sorted array of values whose value is greater than or equal to `low`.
+*/
+static int lowerBound(const uint16_t *values, int count, int low) {
+    int lo = 0;
+    int hi = count;
+
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (values[mid] < low) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * @brief Finds the last run that starts at or before `low`.
+ *
+ * @return The position of the run, or -1 if every run starts after `low`.
+*/
+static int findRun(const RunInterval *runs, int count, int low) {
+    int lo = 0;
+    int hi = count;
+
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (runs[mid].start <= low) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    return lo - 1;
+}
+
+/**
+ * @brief Sets the bits of the values `start` to `last` (both included).
+*/
+static void setRange(uint64_t *words, int start, int last) {
+    int first = start >> 6;
+    int end = last >> 6;
+    uint64_t headMask = ALL_BITS << (start & 63);
+    uint64_t tailMask = ALL_BITS >> (63 - (last & 63));
+
+    if (first == end) {
+        words[first] |= headMask & tailMask;
+        return;
+    }
+    words[first] |= headMask;
+    for (int w = first + 1; w < end; w++) {
+        words[w] = ALL_BITS;
+    }
+    words[end] |= tailMask;
+}
+
+/**
+ * @brief Clears the bits of the values `start` to `last` (both included).
+*/
+static void clearRange(uint64_t *words, int start, int last) {
+    int first = start >> 6;
+    int end = last >> 6;
+    uint64_t headMask = ALL_BITS << (start & 63);
+    uint64_t tailMask = ALL_BITS >> (63 - (last & 63));
+
+    if (first == end) {
+        words[first] &= ~(headMask & tailMask);
+        return;
+    }
+    words[first] &= ~headMask;
+    for (int w = first + 1; w < end; w++) {
+        words[w] = 0;
+    }
+    words[end] &= ~tailMask;
+}
+
+/**
+ * @brief Writes the values of any container as bits.
+ *
+ * @param container The container to read.
+ * @param words Receives `ROARING_BITMAP_WORDS` words.
+*/
+static void fillWords(const Container *container, uint64_t *words) {
+    if (container->type == CONTAINER_BITMAP) {
+        memcpy(words, container->words, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+        return;
+    }
+    memset(words, 0, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    if (container->type == CONTAINER_ARRAY) {
+        for (int i = 0; i < container->count; i++) {
+            words[container->values[i] >> 6] |= (uint64_t) 1 << (container->values[i] & 63);
+        }
+    }
+    else {
+        for (int i = 0; i < container->count; i++) {
+            setRange(words, container->runs[i].start, container->runs[i].last);
+        }
+    }
+}
+
+/**
+ * @brief Splits the bits of a bitmap into runs of consecutive set bits.
+ *
+ * @details
+ * - Works a word at a time: the start of a run is the lowest set bit, its end the lowest clear bit above it.
+ *
+ * @param words `ROARING_BITMAP_WORDS` words to split.
+ * @param runs Receives the runs, or NULL to only count them.
+ *
+ * @return The number of runs.
+*/
+static int wordsToRuns(const uint64_t *words, RunInterval *runs) {
+    int count = 0;
+    int open = -1;// Start of a run that continues into the next word
+
+    for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+        uint64_t word = words[w];
+        int base = w * 64;
+
+        if (open >= 0) {
+            if (word == ALL_BITS) {
+                continue;// The run covers the whole word
+            }
+            int end = lowestBit(~word);
+            if (runs != NULL) {
+                runs[count].start = (uint16_t) open;
+                runs[count].last = (uint16_t) (base + end - 1);
+            }
+            count++;
+            open = -1;
+            word &= ALL_BITS << end;// Drop the bits of the run just closed
+        }
+        while (word != 0) {
+            int start = lowestBit(word);
+            uint64_t clear = ~word & (ALL_BITS << start);
+
+            if (clear == 0) {
+                open = base + start;// The run goes on into the next word
+                break;
+            }
+            int end = lowestBit(clear);
+            if (runs != NULL) {
+                runs[count].start = (uint16_t) (base + start);
+                runs[count].last = (uint16_t) (base + end - 1);
+            }
+            count++;
+            word &= ALL_BITS << end;
+        }
+    }
+    if (open >= 0) {
+        if (runs != NULL) {
+            runs[count].start = (uint16_t) open;
+            runs[count].last = 0xFFFF;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Turns a full array container into a bitmap container.
+*/
+static llError arrayToBitmap(Container *container) {
+    uint64_t *words = (uint64_t *) malloc(ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    if (words == NULL) {
+        return noMemory;// The container is unchanged
+    }
+
+    fillWords(container, words);
+    free(container->values);
+    container->values = NULL;
+    container->words = words;
+    container->type = CONTAINER_BITMAP;
+    container->count = 0;
+    container->capacity = 0;
+
+    return ok;
+}
+
+/**
+ * @brief Turns a bitmap container that has become sparse into an array container.
+ *
+ * @details
+ * - If the array cannot be allocated the bitmap simply stays, it is still a valid container.
+*/
+static void bitmapToArray(Container *container) {
+    uint16_t *values = (uint16_t *) malloc((size_t) container->cardinality * sizeof(uint16_t));
+    int n = 0;
+
+    if (values == NULL) {
+        return;
+    }
+    for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+        for (uint64_t word = container->words[w]; word != 0; word &= word - 1) {
+            values[n++] = (uint16_t) (w * 64 + lowestBit(word));
+        }
+    }
+    free(container->words);
+    container->words = NULL;
+    container->values = values;
+    container->type = CONTAINER_ARRAY;
+    container->count = n;
+    container->capacity = n;
+}
+
+/**
+ * @brief Turns the bits of a bitmap into the smallest container that holds them.
+ *
+ * @details
+ * - Takes over `words`: it becomes the storage of a bitmap container, or is freed.
+ *
+ * @param container An empty container that receives the values.
+ * @param words `ROARING_BITMAP_WORDS` words allocated with `malloc()`.
+ *
+ * @return `ok`, or `noMemory` if the array could not be allocated (`words` is freed either way).
+*/
+static llError containerFromWords(Container *container, uint64_t *words) {
+    int cardinality = 0;
+
+    for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+        cardinality += countBits(words[w]);
+    }
+    container->cardinality = cardinality;
+    if (cardinality > ROARING_ARRAY_MAX) {
+        container->type = CONTAINER_BITMAP;
+        container->words = words;
+        return ok;
+    }
+    // Small enough for an array
+    container->type = CONTAINER_BITMAP;
+    container->words = words;
+    if (cardinality == 0) {
+        clearContainer(container);// Empty, the caller drops it
+        return ok;
+    }
+    bitmapToArray(container);
+    if (container->type == CONTAINER_BITMAP) {
+        clearContainer(container);
+        return noMemory;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Turns a run container with too many runs into an array or bitmap container.
+*/
+static llError runToWords(Container *container) {
+    uint64_t *words = (uint64_t *) malloc(ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    if (words == NULL) {
+        return noMemory;// The container is unchanged
+    }
+
+    fillWords(container, words);
+    clearContainer(container);
+
+    return containerFromWords(container, words);
+}
+
+/**
+ * @brief Converts a container to a run container if that takes less memory.
+ *
+ * @details
+ * - A run costs 4 bytes, an array value 2 bytes and a bitmap 8 KiB.
+ * - If the runs cannot be allocated the container is left as it is.
+*/
+static void optimizeContainer(Container *container) {
+    int count = 0;
+
+    if (container->type == CONTAINER_RUN) {
+        return;
+    }
+    if (container->type == CONTAINER_ARRAY) {
+        for (int i = 0; i < container->count; i++) {
+            count += (i == 0 || container->values[i] != container->values[i - 1] + 1);
+        }
+    }
+    else {
+        count = wordsToRuns(container->words, NULL);
+    }
+
+    size_t current = container->type == CONTAINER_ARRAY ? (size_t) container->count * sizeof(uint16_t)
+                                                        : ROARING_BITMAP_WORDS * sizeof(uint64_t);
+    if (count > ROARING_RUN_MAX || (size_t) count * sizeof(RunInterval) >= current) {
+        return;// Runs would not be smaller
+    }
+
+    RunInterval *runs = (RunInterval *) malloc((size_t) count * sizeof(RunInterval));
+    if (runs == NULL) {
+        return;
+    }
+    if (container->type == CONTAINER_ARRAY) {
+        int n = -1;
+        for (int i = 0; i < container->count; i++) {
+            if (i == 0 || container->values[i] != container->values[i - 1] + 1) {
+                runs[++n].start = container->values[i];
+            }
+            runs[n].last = container->values[i];
+        }
+    }
+    else {
+        wordsToRuns(container->words, runs);
+    }
+
+    int cardinality = container->cardinality;
+    clearContainer(container);
+    container->type = CONTAINER_RUN;
+    container->cardinality = cardinality;
+    container->runs = runs;
+    container->count = count;
+    container->capacity = count;
+}
+
+/**
+ * @brief Checks whether a container holds a value.
+*/
+static int containerContains(const Container *container, int low) {
+    if (container->type == CONTAINER_ARRAY) {
+        int pos = lowerBound(container->values, container->count, low);
+        return pos < container->count && container->values[pos] == low;
+    }
+    if (container->type == CONTAINER_BITMAP) {
+        return (int) ((container->words[low >> 6] >> (low & 63)) & 1);
+    }
+
+    int r = findRun(container->runs, container->count, low);
+    return r >= 0 && low <= container->runs[r].last;
+}
+
+/**
+ * @brief Makes room for one more value (array) or run (run) in a container, doubling its capacity.
+ *
+ * @param container The container to grow.
+ * @param limit The most values or runs the container may hold.
+*/
+static llError growContainer(Container *container, int limit) {
+    if (container->count < container->capacity) {
+        return ok;
+    }
+
+    int capacity = container->capacity == 0 ? 4 : container->capacity * 2;
+    if (capacity > limit) {
+        capacity = limit;
+    }
+    if (container->type == CONTAINER_ARRAY) {
+        uint16_t *values = (uint16_t *) realloc(container->values, (size_t) capacity * sizeof(uint16_t));
+        if (values == NULL) {
+            return noMemory;
+        }
+        container->values = values;
+    }
+    else {
+        RunInterval *runs = (RunInterval *) realloc(container->runs, (size_t) capacity * sizeof(RunInterval));
+        if (runs == NULL) {
+            return noMemory;
+        }
+        container->runs = runs;
+    }
+    container->capacity = capacity;
+
+    return ok;
+}
+
+/**
+ * @brief Adds a value to a container.
+ *
+ * @details
+ * - A full array container becomes a bitmap first; a run container that would get too many runs becomes an
+ *   array or bitmap first.
+ * - A value next to a run extends it, and joins it with the following run if that closes the gap.
+ *
+ * @param container The container.
+ * @param low The value to add.
+ * @param added Set to 1 if the value was added, 0 if it was already there.
+ *
+ * @return `ok`, or `noMemory` if the container had to grow and could not (it is unchanged).
+*/
+static llError containerAdd(Container *container, int low, int *added) {
+    *added = 0;
+
+    if (container->type == CONTAINER_BITMAP) {
+        uint64_t bit = (uint64_t) 1 << (low & 63);
+        uint64_t *word = &container->words[low >> 6];
+
+        *added = (*word & bit) == 0;
+        *word |= bit;
+        container->cardinality += *added;
+        return ok;
+    }
+
+    if (container->type == CONTAINER_ARRAY) {
+        int pos = lowerBound(container->values, container->count, low);
+
+        if (pos < container->count && container->values[pos] == low) {
+            return ok;// Already there
+        }
+        if (container->count == ROARING_ARRAY_MAX) {
+            if (arrayToBitmap(container) != ok) {
+                return noMemory;
+            }
+            return containerAdd(container, low, added);
+        }
+        if (growContainer(container, ROARING_ARRAY_MAX) != ok) {
+            return noMemory;
+        }
+        // Shift the larger values up and store the new one
+        memmove(container->values + pos + 1, container->values + pos, (size_t) (container->count - pos) * sizeof(uint16_t));
+        container->values[pos] = (uint16_t) low;
+        container->count++;
+        container->cardinality++;
+        *added = 1;
+        return ok;
+    }
+
+    RunInterval *runs = container->runs;
+    int r = findRun(runs, container->count, low);
+
+    if (r >= 0 && low <= runs[r].last) {
+        return ok;// Already there
+    }
+
+    int joinsPrevious = r >= 0 && runs[r].last + 1 == low;
+    int joinsNext = r + 1 < container->count && runs[r + 1].start == low + 1;
+
+    if (joinsPrevious && joinsNext) {
+        // The value closes the gap between two runs
+        runs[r].last = runs[r + 1].last;
+        memmove(runs + r + 1, runs + r + 2, (size_t) (container->count - r - 2) * sizeof(RunInterval));
+        container->count--;
+    }
+    else if (joinsPrevious) {
+        runs[r].last = (uint16_t) low;
+    }
+    else if (joinsNext) {
+        runs[r + 1].start = (uint16_t) low;
+    }
+    else {
+        // A run of its own
+        if (container->count == ROARING_RUN_MAX) {
+            if (runToWords(container) != ok) {
+                return noMemory;
+            }
+            return containerAdd(container, low, added);
+        }
+        if (growContainer(container, ROARING_RUN_MAX) != ok) {
+            return noMemory;
+        }
+        runs = container->runs;
+        memmove(runs + r + 2, runs + r + 1, (size_t) (container->count - r - 1) * sizeof(RunInterval));
+        runs[r + 1].start = (uint16_t) low;
+        runs[r + 1].last = (uint16_t) low;
+        container->count++;
+    }
+    container->cardinality++;
+    *added = 1;
+
+    return ok;
+}
+
+/**
+ * @brief Removes a value from a container.
+ *
+ * @details
+ * - A bitmap container that drops to `ROARING_ARRAY_MAX` values becomes an array container again.
+ * - Removing a value from the middle of a run splits the run in two.
+ *
+ * @param container The container.
+ * @param low The value to remove.
+ * @param removed Set to 1 if the value was removed, 0 if it was not there.
+ *
+ * @return `ok`, or `noMemory` if a run had to be split and could not (the container is unchanged).
+*/
+static llError containerRemove(Container *container, int low, int *removed) {
+    *removed = 0;
+
+    if (container->type == CONTAINER_BITMAP) {
+        uint64_t bit = (uint64_t) 1 << (low & 63);
+        uint64_t *word = &container->words[low >> 6];
+
+        *removed = (*word & bit) != 0;
+        *word &= ~bit;
+        container->cardinality -= *removed;
+        if (*removed && container->cardinality <= ROARING_ARRAY_MAX && container->cardinality > 0) {
+            bitmapToArray(container);
+        }
+        return ok;
+    }
+
+    if (container->type == CONTAINER_ARRAY) {
+        int pos = lowerBound(container->values, container->count, low);
+
+        if (pos == container->count || container->values[pos] != low) {
+            return ok;// Not there
+        }
+        // Shift the larger values down over it
+        memmove(container->values + pos, container->values + pos + 1, (size_t) (container->count - pos - 1) * sizeof(uint16_t));
+        container->count--;
+        container->cardinality--;
+        *removed = 1;
+        return ok;
+    }
+
+    RunInterval *runs = container->runs;
+    int r = findRun(runs, container->count, low);
+
+    if (r < 0 || low > runs[r].last) {
+        return ok;// Not there
+    }
+    if (runs[r].start == runs[r].last) {
+        // The run held only this value
+        memmove(runs + r, runs + r + 1, (size_t) (container->count - r - 1) * sizeof(RunInterval));
+        container->count--;
+    }
+    else if (low == runs[r].start) {
+        runs[r].start++;
+    }
+    else if (low == runs[r].last) {
+        runs[r].last--;
+    }
+    else {
+        // Split the run around the value
+        if (container->count == ROARING_RUN_MAX) {
+            if (runToWords(container) != ok) {
+                return noMemory;
+            }
+            return containerRemove(container, low, removed);
+        }
+        if (growContainer(container, ROARING_RUN_MAX) != ok) {
+            return noMemory;
+        }
+        runs = container->runs;
+        memmove(runs + r + 2, runs + r + 1, (size_t) (container->count - r - 1) * sizeof(RunInterval));
+        runs[r + 1].start = (uint16_t) (low + 1);
+        runs[r + 1].last = runs[r].last;
+        runs[r].last = (uint16_t) (low - 1);
+        container->count++;
+    }
+    container->cardinality--;
+    *removed = 1;
+
+    return ok;
+}
+
+/**
+ * @brief Copies a container into an empty one, allocating exactly the storage needed.
+*/
+static llError copyContainer(Container *copy, const Container *container) {
+    *copy = *container;
+    copy->values = NULL;
+    copy->words = NULL;
+    copy->runs = NULL;
+
+    if (container->type == CONTAINER_BITMAP) {
+        copy->words = (uint64_t *) malloc(ROARING_BITMAP_WORDS * sizeof(uint64_t));
+        if (copy->words == NULL) {
+            return noMemory;
+        }
+        memcpy(copy->words, container->words, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    }
+    else if (container->type == CONTAINER_ARRAY) {
+        copy->values = (uint16_t *) malloc((size_t) container->count * sizeof(uint16_t));
+        if (copy->values == NULL) {
+            return noMemory;
+        }
+        memcpy(copy->values, container->values, (size_t) container->count * sizeof(uint16_t));
+    }
+    else {
+        copy->runs = (RunInterval *) malloc((size_t) container->count * sizeof(RunInterval));
+        if (copy->runs == NULL) {
+            return noMemory;
+        }
+        memcpy(copy->runs, container->runs, (size_t) container->count * sizeof(RunInterval));
+    }
+    copy->capacity = container->count;
+
+    return ok;
+}
+
+/**
+ * @brief Keeps the values of an array container for which `containerContains(other)` equals `keep`.
+ *
+ * @param result An empty container that receives the values kept.
+ * @param array The array container to filter.
+ * @param other The container to look the values up in.
+ * @param keep 1 to keep the values found in `other`, 0 to keep the values missing from it.
+*/
+static llError filterArray(Container *result, const Container *array, const Container *other, int keep) {
+    uint16_t *values = (uint16_t *) malloc((size_t) array->count * sizeof(uint16_t));
+    int n = 0;
+
+    if (values == NULL) {
+        return noMemory;
+    }
+    if (other->type == CONTAINER_ARRAY) {
+        // Two sorted arrays: merge instead of searching
+        int j = 0;
+        for (int i = 0; i < array->count; i++) {
+            while (j < other->count && other->values[j] < array->values[i]) {
+                j++;
+            }
+            if ((j < other->count && other->values[j] == array->values[i]) == keep) {
+                values[n++] = array->values[i];
+            }
+        }
+    }
+    else {
+        for (int i = 0; i < array->count; i++) {
+            if (containerContains(other, array->values[i]) == keep) {
+                values[n++] = array->values[i];
+            }
+        }
+    }
+
+    if (n == 0) {
+        free(values);
+        return ok;// The caller drops empty containers
+    }
+    result->type = CONTAINER_ARRAY;
+    result->values = values;
+    result->count = n;
+    result->capacity = array->count;
+    result->cardinality = n;
+
+    return ok;
+}
+
+/**
+ * @brief Computes one container of the intersection, union or difference of two bitmaps.
+ *
+ * @details
+ * - Array containers are merged or looked up value by value; everything else is turned into bits and combined
+ *   a 64-bit word at a time with AND, OR or AND NOT.
+ * - Results that could be runs are converted if either input was a run container.
+ *
+ * @param result An empty container that receives the values; it stays empty if there are none.
+ * @param a The container of the first bitmap.
+ * @param b The container of the second bitmap with the same key.
+ * @param op The operation.
+*/
+static llError combineContainers(Container *result, const Container *a, const Container *b, BitmapOperation op) {
+    uint64_t other[ROARING_BITMAP_WORDS];
+
+    if (op == BITMAP_AND && b->type == CONTAINER_ARRAY && a->type != CONTAINER_ARRAY) {
+        const Container *swap = a;// Intersection is symmetric: filter the array
+        a = b;
+        b = swap;
+    }
+    if (op != BITMAP_OR && a->type == CONTAINER_ARRAY) {
+        return filterArray(result, a, b, op == BITMAP_AND);
+    }
+    if (op == BITMAP_OR && a->type == CONTAINER_ARRAY && b->type == CONTAINER_ARRAY
+        && a->count + b->count <= ROARING_ARRAY_MAX) {
+        // Small enough to merge the arrays directly
+        uint16_t *values = (uint16_t *) malloc((size_t) (a->count + b->count) * sizeof(uint16_t));
+        int i = 0;
+        int j = 0;
+        int n = 0;
+
+        if (values == NULL) {
+            return noMemory;
+        }
+        while (i < a->count || j < b->count) {
+            if (j == b->count || (i < a->count && a->values[i] < b->values[j])) {
+                values[n++] = a->values[i++];
+            }
+            else if (i == a->count || b->values[j] < a->values[i]) {
+                values[n++] = b->values[j++];
+            }
+            else {
+                values[n++] = a->values[i++];
+                j++;
+            }
+        }
+        result->type = CONTAINER_ARRAY;
+        result->values = values;
+        result->count = n;
+        result->capacity = a->count + b->count;
+        result->cardinality = n;
+        return ok;
+    }
+
+    uint64_t *words = (uint64_t *) malloc(ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    if (words == NULL) {
+        return noMemory;
+    }
+    fillWords(a, words);
+
+    if (op != BITMAP_AND && b->type == CONTAINER_ARRAY) {
+        // Flip the few bits of the array instead of expanding it
+        for (int i = 0; i < b->count; i++) {
+            uint64_t bit = (uint64_t) 1 << (b->values[i] & 63);
+            words[b->values[i] >> 6] = op == BITMAP_OR ? words[b->values[i] >> 6] | bit : words[b->values[i] >> 6] & ~bit;
+        }
+    }
+    else if (op != BITMAP_AND && b->type == CONTAINER_RUN) {
+        for (int i = 0; i < b->count; i++) {
+            if (op == BITMAP_OR) {
+                setRange(words, b->runs[i].start, b->runs[i].last);
+            }
+            else {
+                clearRange(words, b->runs[i].start, b->runs[i].last);
+            }
+        }
+    }
+    else {
+        const uint64_t *bits = b->words;
+        if (b->type != CONTAINER_BITMAP) {
+            fillWords(b, other);
+            bits = other;
+        }
+        // Word-wise: 64 values per instruction
+        for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+            words[w] = op == BITMAP_AND ? words[w] & bits[w] : op == BITMAP_OR ? words[w] | bits[w] : words[w] & ~bits[w];
+        }
+    }
+
+    if (containerFromWords(result, words) != ok) {
+        return noMemory;
+    }
+    if (result->cardinality > 0 && (a->type == CONTAINER_RUN || b->type == CONTAINER_RUN)) {
+        optimizeContainer(result);
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Makes room for one more container in a bitmap, doubling its capacity.
+*/
+static llError growBitmap(RoaringBitmap *bitmap) {
+    if (bitmap->count < bitmap->capacity) {
+        return ok;
+    }
+
+    int capacity = bitmap->capacity == 0 ? 4 : bitmap->capacity * 2;
+    uint16_t *keys = (uint16_t *) realloc(bitmap->keys, (size_t) capacity * sizeof(uint16_t));
+    if (keys == NULL) {
+        return noMemory;
+    }
+    bitmap->keys = keys;
+    Container *containers = (Container *) realloc(bitmap->containers, (size_t) capacity * sizeof(Container));
+    if (containers == NULL) {
+        return noMemory;// The larger key array is kept, the capacity stays the same
+    }
+    bitmap->containers = containers;
+    bitmap->capacity = capacity;
+
+    return ok;
+}
+
+/**
+ * @brief Makes room for `needed` containers in a bitmap at once, at least doubling its capacity if it grows.
+*/
+static llError reserveContainers(RoaringBitmap *bitmap, int needed) {
+    if (needed <= bitmap->capacity) {
+        return ok;
+    }
+
+    int capacity = bitmap->capacity * 2 > needed ? bitmap->capacity * 2 : needed;
+    uint16_t *keys = (uint16_t *) realloc(bitmap->keys, (size_t) capacity * sizeof(uint16_t));
+    if (keys == NULL) {
+        return noMemory;
+    }
+    bitmap->keys = keys;
+    Container *containers = (Container *) realloc(bitmap->containers, (size_t) capacity * sizeof(Container));
+    if (containers == NULL) {
+        return noMemory;// The larger key array is kept, the capacity stays the same
+    }
+    bitmap->containers = containers;
+    bitmap->capacity = capacity;
+
+    return ok;
+}
+
+/**
+ * @brief Finds the container of a key.
+ *
+ * @details
+ * - Elements are often added in ascending order, so the last container is checked before searching.
+ *
+ * @return The position of the container, or `-(position it would have to be inserted at) - 1`.
+*/
+static int findContainer(const RoaringBitmap *bitmap, uint16_t key) {
+    int lo = 0;
+    int hi = bitmap->count;
+
+    if (hi > 0 && bitmap->keys[hi - 1] <= key) {
+        return bitmap->keys[hi - 1] == key ? hi - 1 : -hi - 1;
+    }
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (bitmap->keys[mid] < key) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    return (lo < bitmap->count && bitmap->keys[lo] == key) ? lo : -lo - 1;
+}
+
+/**
+ * @brief Removes the container at a position from a bitmap and frees it.
+*/
+static void removeContainer(RoaringBitmap *bitmap, int pos) {
+    clearContainer(&bitmap->containers[pos]);
+    memmove(bitmap->keys + pos, bitmap->keys + pos + 1, (size_t) (bitmap->count - pos - 1) * sizeof(uint16_t));
+    memmove(bitmap->containers + pos, bitmap->containers + pos + 1, (size_t) (bitmap->count - pos - 1) * sizeof(Container));
+    bitmap->count--;
+}
+
+/**
+ * @brief Creates a new empty roaring bitmap.
+ *
+ * @pre None.
+ * @post An empty bitmap is created; containers are allocated as elements are added.
+ *
+ * @return A pointer to the new `RoaringBitmap`, or NULL if memory could not be allocated.
+*/
+RoaringBitmap *createRoaringBitmap() {
+    RoaringBitmap *bitmap = (RoaringBitmap *) malloc(sizeof(RoaringBitmap));
+    if (bitmap == NULL) {
+        return NULL;
+    }
+
+    bitmap->keys = NULL;
+    bitmap->containers = NULL;
+    bitmap->count = 0;
+    bitmap->capacity = 0;
+
+    return bitmap;
+}
+
+/**
+ * @brief Deletes a roaring bitmap and all of its containers.
+ *
+ * @pre None, `bitmap` may be NULL.
+ * @post All memory of the bitmap is freed.
+ *
+ * @param bitmap A pointer to the `RoaringBitmap`, or NULL.
+*/
+void deleteRoaringBitmap(RoaringBitmap *bitmap) {
+    if (bitmap == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < bitmap->count; i++) {
+        clearContainer(&bitmap->containers[i]);
+    }
+    free(bitmap->keys);
+    free(bitmap->containers);
+    free(bitmap);
+}
+
+/**
+ * @brief Checks whether an element is in a roaring bitmap.
+ *
+ * @param bitmap A pointer to the `RoaringBitmap`.
+ * @param elem The integer element to look for.
+ *
+ * @return 1 if `elem` is in the bitmap, otherwise 0.
+*/
+int roaringContains(const RoaringBitmap *bitmap, int elem) {
+    uint32_t value = elementToValue(elem);
+    int pos = findContainer(bitmap, (uint16_t) (value >> 16));
+
+    return pos >= 0 && containerContains(&bitmap->containers[pos], (int) (value & 0xFFFF));
+}
+
+/**
+ * @brief Adds an element to a roaring bitmap.
+ *
+ * @pre `bitmap` and `added` are valid.
+ * @post `elem` is in the bitmap, unless memory ran out.
+ *
+ * @details
+ * - Finds the container of the upper 16 bits of `elem`, creating an empty array container if there is none, and
+ *   adds the lower 16 bits to it, see `containerAdd()`.
+ *
+ * ***Pseudocode:***
+ * 1. Find the container of the key of `elem`
+ * 2. If there is none, insert an empty array container at the right position
+ * 3. Add the value to the container
+ * 4. If that failed and the container is empty, remove it again
+ *
+ * @param bitmap A pointer to the `RoaringBitmap`.
+ * @param elem The integer element to add.
+ * @param added Set to 1 if `elem` was added, 0 if it was already there.
+ *
+ * @return `ok`, or `noMemory` if the bitmap could not grow (it is unchanged).
+*/
+llError roaringAdd(RoaringBitmap *bitmap, int elem, int *added) {
+    uint32_t value = elementToValue(elem);
+    uint16_t key = (uint16_t) (value >> 16);
+    int pos = findContainer(bitmap, key);
+    Container empty = {CONTAINER_ARRAY, 0, 0, 0, NULL, NULL, NULL};
+
+    *added = 0;
+    if (pos < 0) {
+        // Start a new container for this chunk
+        pos = -pos - 1;
+        if (growBitmap(bitmap) != ok) {
+            return noMemory;
+        }
+        memmove(bitmap->keys + pos + 1, bitmap->keys + pos, (size_t) (bitmap->count - pos) * sizeof(uint16_t));
+        memmove(bitmap->containers + pos + 1, bitmap->containers + pos, (size_t) (bitmap->count - pos) * sizeof(Container));
+        bitmap->keys[pos] = key;
+        bitmap->containers[pos] = empty;
+        bitmap->count++;
+    }
+
+    llError status = containerAdd(&bitmap->containers[pos], (int) (value & 0xFFFF), added);
+    if (bitmap->containers[pos].cardinality == 0) {
+        removeContainer(bitmap, pos);// Never keep an empty container
+    }
+
+    return status;
+}
+
+/**
+ * @brief Adds every integer from `first` to `last` to a roaring bitmap.
+ *
+ * @pre `bitmap` and `added` are valid, and `first` is not greater than `last`.
+ * @post Every integer from `first` to `last` is in the bitmap, unless memory ran out; then the bitmap is unchanged.
+ *
+ * @details
+ * - Works one chunk of 65536 values at a time instead of one integer at a time: a chunk the range covers whole, or
+ *   that has no container yet, gets a run container holding just its part of the range; a chunk that already has a
+ *   container and is covered in part gets the union of that container with the range, see `combineContainers()`.
+ * - Every new container is built, and room for all of them made, before the bitmap is changed, so running out of
+ *   memory leaves the bitmap as it was.
+ *
+ * ***Pseudocode:***
+ * 1. Find the containers whose keys lie from the key of `first` to the key of `last`
+ * 2. Make room for one container per key of the range
+ * 3. For each key of the range, build its new container:
+ *      - If the range covers the whole chunk, or the key has no container, a run of the part of the range in it
+ *      - Otherwise, the union of its container with that run
+ *      - If that fails, free the containers built so far and return `noMemory`
+ * 4. Free the old containers of the range, move the containers after it into place and store the new ones
+ * 5. Count the integers that were missing and return `ok`
+ *
+ * @param bitmap A pointer to the `RoaringBitmap`.
+ * @param first The smallest integer to add.
+ * @param last The largest integer to add.
+ * @param added Set to the number of integers that were not in the bitmap yet.
+ *
+ * @return `ok`, or `noMemory` if the bitmap could not grow (it is unchanged).
+*/
+llError roaringAddRange(RoaringBitmap *bitmap, int first, int last, int *added) {
+    uint32_t firstValue = elementToValue(first);
+    uint32_t lastValue = elementToValue(last);
+    int firstKey = (int) (firstValue >> 16);
+    int lastKey = (int) (lastValue >> 16);
+    int chunks = lastKey - firstKey + 1;
+    int from = findContainer(bitmap, (uint16_t) firstKey);
+    int to;
+    int before = 0;// Elements of the range's old containers
+    int after = 0;// Elements of the new containers
+
+    *added = 0;
+    from = from >= 0 ? from : -from - 1;
+    for (to = from; to < bitmap->count && bitmap->keys[to] <= lastKey; to++) {
+        before += bitmap->containers[to].cardinality;
+    }
+
+    Container *fresh = (Container *) malloc((size_t) chunks * sizeof(Container));
+    if (fresh == NULL || reserveContainers(bitmap, bitmap->count - (to - from) + chunks) != ok) {
+        free(fresh);
+        return noMemory;// Nothing has changed yet
+    }
+
+    // Build the new container of every chunk, the bitmap is only read
+    for (int i = 0, old = from; i < chunks; i++) {
+        int key = firstKey + i;
+        RunInterval run = {(uint16_t) (key == firstKey ? firstValue & 0xFFFF : 0),
+                           (uint16_t) (key == lastKey ? lastValue & 0xFFFF : 0xFFFF)};
+        Container range = {CONTAINER_RUN, run.last - run.start + 1, 1, 1, NULL, NULL, &run};
+        Container empty = {CONTAINER_ARRAY, 0, 0, 0, NULL, NULL, NULL};
+        const Container *current = (old < to && bitmap->keys[old] == key) ? &bitmap->containers[old++] : NULL;
+        llError status = ok;
+
+        fresh[i] = empty;
+        if (current == NULL || range.cardinality == 65536) {
+            // The chunk holds just its part of the range
+            RunInterval *runs = (RunInterval *) malloc(sizeof(RunInterval));
+
+            if (runs == NULL) {
+                status = noMemory;
+            }
+            else {
+                *runs = run;
+                fresh[i] = range;
+                fresh[i].runs = runs;
+            }
+        }
+        else {
+            status = combineContainers(&fresh[i], current, &range, BITMAP_OR);
+        }
+
+        if (status != ok) {
+            for (int j = 0; j <= i; j++) {
+                clearContainer(&fresh[j]);
+            }
+            free(fresh);
+            return noMemory;
+        }
+        after += fresh[i].cardinality;
+    }
+
+    // Swap the old containers of the range for the new ones
+    for (int i = from; i < to; i++) {
+        clearContainer(&bitmap->containers[i]);
+    }
+    memmove(bitmap->keys + from + chunks, bitmap->keys + to, (size_t) (bitmap->count - to) * sizeof(uint16_t));
+    memmove(bitmap->containers + from + chunks, bitmap->containers + to, (size_t) (bitmap->count - to) * sizeof(Container));
+    for (int i = 0; i < chunks; i++) {
+        bitmap->keys[from + i] = (uint16_t) (firstKey + i);
+        bitmap->containers[from + i] = fresh[i];
+    }
+    bitmap->count += chunks - (to - from);
+    free(fresh);
+    *added = after - before;
+
+    return ok;
+}
+
+/**
+ * @brief Removes every element from `first` to `last` from a roaring bitmap.
+ *
+ * @pre `bitmap` and `removed` are valid, and `first` is not greater than `last`.
+ * @post No element from `first` to `last` is in the bitmap, unless memory ran out; then the bitmap is unchanged.
+ *
+ * @details
+ * - Works one chunk of 65536 values at a time, like `roaringAddRange()`: every container whose chunk the range
+ *   covers whole is dropped without being read, and only the containers of the two chunks holding the ends of the
+ *   range lose part of their values, see `combineContainers()`.
+ * - The new containers of both ends are built before the bitmap is changed, so running out of memory leaves the
+ *   bitmap as it was. The bitmap never needs more containers than before.
+ *
+ * ***Pseudocode:***
+ * 1. Find the containers whose keys lie from the key of `first` to the key of `last`
+ * 2. For each of them whose chunk the range covers only in part, build the container without the range:
+ *      - If that fails, free the containers built so far and return `noMemory`
+ * 3. Free the old containers of the range, store the rebuilt ones that are not empty and move the containers
+ *    after the range down
+ * 4. Count the elements that were dropped and return `ok`
+ *
+ * @param bitmap A pointer to the `RoaringBitmap`.
+ * @param first The smallest integer to remove.
+ * @param last The largest integer to remove.
+ * @param removed Set to the number of elements that were removed.
+ *
+ * @return `ok`, or `noMemory` if a container could not be rebuilt (the bitmap is unchanged).
+*/
+llError roaringRemoveRange(RoaringBitmap *bitmap, int first, int last, int *removed) {
+    uint32_t firstValue = elementToValue(first);
+    uint32_t lastValue = elementToValue(last);
+    int firstKey = (int) (firstValue >> 16);
+    int lastKey = (int) (lastValue >> 16);
+    int from = findContainer(bitmap, (uint16_t) firstKey);
+    int to;
+    Container kept[2];// The rebuilt containers of the chunks of both ends
+    int keptKeys[2];
+    int keptCount = 0;
+    int before = 0;// Elements of the range's old containers
+    int after = 0;// Elements of the rebuilt containers
+
+    *removed = 0;
+    from = from >= 0 ? from : -from - 1;
+    for (to = from; to < bitmap->count && bitmap->keys[to] <= lastKey; to++) {
+        int key = bitmap->keys[to];
+        RunInterval run = {(uint16_t) (key == firstKey ? firstValue & 0xFFFF : 0),
+                           (uint16_t) (key == lastKey ? lastValue & 0xFFFF : 0xFFFF)};
+        Container range = {CONTAINER_RUN, run.last - run.start + 1, 1, 1, NULL, NULL, &run};
+        Container empty = {CONTAINER_ARRAY, 0, 0, 0, NULL, NULL, NULL};
+
+        before += bitmap->containers[to].cardinality;
+        if (range.cardinality == 65536) {
+            continue;// Dropped whole
+        }
+
+        // Only the chunks of first and last get here
+        kept[keptCount] = empty;
+        if (combineContainers(&kept[keptCount], &bitmap->containers[to], &range, BITMAP_ANDNOT) != ok) {
+            for (int i = 0; i <= keptCount; i++) {
+                clearContainer(&kept[i]);
+            }
+            return noMemory;// Nothing has changed yet
+        }
+        after += kept[keptCount].cardinality;
+        keptKeys[keptCount++] = key;
+    }
+
+    // Swap the old containers of the range for the rebuilt ones that are not empty
+    int n = 0;
+    for (int i = from; i < to; i++) {
+        clearContainer(&bitmap->containers[i]);
+    }
+    for (int k = 0; k < keptCount; k++) {
+        if (kept[k].cardinality > 0) {
+            bitmap->keys[from + n] = (uint16_t) keptKeys[k];
+            bitmap->containers[from + n] = kept[k];
+            n++;
+        }
+        else {
+            clearContainer(&kept[k]);
+        }
+    }
+    memmove(bitmap->keys + from + n, bitmap->keys + to, (size_t) (bitmap->count - to) * sizeof(uint16_t));
+    memmove(bitmap->containers + from + n, bitmap->containers + to, (size_t) (bitmap->count - to) * sizeof(Container));
+    bitmap->count -= (to - from) - n;
+    *removed = before - after;
+
+    return ok;
+}
+
+/**
+ * @brief Removes an element from a roaring bitmap.
+ *
+ * @pre `bitmap` and `removed` are valid.
+ * @post `elem` is not in the bitmap, unless memory ran out; containers left empty are freed.
+ *
+ * @param bitmap A pointer to the `RoaringBitmap`.
+ * @param elem The integer element to remove.
+ * @param removed Set to 1 if `elem` was removed, 0 if it was not there.
+ *
+ * @return `ok`, or `noMemory` if a run had to be split and could not (the bitmap is unchanged).
+*/
+llError roaringRemove(RoaringBitmap *bitmap, int elem, int *removed) {
+    uint32_t value = elementToValue(elem);
+    int pos = findContainer(bitmap, (uint16_t) (value >> 16));
+
+    *removed = 0;
+    if (pos < 0) {
+        return ok;// No container, so not there
+    }
+
+    llError status = containerRemove(&bitmap->containers[pos], (int) (value & 0xFFFF), removed);
+    if (bitmap->containers[pos].cardinality == 0) {
+        removeContainer(bitmap, pos);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Counts the elements of a roaring bitmap.
+ *
+ * @param bitmap A pointer to the `RoaringBitmap`.
+ *
+ * @return The number of elements, in O(number of containers).
+*/
+int roaringCardinality(const RoaringBitmap *bitmap) {
+    int cardinality = 0;
+
+    for (int i = 0; i < bitmap->count; i++) {
+        cardinality += bitmap->containers[i].cardinality;
+    }
+
+    return cardinality;
+}
+
+/**
+ * @brief Counts the values of a container that are smaller than `low`.
+*/
+static int containerRank(const Container *container, int low) {
+    int rank = 0;
+
+    if (container->type == CONTAINER_ARRAY) {
+        return lowerBound(container->values, container->count, low);
+    }
+    if (container->type == CONTAINER_BITMAP) {
+        // Whole words below the word of low, then the bits below low in its word
+        for (int i = 0; i < (low >> 6); i++) {
+            rank += countBits(container->words[i]);
+        }
+        return rank + countBits(container->words[low >> 6] & (((uint64_t) 1 << (low & 63)) - 1));
+    }
+
+    // Runs starting below low, cut off at low
+    for (int r = 0; r < container->count && container->runs[r].start < low; r++) {
+        int last = container->runs[r].last < low ? container->runs[r].last : low - 1;
+        rank += last - container->runs[r].start + 1;
+    }
+
+    return rank;
+}
+
+/**
+ * @brief Finds the value at a position of a container.
+ *
+ * @pre `position` is less than the cardinality of the container.
+ *
+ * @return The value with `position` smaller values in the container.
+*/
+static int containerSelect(const Container *container, int position) {
+    if (container->type == CONTAINER_ARRAY) {
+        return container->values[position];
+    }
+    if (container->type == CONTAINER_BITMAP) {
+        for (int i = 0; i < ROARING_BITMAP_WORDS; i++) {
+            uint64_t word = container->words[i];
+            int bits = countBits(word);
+
+            if (position < bits) {
+                // Clear the lower bits until the wanted one is the lowest
+                while (position-- > 0) {
+                    word &= word - 1;
+                }
+                return i * 64 + lowestBit(word);
+            }
+            position -= bits;
+        }
+    }
+    for (int r = 0; r < container->count; r++) {
+        int length = container->runs[r].last - container->runs[r].start + 1;
+
+        if (position < length) {
+            return container->runs[r].start + position;
+        }
+        position -= length;
+    }
+
+    return -1;// Not reached when the precondition holds
+}
+
+/**
+ * @brief Counts the elements of a roaring bitmap that are smaller than `elem`.
+ *
+ * @details
+ * - The cardinalities of the containers before the one of `elem` are added up, then the values below `elem` in
+ *   its container are counted, which is O(number of containers) plus at most one pass over a container.
+ *
+ * @param bitmap A pointer to the `RoaringBitmap`.
+ * @param elem The integer element to count the smaller elements of.
+ *
+ * @return Number of elements smaller than `elem`.
+*/
+int roaringRank(const RoaringBitmap *bitmap, int elem) {
+    uint32_t value = elementToValue(elem);
+    uint16_t key = (uint16_t) (value >> 16);
+    int rank = 0;
+    int i;
+
+    for (i = 0; i < bitmap->count && bitmap->keys[i] < key; i++) {
+        rank += bitmap->containers[i].cardinality;
+    }
+    if (i < bitmap->count && bitmap->keys[i] == key) {
+        rank += containerRank(&bitmap->containers[i], (int) (value & 0xFFFF));
+    }
+
+    return rank;
+}
+
+/**
+ * @brief Finds the element at a position of a roaring bitmap.
+ *
+ * @details
+ * - Skips whole containers by their cardinality, then finds the value inside the container holding the position.
+ *
+ * @param bitmap A pointer to the `RoaringBitmap`.
+ * @param position Number of smaller elements the wanted element has, 0 for the smallest element.
+ * @param elem Set to the element if there is one.
+ *
+ * @return 1 if the bitmap has more than `position` elements, otherwise 0.
+*/
+int roaringSelect(const RoaringBitmap *bitmap, int position, int *elem) {
+    if (position < 0) {
+        return 0;
+    }
+
+    for (int i = 0; i < bitmap->count; i++) {
+        if (position < bitmap->containers[i].cardinality) {
+            *elem = valueToElement(bitmap->keys[i], containerSelect(&bitmap->containers[i], position));
+            return 1;
+        }
+        position -= bitmap->containers[i].cardinality;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Computes the heap memory a roaring bitmap occupies.
+ *
+ * @param bitmap A pointer to the `RoaringBitmap`.
+ *
+ * @return The number of bytes allocated for the bitmap, its key and container arrays and its containers.
+*/
+size_t roaringMemoryUsage(const RoaringBitmap *bitmap) {
+    size_t bytes = sizeof(RoaringBitmap) + (size_t) bitmap->capacity * (sizeof(uint16_t) + sizeof(Container));
+
+    for (int i = 0; i < bitmap->count; i++) {
+        const Container *container = &bitmap->containers[i];
+
+        if (container->type == CONTAINER_BITMAP) {
+            bytes += ROARING_BITMAP_WORDS * sizeof(uint64_t);
+        }
+        else if (container->type == CONTAINER_ARRAY) {
+            bytes += (size_t) container->capacity * sizeof(uint16_t);
+        }
+        else {
+            bytes += (size_t) container->capacity * sizeof(RunInterval);
+        }
+    }
+
+    return bytes;
+}
+
+/**
+ * @brief Converts every container that would be smaller as a run container.
+ *
+ * @pre `bitmap` is valid.
+ * @post The elements are unchanged; containers that could not be converted for lack of memory keep their form.
+ *
+ * @details
+ * - Elements added one by one go to array and bitmap containers; calling this after building a set of long
+ *   consecutive ranges can shrink it from one bit or two bytes per element to four bytes per range.
+ *
+ * @param bitmap A pointer to the `RoaringBitmap`.
+*/
+void roaringRunOptimize(RoaringBitmap *bitmap) {
+    for (int i = 0; i < bitmap->count; i++) {
+        optimizeContainer(&bitmap->containers[i]);
+    }
+}
+
+/**
+ * @brief Appends a container to a bitmap being built in key order, or frees it if it is empty.
+*/
+static llError appendContainer(RoaringBitmap *bitmap, uint16_t key, Container *container) {
+    if (container->cardinality == 0) {
+        clearContainer(container);
+        return ok;
+    }
+    if (growBitmap(bitmap) != ok) {
+        clearContainer(container);
+        return noMemory;
+    }
+    bitmap->keys[bitmap->count] = key;
+    bitmap->containers[bitmap->count] = *container;
+    bitmap->count++;
+
+    return ok;
+}
+
+/**
+ * @brief Computes the intersection, union or difference of two roaring bitmaps.
+ *
+ * @details
+ * - Walks the sorted keys of both bitmaps like a merge: containers with a key in one bitmap only are copied (or
+ *   skipped), containers with a key in both are combined, see `combineContainers()`.
+ *
+ * ***Pseudocode:***
+ * 1. Create an empty bitmap `result`
+ * 2. While both bitmaps have containers left:
+ *      - If the key of `a` is smaller: copy its container unless intersecting, advance `a`
+ *      - If the key of `b` is smaller: copy its container if uniting, advance `b`
+ *      - Otherwise combine both containers and advance both
+ * 3. Copy the remaining containers of `a` unless intersecting, and of `b` if uniting
+ * 4. Return `result`, or NULL if anything failed
+*/
+static RoaringBitmap *combineBitmaps(const RoaringBitmap *a, const RoaringBitmap *b, BitmapOperation op) {
+    RoaringBitmap *result = createRoaringBitmap();
+    llError status = ok;
+    int i = 0;
+    int j = 0;
+
+    if (result == NULL) {
+        return NULL;
+    }
+
+    while (status == ok && (i < a->count || j < b->count)) {
+        Container container = {CONTAINER_ARRAY, 0, 0, 0, NULL, NULL, NULL};
+        uint16_t key;
+
+        if (j == b->count || (i < a->count && a->keys[i] < b->keys[j])) {
+            // Chunk only in the first bitmap
+            if (op == BITMAP_AND) {
+                if (j == b->count) {
+                    break;// Nothing of the second bitmap is left to intersect with
+                }
+                i++;
+                continue;
+            }
+            key = a->keys[i];
+            status = copyContainer(&container, &a->containers[i++]);
+        }
+        else if (i == a->count || b->keys[j] < a->keys[i]) {
+            // Chunk only in the second bitmap
+            if (op != BITMAP_OR) {
+                if (i == a->count) {
+                    break;// Nothing of the first bitmap is left to keep
+                }
+                j++;
+                continue;
+            }
+            key = b->keys[j];
+            status = copyContainer(&container, &b->containers[j++]);
+        }
+        else {
+            // Chunk in both bitmaps
+            key = a->keys[i];
+            status = combineContainers(&container, &a->containers[i++], &b->containers[j++], op);
+        }
+
+        if (status == ok) {
+            status = appendContainer(result, key, &container);
+        }
+        else {
+            clearContainer(&container);
+        }
+    }
+
+    if (status != ok) {
+        // Clean up and return NULL if memory allocation fails
+        deleteRoaringBitmap(result);
+        return NULL;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Computes the intersection of two roaring bitmaps.
+ *
+ * @pre Both bitmaps are valid.
+ * @post A new bitmap holds the elements in both; the inputs are unchanged.
+ *
+ * @return A pointer to the new `RoaringBitmap`, or NULL if memory could not be allocated.
+*/
+RoaringBitmap *roaringAnd(const RoaringBitmap *a, const RoaringBitmap *b) {
+    return combineBitmaps(a, b, BITMAP_AND);
+}
+
+/**
+ * @brief Computes the union of two roaring bitmaps.
+ *
+ * @pre Both bitmaps are valid.
+ * @post A new bitmap holds the elements in either; the inputs are unchanged.
+ *
+ * @return A pointer to the new `RoaringBitmap`, or NULL if memory could not be allocated.
+*/
+RoaringBitmap *roaringOr(const RoaringBitmap *a, const RoaringBitmap *b) {
+    return combineBitmaps(a, b, BITMAP_OR);
+}
+
+/**
+ * @brief Computes the difference of two roaring bitmaps.
+ *
+ * @pre Both bitmaps are valid.
+ * @post A new bitmap holds the elements of `a` that are not in `b`; the inputs are unchanged.
+ *
+ * @return A pointer to the new `RoaringBitmap`, or NULL if memory could not be allocated.
+*/
+RoaringBitmap *roaringAndNot(const RoaringBitmap *a, const RoaringBitmap *b) {
+    return combineBitmaps(a, b, BITMAP_ANDNOT);
+}
+
+/**
+ * @brief Prepares an iterator to read the current container from its first value.
+*/
+static void enterContainer(RoaringIterator *iterator) {
+    iterator->position = 0;
+    iterator->next = 0;
+    iterator->word = 0;
+    if (iterator->container < iterator->bitmap->count) {
+        const Container *container = &iterator->bitmap->containers[iterator->container];
+
+        if (container->type == CONTAINER_BITMAP) {
+            iterator->word = container->words[0];
+        }
+        else if (container->type == CONTAINER_RUN) {
+            iterator->next = container->runs[0].start;
+        }
+    }
+}
+
+/**
+ * @brief Positions an iterator on the first element of a roaring bitmap.
+ *
+ * @param iterator The `RoaringIterator` to start.
+ * @param bitmap A pointer to the `RoaringBitmap` to read; it must not be modified while reading.
+*/
+void roaringStartIterator(RoaringIterator *iterator, const RoaringBitmap *bitmap) {
+    iterator->bitmap = bitmap;
+    iterator->container = 0;
+    enterContainer(iterator);
+}
+
+/**
+ * @brief Moves an iterator to the first element of its bitmap that is greater than or equal to `elem`.
+ *
+ * @details
+ * - The container of `elem` is binary searched by key, then the value (array), word (bitmap) or run inside it, so
+ *   the iterator can be moved backward as well as forward in O(log n).
+ * - If the container has no element from `elem` on, the iterator is left at its end and `roaringRead()` moves on to
+ *   the next container.
+ *
+ * @param iterator The `RoaringIterator`, started with `roaringStartIterator()`.
+ * @param elem The element to move to.
+*/
+void roaringSeekIterator(RoaringIterator *iterator, int elem) {
+    uint32_t value = elementToValue(elem);
+    int low = (int) (value & 0xFFFF);
+    int pos = findContainer(iterator->bitmap, (uint16_t) (value >> 16));
+
+    if (pos < 0) {
+        // No container for the element, the next one starts after it
+        iterator->container = -pos - 1;
+        enterContainer(iterator);
+        return;
+    }
+
+    const Container *container = &iterator->bitmap->containers[pos];
+    iterator->container = pos;
+    enterContainer(iterator);
+    if (container->type == CONTAINER_ARRAY) {
+        iterator->position = lowerBound(container->values, container->count, low);
+    }
+    else if (container->type == CONTAINER_BITMAP) {
+        // Drop the bits of the word below the element
+        iterator->position = low / 64;
+        iterator->word = container->words[low / 64] & (~(uint64_t) 0 << (low % 64));
+    }
+    else {
+        int run = findRun(container->runs, container->count, low);
+
+        if (run >= 0 && container->runs[run].last >= low) {
+            iterator->position = run;
+            iterator->next = low;
+        }
+        else {
+            iterator->position = run + 1;
+            if (iterator->position < container->count) {
+                iterator->next = container->runs[iterator->position].start;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reads the next elements of a roaring bitmap in ascending order.
+ *
+ * @details
+ * - Decodes a batch at a time, so reading is a tight loop per container instead of a call per element:
+ *   array values are copied, bitmap words are walked with a count-trailing-zeros per set bit, runs are counted out.
+ *
+ * @param iterator The `RoaringIterator`.
+ * @param out Receives the elements.
+ * @param max Most elements to read.
+ *
+ * @return The number of elements written to `out`, 0 once every element was read.
+*/
+int roaringRead(RoaringIterator *iterator, int *out, int max) {
+    const RoaringBitmap *bitmap = iterator->bitmap;
+    int n = 0;
+
+    while (n < max && iterator->container < bitmap->count) {
+        const Container *container = &bitmap->containers[iterator->container];
+        uint16_t key = bitmap->keys[iterator->container];
+        int done;
+
+        if (container->type == CONTAINER_ARRAY) {
+            while (n < max && iterator->position < container->count) {
+                out[n++] = valueToElement(key, container->values[iterator->position++]);
+            }
+            done = iterator->position == container->count;
+        }
+        else if (container->type == CONTAINER_BITMAP) {
+            while (n < max && iterator->position < ROARING_BITMAP_WORDS) {
+                if (iterator->word == 0) {
+                    // Move on to the next word
+                    if (++iterator->position < ROARING_BITMAP_WORDS) {
+                        iterator->word = container->words[iterator->position];
+                    }
+                    continue;
+                }
+                out[n++] = valueToElement(key, iterator->position * 64 + lowestBit(iterator->word));
+                iterator->word &= iterator->word - 1;// Clear the bit just read
+            }
+            done = iterator->position == ROARING_BITMAP_WORDS;
+        }
+        else {
+            while (n < max && iterator->position < container->count) {
+                out[n++] = valueToElement(key, iterator->next);
+                if (iterator->next == container->runs[iterator->position].last) {
+                    // Move on to the next run
+                    if (++iterator->position < container->count) {
+                        iterator->next = container->runs[iterator->position].start;
+                    }
+                }
+                else {
+                    iterator->next++;
+                }
+            }
+            done = iterator->position == container->count;
+        }
+
+        if (done) {
+            iterator->container++;
+            enterContainer(iterator);
+        }
+    }
+
+    return n;
+}
+
+// 
+
+// END OF ROARINGBITMAPFUNCTIONS.C
\ No newline at end of file
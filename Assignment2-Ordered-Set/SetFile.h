@@ -0,0 +1,82 @@
+/**
+ * @file SetFile.h
+ *
+ * @brief Header file for defining the binary file format of ordered sets, and saving, loading and mapping set files.
+ *
+ * @details
+ * A set file is a `SetFileHeader` followed by the payload, the elements in ascending order:
+ * - `SET_FILE_RAW` stores each element as a 4-byte integer. The payload is then laid out exactly like the storage
+ *   of an array backed set, so `mapOrderedSet()` can map the file into memory and use it as the set's storage
+ *   without reading or copying it.
+ * - `SET_FILE_DELTA` stores the gap to the previous element as a variable-length integer, 7 bits per byte, so
+ *   dense sets take little more than one byte per element. Such files are always loaded by decoding.
+ *
+ * The header records the number of elements, the payload size and an Adler-32 checksum of the payload. Numbers are
+ * stored in the byte order of the machine that wrote the file (little-endian on the x86 and x64 targets); a file
+ * written in the other byte order has a wrong `magic` and is rejected.
+ *
+ * A set mapped from a file is read-only: `addElement()` and `removeElement()` return `SET_IS_READ_ONLY`, and
+ * `convertOrderedSet()` to another backend copies it into modifiable storage. The file stays mapped until the set
+ * is deleted.
+ *
+ * Set files larger than memory can be combined without loading them, see `SetStream.h`.
+ *
+ * @date 17/10/2026
+ */
+#ifndef SetFile_h
+#define SetFile_h
+#include <stdint.h>
+#include "OrderedList.h"
+
+#define SET_FILE_MAGIC 0x5445534Fu /**< "OSET" in the first four bytes of a little-endian file. */
+#define SET_FILE_VERSION 1u /**< Format version written by `saveOrderedSet()`. */
+
+/**
+ * @enum SetFileEncoding
+ * @brief How the elements are stored in the payload of a set file.
+ */
+typedef enum {
+    SET_FILE_RAW, /* 0 */ /**< 4 bytes per element, can be mapped into memory. */
+    SET_FILE_DELTA /* 1 */ /**< Variable-length gaps between elements, smaller but always decoded. */
+} SetFileEncoding;
+
+/**
+ * @enum SetFileStatus
+ * @brief Outcome of saving, loading or mapping a set file.
+ */
+typedef enum {
+    SET_FILE_OK, /* 0 */ /**< The operation succeeded. */
+    SET_FILE_IO_ERROR, /* 1 */ /**< The file could not be opened, read, written or mapped. */
+    SET_FILE_BAD_FORMAT, /* 2 */ /**< The file is not a set file, or its header or elements are inconsistent. */
+    SET_FILE_BAD_CHECKSUM, /* 3 */ /**< The payload does not match the checksum in the header. */
+    SET_FILE_NOT_MAPPABLE, /* 4 */ /**< Only `SET_FILE_RAW` files can be mapped. */
+    SET_FILE_NO_MEMORY /* 5 */ /**< Memory could not be allocated. */
+} SetFileStatus;
+
+/**
+ * @struct SetFileHeader
+ * @brief The first 32 bytes of a set file.
+ */
+typedef struct {
+    uint32_t magic; /**< `SET_FILE_MAGIC`. */
+    uint32_t version; /**< `SET_FILE_VERSION`. */
+    uint32_t encoding; /**< The `SetFileEncoding` of the payload. */
+    uint32_t count; /**< Number of elements. */
+    uint64_t payloadSize; /**< Number of bytes after the header. */
+    uint32_t checksum; /**< Adler-32 checksum of the payload. */
+    uint32_t reserved; /**< Written as 0; keeps the payload 8-byte aligned. */
+} SetFileHeader;
+
+/**
+ * @struct SetFileMapping
+ * @brief A set file mapped into memory, owned by the read-only set whose storage it is.
+ */
+typedef struct setFileMapping SetFileMapping;
+
+SetFileStatus saveOrderedSet(orderedIntSet* s, const char* path, SetFileEncoding encoding);
+orderedIntSet* loadOrderedSet(const char* path, SetBackend backend, SetFileStatus* status);
+orderedIntSet* mapOrderedSet(const char* path, int verify, SetFileStatus* status);
+void unmapSetFile(SetFileMapping* mapping);
+uint32_t setFileChecksum(uint32_t checksum, const void* data, size_t length);
+SetFileStatus checkSetFileHeader(const SetFileHeader* header);
+#endif
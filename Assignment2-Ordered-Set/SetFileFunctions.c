@@ -0,0 +1,605 @@
+/**
+ * @file SetFileFunctions.c
+ *
+ * @brief Implementation of saving ordered sets to set files, loading them back and mapping them into memory.
+ *
+ * @details This file provides the implementation for:
+ *   - Writing the elements of any set in the raw or the delta encoding, with a checksum.
+ *   - Reading a set file into a new set of any backend.
+ *   - Mapping a raw set file into memory as the storage of a read-only, array backed set.
+ *
+ * @date 17/10/2026
+*/
+
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "SetFile.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define SET_FILE_BUFFER 65536 // Bytes written or read at a time
+#define SET_FILE_MAX_GAP_BYTES 5 // Bytes a 32-bit gap takes at most in the delta encoding
+#define ADLER_MODULUS 65521u // Largest prime below 2^16
+#define ADLER_BLOCK 5552 // Bytes that can be summed before the sums could overflow 32 bits
+
+/**
+ * @struct setFileMapping
+ * @brief The view of a set file mapped into memory.
+ */
+struct setFileMapping {
+    void *base; /**< First byte of the file in memory. */
+    size_t length; /**< Number of bytes mapped. */
+};
+
+/**
+ * @struct DeltaDecoder
+ * @brief Progress of decoding a delta encoded payload that is read in pieces.
+ */
+typedef struct {
+    uint64_t value; /**< Last element decoded, with the sign bit flipped so that the order is unsigned. */
+    uint32_t gap; /**< Bits of the gap being decoded. */
+    int shift; /**< Number of bits of `gap` decoded so far. */
+    uint32_t count; /**< Number of elements decoded. */
+} DeltaDecoder;
+
+/**
+ * @brief Updates the Adler-32 checksum of a set file payload with more bytes.
+ *
+ * @details
+ * - Both sums are only reduced once per `ADLER_BLOCK` bytes, which is as long as they cannot overflow.
+ * - The payload may be passed in pieces of any size.
+ *
+ * @param checksum The checksum of the bytes so far, 1 before the first byte.
+ * @param data The bytes to add.
+ * @param length Number of bytes.
+ *
+ * @return The checksum including `data`.
+*/
+uint32_t setFileChecksum(uint32_t checksum, const void *data, size_t length) {
+    const unsigned char *bytes = (const unsigned char *) data;
+    uint32_t a = checksum & 0xFFFFu;
+    uint32_t b = checksum >> 16;
+
+    while (length > 0) {
+        size_t block = length < ADLER_BLOCK ? length : ADLER_BLOCK;
+
+        length -= block;
+        while (block-- > 0) {
+            a += *bytes++;
+            b += a;
+        }
+        a %= ADLER_MODULUS;
+        b %= ADLER_MODULUS;
+    }
+
+    return (b << 16) | a;
+}
+
+/**
+ * @brief Checks that elements are in strictly ascending order, as a set stores them.
+ *
+ * @return 1 if every element is greater than the one before, else 0.
+*/
+static int strictlyAscending(const int *elems, size_t count) {
+    for (size_t i = 1; i < count; i++) {
+        if (elems[i - 1] >= elems[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Checks that a header describes a set file this version can read.
+ *
+ * @param header The header read from the file.
+ *
+ * @return `SET_FILE_OK`, or `SET_FILE_BAD_FORMAT` if the header is not valid.
+*/
+SetFileStatus checkSetFileHeader(const SetFileHeader *header) {
+    uint64_t count = header->count;
+
+    if (header->magic != SET_FILE_MAGIC || header->version != SET_FILE_VERSION || count > INT_MAX) {
+        return SET_FILE_BAD_FORMAT;
+    }
+    // Every element takes 4 bytes raw, and 1 to 5 bytes delta encoded
+    if (header->encoding == SET_FILE_RAW && header->payloadSize == count * sizeof(int)) {
+        return SET_FILE_OK;
+    }
+    if (header->encoding == SET_FILE_DELTA && header->payloadSize >= count
+        && header->payloadSize <= count * SET_FILE_MAX_GAP_BYTES) {
+        return SET_FILE_OK;
+    }
+
+    return SET_FILE_BAD_FORMAT;
+}
+
+/**
+ * @brief Writes a full buffer of the payload and adds it to the checksum and size in the header.
+ *
+ * @return 1 if the bytes were written, 0 on a write error.
+*/
+static int flushPayload(FILE *file, const unsigned char *buffer, size_t used, SetFileHeader *header) {
+    header->checksum = setFileChecksum(header->checksum, buffer, used);
+    header->payloadSize += used;
+
+    return fwrite(buffer, 1, used, file) == used;
+}
+
+/**
+ * @brief Decodes a piece of a delta encoded payload.
+ *
+ * @details
+ * - Each gap is stored in 7-bit groups, lowest first; the high bit of a byte is set if more groups follow. The
+ *   first gap is the first element itself with its sign bit flipped, so it is never negative.
+ * - A gap that does not fit 32 bits, a gap of 0 after the first element, an element past the largest int or more
+ *   elements than `capacity` make the payload invalid.
+ *
+ * @param decoder The progress made on the previous pieces.
+ * @param bytes The next piece of the payload.
+ * @param length Number of bytes in the piece.
+ * @param elems Receives the decoded elements.
+ * @param capacity Number of elements the header announced.
+ *
+ * @return 1 if the piece is valid, else 0.
+*/
+static int decodeGaps(DeltaDecoder *decoder, const unsigned char *bytes, size_t length, int *elems, uint32_t capacity) {
+    for (size_t i = 0; i < length; i++) {
+        uint32_t group = bytes[i] & 0x7Fu;
+
+        // The fifth byte only has 4 bits left for a 32-bit gap
+        if (decoder->shift == 28 && group > 0xFu) {
+            return 0;
+        }
+        decoder->gap |= group << decoder->shift;
+
+        if (bytes[i] & 0x80u) {
+            decoder->shift += 7;
+            if (decoder->shift > 28) {
+                return 0;
+            }
+            continue;
+        }
+
+        // The gap is complete
+        if ((decoder->count > 0 && decoder->gap == 0) || decoder->count == capacity) {
+            return 0;
+        }
+        decoder->value += decoder->gap;
+        if (decoder->value > 0xFFFFFFFFu) {
+            return 0;
+        }
+        elems[decoder->count++] = (int) ((uint32_t) decoder->value ^ 0x80000000u);
+        decoder->gap = 0;
+        decoder->shift = 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Saves an ordered set to a set file.
+ *
+ * @pre The set `s` must be valid (non-NULL).
+ * @post The file at `path` holds the elements of `s`; the set is unchanged.
+ *
+ * @details
+ * - Works for every backend: the elements are read through a `SetCursor` and written through a buffer of
+ *   `SET_FILE_BUFFER` bytes. The header is written first with a placeholder checksum and payload size and is
+ *   rewritten once the payload is complete.
+ * - An existing file at `path` is replaced; if writing fails, the file is left incomplete.
+ *
+ * ***Pseudocode:***
+ * 1. If `s` or `path` is NULL or the encoding is unknown, return `SET_FILE_BAD_FORMAT`
+ * 2. Allocate the buffer and open the file (`SET_FILE_NO_MEMORY`, `SET_FILE_IO_ERROR`)
+ * 3. Write the header
+ * 4. For each element of `s`:
+ *      - Append it to the buffer, or its gap to the previous element if the encoding is `SET_FILE_DELTA`
+ *      - If the buffer is full, write it out and add it to the checksum
+ * 5. Write out the rest of the buffer
+ * 6. Rewrite the header with the checksum and payload size, and close the file
+ * 7. Return `SET_FILE_OK`, or `SET_FILE_IO_ERROR` if any write failed
+ *
+ * @param s A pointer to the `orderedIntSet` to save.
+ * @param path The file to write.
+ * @param encoding The `SetFileEncoding` of the payload.
+ *
+ * @return The `SetFileStatus` of the save.
+*/
+SetFileStatus saveOrderedSet(orderedIntSet *s, const char *path, SetFileEncoding encoding) {
+    // Check the input
+    if (s == NULL || path == NULL || (encoding != SET_FILE_RAW && encoding != SET_FILE_DELTA)) {
+        return SET_FILE_BAD_FORMAT;
+    }
+
+    SetFileHeader header = {SET_FILE_MAGIC, SET_FILE_VERSION, (uint32_t) encoding, (uint32_t) s->size, 0, 1, 0};
+    unsigned char *buffer = (unsigned char *) malloc(SET_FILE_BUFFER);
+    if (buffer == NULL) {
+        return SET_FILE_NO_MEMORY;
+    }
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        free(buffer);
+        return SET_FILE_IO_ERROR;
+    }
+
+    int written = fwrite(&header, sizeof(SetFileHeader), 1, file) == 1;
+    size_t used = 0;
+    uint32_t previous = 0;
+    SetCursor cursor;
+    for (startSetCursor(&cursor, s); setCursorHasElement(&cursor) && written; setCursorAdvance(&cursor)) {
+        int elem = setCursorElement(&cursor);
+
+        if (encoding == SET_FILE_RAW) {
+            memcpy(buffer + used, &elem, sizeof(int));
+            used += sizeof(int);
+        }
+        else {
+            // Flipping the sign bit makes the gaps between ascending elements positive
+            uint32_t biased = (uint32_t) elem ^ 0x80000000u;
+            uint32_t gap = biased - previous;
+
+            while (gap >= 0x80u) {
+                buffer[used++] = (unsigned char) (gap | 0x80u);
+                gap >>= 7;
+            }
+            buffer[used++] = (unsigned char) gap;
+            previous = biased;
+        }
+
+        // Write the buffer out before the next element could overflow it
+        if (used > SET_FILE_BUFFER - SET_FILE_MAX_GAP_BYTES) {
+            written = flushPayload(file, buffer, used, &header);
+            used = 0;
+        }
+    }
+    if (written && used > 0) {
+        written = flushPayload(file, buffer, used, &header);
+    }
+
+    // Fill in the checksum and the payload size
+    written = written && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(SetFileHeader), 1, file) == 1;
+    if (fclose(file) != 0) {
+        written = 0;
+    }
+    free(buffer);
+
+    return written ? SET_FILE_OK : SET_FILE_IO_ERROR;
+}
+
+/**
+ * @brief Measures how many bytes of an open file follow the current position, leaving the position where it was.
+ *
+ * @return 1 if `bytes` holds the number of bytes, 0 if the file cannot seek.
+*/
+static int remainingFileBytes(FILE *file, uint64_t *bytes) {
+#ifdef _WIN32
+    // ftell() is 32 bits on Windows
+    long long position = _ftelli64(file);
+    long long end = -1;
+
+    if (position >= 0 && _fseeki64(file, 0, SEEK_END) == 0) {
+        end = _ftelli64(file);
+    }
+    if (end < position || _fseeki64(file, position, SEEK_SET) != 0) {
+        return 0;
+    }
+#else
+    long position = ftell(file);
+    long end = -1;
+
+    if (position >= 0 && fseek(file, 0, SEEK_END) == 0) {
+        end = ftell(file);
+    }
+    if (end < position || fseek(file, position, SEEK_SET) != 0) {
+        return 0;
+    }
+#endif
+    *bytes = (uint64_t) (end - position);
+
+    return 1;
+}
+
+/**
+ * @brief Loads a set file into a new ordered set.
+ *
+ * @pre None.
+ * @post A new set stored in `backend` holds the elements of the file; on failure nothing is allocated.
+ *
+ * @details
+ * - The elements are read into a sorted array of exactly the right size: a raw payload straight into it, a delta
+ *   encoded one through a buffer of `SET_FILE_BUFFER` bytes. Other backends are then built from the array in one
+ *   pass, see `convertOrderedSet()`.
+ * - The checksum is verified and the elements must be strictly ascending, so a damaged file is never turned into
+ *   a set that breaks the invariants of the set functions.
+ * - The payload size of the header is checked against the length of the file before anything is allocated, so a
+ *   header claiming more elements than the file holds is reported as a bad format, not as running out of memory.
+ *
+ * ***Pseudocode:***
+ * 1. Open the file and read and check the header, and check that the file holds the whole payload
+ * 2. Create an array backed set with room for all elements
+ * 3. Read the payload into it, updating the checksum:
+ *      - Raw payloads are read directly into the array
+ *      - Delta encoded payloads are read piece by piece and decoded into the array
+ * 4. Check the checksum, the number of elements and their order
+ * 5. If `backend` is not the array, convert the set
+ * 6. On any failure, delete the set and report why in `status`
+ * 7. Return the set
+ *
+ * @param path The file to read.
+ * @param backend The `SetBackend` the new set stores its elements in.
+ * @param status Receives the `SetFileStatus` of the load, may be NULL.
+ *
+ * @return A pointer to the new `orderedIntSet`, or NULL on failure.
+*/
+orderedIntSet *loadOrderedSet(const char *path, SetBackend backend, SetFileStatus *status) {
+    SetFileStatus result = SET_FILE_OK;
+    SetFileHeader header;
+    orderedIntSet *s = NULL;
+    unsigned char *buffer = NULL;
+    uint32_t checksum = 1;
+    uint64_t available;
+    FILE *file = path != NULL ? fopen(path, "rb") : NULL;
+
+    if (file == NULL) {
+        result = SET_FILE_IO_ERROR;
+    }
+    else if (fread(&header, sizeof(SetFileHeader), 1, file) != 1) {
+        result = SET_FILE_BAD_FORMAT;// Too short for a header
+    }
+    else if ((result = checkSetFileHeader(&header)) == SET_FILE_OK) {
+        // Compare the payload with what the file really holds before allocating for it
+        if (!remainingFileBytes(file, &available)) {
+            result = SET_FILE_IO_ERROR;
+        }
+        else if (header.payloadSize > available) {
+            result = SET_FILE_BAD_FORMAT;// The file was cut short
+        }
+    }
+
+    if (result == SET_FILE_OK) {
+        s = createOrderedSetWithBackend(SET_BACKEND_ARRAY);
+        if (reserveSortedArray(s->array, (int) header.count) != ok) {
+            result = SET_FILE_NO_MEMORY;
+        }
+    }
+
+    if (result == SET_FILE_OK && header.encoding == SET_FILE_RAW) {
+        // The payload is laid out like the array
+        if (fread(s->array->elems, sizeof(int), header.count, file) != header.count) {
+            result = SET_FILE_BAD_FORMAT;
+        }
+        else {
+            checksum = setFileChecksum(checksum, s->array->elems, header.payloadSize);
+            if (!strictlyAscending(s->array->elems, header.count)) {
+                result = SET_FILE_BAD_FORMAT;
+            }
+        }
+    }
+    else if (result == SET_FILE_OK) {
+        DeltaDecoder decoder = {0, 0, 0, 0};
+        uint64_t remaining = header.payloadSize;
+
+        buffer = (unsigned char *) malloc(SET_FILE_BUFFER);
+        if (buffer == NULL) {
+            result = SET_FILE_NO_MEMORY;
+        }
+        // Decode the payload one buffer at a time
+        while (result == SET_FILE_OK && remaining > 0) {
+            size_t piece = remaining < SET_FILE_BUFFER ? (size_t) remaining : SET_FILE_BUFFER;
+
+            if (fread(buffer, 1, piece, file) != piece) {
+                result = SET_FILE_BAD_FORMAT;
+            }
+            else {
+                checksum = setFileChecksum(checksum, buffer, piece);
+                if (!decodeGaps(&decoder, buffer, piece, s->array->elems, header.count)) {
+                    result = SET_FILE_BAD_FORMAT;
+                }
+                remaining -= piece;
+            }
+        }
+        // Every announced element must be there, and the last gap must be complete
+        if (result == SET_FILE_OK && (decoder.count != header.count || decoder.shift != 0)) {
+            result = SET_FILE_BAD_FORMAT;
+        }
+    }
+
+    if (result == SET_FILE_OK && checksum != header.checksum) {
+        result = SET_FILE_BAD_CHECKSUM;
+    }
+    if (result == SET_FILE_OK) {
+        s->array->count = (int) header.count;
+        s->size = (int) header.count;
+        if (!convertOrderedSet(s, backend)) {
+            result = SET_FILE_NO_MEMORY;
+        }
+    }
+
+    if (file != NULL) {
+        fclose(file);
+    }
+    free(buffer);
+    if (result != SET_FILE_OK) {
+        // Clean up and return NULL if the file could not be loaded
+        deleteOrderedSet(s);
+        s = NULL;
+    }
+    if (status != NULL) {
+        *status = result;
+    }
+
+    return s;
+}
+
+/**
+ * @brief Maps a file into memory read-only.
+ *
+ * @return 1 on success, 0 if the file could not be opened or mapped.
+*/
+static int mapFile(const char *path, SetFileMapping *mapping) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER size;
+    HANDLE view = NULL;
+
+    if (file == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && (unsigned long long) size.QuadPart <= SIZE_MAX) {
+        view = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    mapping->base = view != NULL ? MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0) : NULL;
+    mapping->length = mapping->base != NULL ? (size_t) size.QuadPart : 0;
+    // The view keeps the file mapped after the handles are closed
+    if (view != NULL) {
+        CloseHandle(view);
+    }
+    CloseHandle(file);
+#else
+    int file = open(path, O_RDONLY);
+    struct stat info;
+
+    if (file < 0) {
+        return 0;
+    }
+    mapping->base = NULL;
+    mapping->length = 0;
+    if (fstat(file, &info) == 0 && info.st_size > 0 && (unsigned long long) info.st_size <= SIZE_MAX) {
+        void *base = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (base != MAP_FAILED) {
+            mapping->base = base;
+            mapping->length = (size_t) info.st_size;
+        }
+    }
+    // The mapping stays valid after the file is closed
+    close(file);
+#endif
+
+    return mapping->base != NULL;
+}
+
+/**
+ * @brief Unmaps a set file mapped by `mapOrderedSet()`.
+ *
+ * @pre No set uses the mapping as its storage any more.
+ * @post The file is unmapped and the mapping freed.
+ *
+ * @param mapping A pointer to the `SetFileMapping`, or NULL.
+*/
+void unmapSetFile(SetFileMapping *mapping) {
+    if (mapping == NULL) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(mapping->base);
+#else
+    munmap(mapping->base, mapping->length);
+#endif
+    free(mapping);
+}
+
+/**
+ * @brief Maps a raw set file into memory and uses it as the storage of a new, read-only, array backed set.
+ *
+ * @pre None.
+ * @post A new array backed set reads its elements straight from the file; it cannot be modified, see `SetFile.h`.
+ *
+ * @details
+ * - Nothing is read or copied up front: the operating system loads the pages of the file as the set touches
+ *   them, and processes mapping the same file share them. Opening a set this way takes the same time whatever its
+ *   size, unless `verify` is set.
+ * - With `verify`, the checksum and the order of the elements are checked, which reads the whole file once.
+ *   Without it only the header is checked; the file must then not be damaged, or the set functions may return
+ *   wrong results.
+ * - The file must not be modified while it is mapped.
+ *
+ * ***Pseudocode:***
+ * 1. Map the file (`SET_FILE_IO_ERROR`)
+ * 2. Check the header and that the file holds the whole payload (`SET_FILE_BAD_FORMAT`)
+ * 3. If the payload is not raw, return `SET_FILE_NOT_MAPPABLE`
+ * 4. If `verify` is set, check the checksum and the order of the elements
+ * 5. Create an array backed set and point its array at the payload, keeping the mapping in the set
+ * 6. On any failure, unmap the file and report why in `status`
+ * 7. Return the set
+ *
+ * @param path The file to map.
+ * @param verify 1 to check the checksum and order of the elements, 0 to trust the file.
+ * @param status Receives the `SetFileStatus` of the mapping, may be NULL.
+ *
+ * @return A pointer to the new read-only `orderedIntSet`, or NULL on failure.
+*/
+orderedIntSet *mapOrderedSet(const char *path, int verify, SetFileStatus *status) {
+    SetFileStatus result = SET_FILE_OK;
+    SetFileHeader header;
+    orderedIntSet *s = NULL;
+    SetFileMapping *mapping = (SetFileMapping *) malloc(sizeof(SetFileMapping));
+
+    if (mapping == NULL) {
+        result = SET_FILE_NO_MEMORY;
+    }
+    else if (path == NULL || !mapFile(path, mapping)) {
+        free(mapping);
+        mapping = NULL;
+        result = SET_FILE_IO_ERROR;
+    }
+    else if (mapping->length < sizeof(SetFileHeader)) {
+        result = SET_FILE_BAD_FORMAT;
+    }
+    else {
+        memcpy(&header, mapping->base, sizeof(SetFileHeader));
+        result = checkSetFileHeader(&header);
+        if (result == SET_FILE_OK && header.payloadSize > mapping->length - sizeof(SetFileHeader)) {
+            result = SET_FILE_BAD_FORMAT;// The file was cut short
+        }
+        else if (result == SET_FILE_OK && header.encoding != SET_FILE_RAW) {
+            result = SET_FILE_NOT_MAPPABLE;
+        }
+    }
+
+    // The payload starts 32 bytes into a page aligned mapping, so it is aligned for ints
+    int *elems = mapping != NULL ? (int *) ((char *) mapping->base + sizeof(SetFileHeader)) : NULL;
+    if (result == SET_FILE_OK && verify) {
+        if (setFileChecksum(1, elems, header.payloadSize) != header.checksum) {
+            result = SET_FILE_BAD_CHECKSUM;
+        }
+        else if (!strictlyAscending(elems, header.count)) {
+            result = SET_FILE_BAD_FORMAT;
+        }
+    }
+
+    if (result == SET_FILE_OK) {
+        s = createOrderedSetWithBackend(SET_BACKEND_ARRAY);
+        // The array is never written to, so it can point into the read-only mapping
+        free(s->array->elems);
+        s->array->elems = elems;
+        s->array->count = (int) header.count;
+        s->array->capacity = (int) header.count;
+        s->size = (int) header.count;
+        s->mapping = mapping;
+    }
+    else {
+        unmapSetFile(mapping);
+    }
+    if (status != NULL) {
+        *status = result;
+    }
+
+    return s;
+}
+
+// 
+
+// END OF SETFILEFUNCTIONS.C
\ No newline at end of file
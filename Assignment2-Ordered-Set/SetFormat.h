@@ -0,0 +1,41 @@
+/**
+ * @file SetFormat.h
+ *
+ * @brief Header file for defining the text formats ordered sets are written in, and the buffered writer for them.
+ *
+ * @details
+ * Sets are written element by element into a buffer, which is handed to `fwrite()` in blocks of
+ * `SET_FORMAT_BUFFER` bytes, and integers are converted to decimal two digits at a time by `formatInt()`. Writing
+ * a set thus costs one library call per block instead of formatted output calls per element.
+ *
+ * The `SetFormat` selects the text around and between the elements:
+ * - `SET_FORMAT_BRACES`: `{1, 2, 3}` and a newline, as printed by `printToStdout()`.
+ * - `SET_FORMAT_LINES`: one element per line, nothing for an empty set.
+ * - `SET_FORMAT_CSV`: one line of comma separated elements.
+ * - `SET_FORMAT_JSON`: a JSON array `[1,2,3]` and a newline.
+ *
+ * @date 17/10/2026
+ */
+#ifndef SetFormat_h
+#define SetFormat_h
+#include <stdio.h>
+#include "OrderedList.h"
+
+#define SET_FORMAT_BUFFER 16384 /**< Bytes `writeOrderedSet()` collects before each write. */
+#define SET_FORMAT_MAX_INT 11 /**< Characters `formatInt()` writes at most: a sign and 10 digits. */
+
+/**
+ * @enum SetFormat
+ * @brief The text formats a set can be written in.
+ */
+typedef enum {
+    SET_FORMAT_BRACES, /* 0 */ /**< `{1, 2, 3}` and a newline. */
+    SET_FORMAT_LINES, /* 1 */ /**< One element per line. */
+    SET_FORMAT_CSV, /* 2 */ /**< `1,2,3` and a newline. */
+    SET_FORMAT_JSON /* 3 */ /**< `[1,2,3]` and a newline. */
+} SetFormat;
+
+int formatInt(char* out, int value);
+size_t formatOrderedSet(orderedIntSet* s, SetFormat format, char* buffer, size_t capacity);
+int writeOrderedSet(orderedIntSet* s, SetFormat format, FILE* file);
+#endif
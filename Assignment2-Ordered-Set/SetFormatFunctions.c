@@ -0,0 +1,226 @@
+/**
+ * @file SetFormatFunctions.c
+ *
+ * @brief Implementation of the buffered writer that turns ordered sets into text.
+ *
+ * @details This file provides the implementation for:
+ *   - Converting integers to decimal without the formatted output functions of the C library.
+ *   - Writing a set in any `SetFormat` into a caller-supplied buffer or to a `FILE` in large blocks.
+ *
+ * @date 17/10/2026
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "SetFormat.h"
+
+/**
+ * @struct FormatText
+ * @brief The text a `SetFormat` puts around and between the elements.
+ */
+typedef struct {
+    const char *open; /**< Written before the first element. */
+    const char *separator; /**< Written between two elements. */
+    const char *close; /**< Written after the last element. */
+    const char *empty; /**< Written instead of all of the above for an empty set. */
+} FormatText;
+
+static const FormatText formatTexts[] = {
+    {"{", ", ", "}\n", "{}\n"},// SET_FORMAT_BRACES
+    {"", "\n", "\n", ""},// SET_FORMAT_LINES
+    {"", ",", "\n", "\n"},// SET_FORMAT_CSV
+    {"[", ",", "]\n", "[]\n"}// SET_FORMAT_JSON
+};
+
+// The decimal digits of 0 to 99, two characters each
+static const char digitPairs[] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+/**
+ * @struct FormatOutput
+ * @brief Where formatted text goes: a caller-supplied buffer, or a buffer written to a file whenever it is full.
+ */
+typedef struct {
+    char *buffer; /**< The buffer. */
+    size_t capacity; /**< Size of `buffer` in bytes. */
+    size_t used; /**< Bytes of `buffer` in use. */
+    size_t total; /**< Bytes of text produced, including those that did not fit a caller-supplied buffer. */
+    FILE *file; /**< File the buffer is written to, NULL for a caller-supplied buffer. */
+    int failed; /**< 1 once writing to `file` failed. */
+} FormatOutput;
+
+/**
+ * @brief Writes an integer in decimal.
+ *
+ * @details
+ * - Digits are produced two at a time from `digitPairs`, halving the number of divisions.
+ * - The magnitude is computed in unsigned arithmetic, so the smallest int is written correctly.
+ *
+ * @param out Receives the text, at least `SET_FORMAT_MAX_INT` characters; it is not NUL terminated.
+ * @param value The integer.
+ *
+ * @return The number of characters written.
+*/
+int formatInt(char *out, int value) {
+    char digits[10];
+    int count = 0;
+    int length = 0;
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int) value : (unsigned int) value;
+
+    // Collect the digits lowest first
+    while (magnitude >= 100) {
+        unsigned int pair = (magnitude % 100) * 2;
+
+        magnitude /= 100;
+        digits[count++] = digitPairs[pair + 1];
+        digits[count++] = digitPairs[pair];
+    }
+    if (magnitude >= 10) {
+        digits[count++] = digitPairs[magnitude * 2 + 1];
+        digits[count++] = digitPairs[magnitude * 2];
+    }
+    else {
+        digits[count++] = (char) ('0' + magnitude);
+    }
+
+    if (value < 0) {
+        out[length++] = '-';
+    }
+    while (count > 0) {
+        out[length++] = digits[--count];
+    }
+
+    return length;
+}
+
+/**
+ * @brief Writes the buffer of a file output and empties it.
+*/
+static void flushOutput(FormatOutput *out) {
+    if (out->used > 0 && fwrite(out->buffer, 1, out->used, out->file) != out->used) {
+        out->failed = 1;
+    }
+    out->used = 0;
+}
+
+/**
+ * @brief Appends text to an output.
+ *
+ * @details
+ * - A file output writes its buffer first if the text does not fit; the pieces are far smaller than the buffer.
+ * - A caller-supplied buffer takes what fits, keeping one byte for the terminating NUL; the rest is only counted.
+*/
+static void emit(FormatOutput *out, const char *text, size_t length) {
+    out->total += length;
+
+    if (out->file != NULL) {
+        if (out->used + length > out->capacity) {
+            flushOutput(out);
+        }
+    }
+    else if (out->used + length >= out->capacity) {
+        length = out->capacity > out->used ? out->capacity - out->used - 1 : 0;
+    }
+    if (length > 0) {
+        memcpy(out->buffer + out->used, text, length);
+        out->used += length;
+    }
+}
+
+/**
+ * @brief Produces the text of a set in a format.
+ *
+ * ***Pseudocode:***
+ * 1. If `s` is NULL or empty, emit the text of an empty set and return
+ * 2. Emit the opening text
+ * 3. For each element, emit the separator (except before the first) and the element in decimal
+ * 4. Emit the closing text
+*/
+static void formatInto(orderedIntSet *s, SetFormat format, FormatOutput *out) {
+    const FormatText *text = &formatTexts[(unsigned int) format <= SET_FORMAT_JSON ? format : SET_FORMAT_BRACES];
+
+    if (s == NULL || s->size == 0) {
+        emit(out, text->empty, strlen(text->empty));
+        return;
+    }
+
+    size_t separatorLength = strlen(text->separator);
+    char element[SET_FORMAT_MAX_INT + 4];
+    SetCursor cursor;
+
+    emit(out, text->open, strlen(text->open));
+    startSetCursor(&cursor, s);
+    // The first element has no separator before it
+    emit(out, element, (size_t) formatInt(element, setCursorElement(&cursor)));
+    setCursorAdvance(&cursor);
+    memcpy(element, text->separator, separatorLength);
+    for (; setCursorHasElement(&cursor); setCursorAdvance(&cursor)) {
+        int length = formatInt(element + separatorLength, setCursorElement(&cursor));
+        emit(out, element, separatorLength + (size_t) length);
+    }
+    emit(out, text->close, strlen(text->close));
+}
+
+/**
+ * @brief Writes an ordered set as text into a caller-supplied buffer.
+ *
+ * @pre `buffer` has room for `capacity` characters, or `capacity` is 0.
+ * @post `buffer` holds as much of the text as fits, NUL terminated if `capacity` is not 0; the set is unchanged.
+ *
+ * @details
+ * - Like `snprintf()`, the full length is returned even if the text was cut off, so a buffer of that length plus
+ *   one holds all of it. A NULL set is written as an empty one, and unknown formats as `SET_FORMAT_BRACES`.
+ *
+ * @param s A pointer to the `orderedIntSet`, or NULL.
+ * @param format The `SetFormat` to write.
+ * @param buffer Receives the text.
+ * @param capacity Size of `buffer` in characters.
+ *
+ * @return The length of the whole text, without the terminating NUL.
+*/
+size_t formatOrderedSet(orderedIntSet *s, SetFormat format, char *buffer, size_t capacity) {
+    FormatOutput out = {buffer, capacity, 0, 0, NULL, 0};
+
+    formatInto(s, format, &out);
+    if (capacity > 0) {
+        buffer[out.used] = '\0';
+    }
+
+    return out.total;
+}
+
+/**
+ * @brief Writes an ordered set as text to a file.
+ *
+ * @pre `file` is open for writing.
+ * @post The text of the set is written to `file`; the set is unchanged.
+ *
+ * @details
+ * - The text is collected in a buffer of `SET_FORMAT_BUFFER` bytes on the stack and written with one `fwrite()`
+ *   per full buffer. A NULL set is written as an empty one, and unknown formats as `SET_FORMAT_BRACES`.
+ *
+ * ***Pseudocode:***
+ * 1. Produce the text of `s` into the buffer, writing it to `file` whenever it is full
+ * 2. Write what is left in the buffer
+ * 3. Return 0, or -1 if any write failed
+ *
+ * @param s A pointer to the `orderedIntSet`, or NULL.
+ * @param format The `SetFormat` to write.
+ * @param file The file to write to.
+ *
+ * @return 0 on success, -1 if writing failed.
+*/
+int writeOrderedSet(orderedIntSet *s, SetFormat format, FILE *file) {
+    char buffer[SET_FORMAT_BUFFER];
+    FormatOutput out = {buffer, SET_FORMAT_BUFFER, 0, 0, file, 0};
+
+    formatInto(s, format, &out);
+    flushOutput(&out);
+
+    return out.failed ? -1 : 0;
+}
+
+// 
+
+// END OF SETFORMATFUNCTIONS.C
\ No newline at end of file
@@ -0,0 +1,35 @@
+/**
+ * @file SetKernels.h
+ *
+ * @brief Header file for defining the SIMD kernels that intersect and subtract sorted integer arrays.
+ *
+ * @details
+ * When both sets of an intersection or difference are array backed, the elements are compared a block at a time:
+ * a block of 4 (SSE) or 8 (AVX2) elements of the first array is compared with every rotation of a block of the
+ * second array, the matching lanes are packed together with one shuffle and written out in one store.
+ * The widest kernel the processor supports is picked at runtime; a scalar merge is used everywhere else.
+ *
+ * @note The kernels store whole vectors, so output arrays need `SET_KERNEL_PADDING` spare elements at the end.
+ *
+ * @date 17/10/2026
+ */
+#ifndef SetKernels_h
+#define SetKernels_h
+
+#define SET_KERNEL_PADDING 8 /**< Spare elements the output array of a kernel needs past the largest possible result. */
+
+/**
+ * @enum KernelLevel
+ * @brief The instruction sets the set kernels can use, from slowest to fastest.
+ */
+typedef enum {
+    KERNEL_SCALAR, /* 0 */ /**< Plain C merge, available everywhere. */
+    KERNEL_SSE, /* 1 */ /**< 4 elements per step, needs SSSE3. */
+    KERNEL_AVX2 /* 2 */ /**< 8 elements per step, needs AVX2. */
+} KernelLevel;
+
+KernelLevel getKernelLevel();
+void limitKernelLevel(KernelLevel level);
+int intersectSortedArrays(const int *a, int countA, const int *b, int countB, int *out);
+int differenceSortedArrays(const int *a, int countA, const int *b, int countB, int *out);
+#endif
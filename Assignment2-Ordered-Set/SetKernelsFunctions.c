@@ -0,0 +1,545 @@
+/**
+ * @file SetKernelsFunctions.c
+ *
+ * @brief Implementation of the SIMD kernels that intersect and subtract sorted integer arrays.
+ *
+ * @details This file provides the implementation for:
+ *   - Detecting at runtime which instruction sets the processor supports.
+ *   - Scalar, SSE (4 wide) and AVX2 (8 wide) kernels for intersection and difference.
+ *   - Dispatching every call to the fastest kernel available.
+ *
+ * @date 17/10/2026
+*/
+
+#include "SetKernels.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SET_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SSE_TARGET
+#define AVX2_TARGET
+#else
+#include <cpuid.h>
+#define SSE_TARGET __attribute__((target("ssse3")))// GCC and Clang only emit these instructions when asked to
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+static KernelLevel detected = KERNEL_SCALAR;// Fastest level the processor supports, set once by detectOnce
+#ifdef _WIN32
+static INIT_ONCE detection = INIT_ONCE_STATIC_INIT;// Runs the detection once, whichever thread gets there first
+#else
+static pthread_once_t detection = PTHREAD_ONCE_INIT;
+#endif
+static KernelLevel limit = KERNEL_AVX2;// Fastest level callers allow
+
+#ifdef SET_KERNELS_X86
+static unsigned char packLanes4[16][16];// pshufb masks moving the selected lanes of 4 to the front
+static int packLanes8[256][8];// vpermd indices moving the selected lanes of 8 to the front
+static unsigned char laneCount[256];// Number of bits set in each mask
+
+/**
+ * @brief Runs the `cpuid` instruction.
+ *
+ * @param info Receives EAX, EBX, ECX and EDX.
+ * @param leaf The leaf to query.
+ * @param subleaf The subleaf to query.
+*/
+static void queryCpu(int info[4], int leaf, int subleaf) {
+#if defined(_MSC_VER)
+    __cpuidex(info, leaf, subleaf);
+#else
+    unsigned int regs[4] = {0, 0, 0, 0};
+
+    if (__get_cpuid_max(0, NULL) >= (unsigned int) leaf) {
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    }
+    for (int i = 0; i < 4; i++) {
+        info[i] = (int) regs[i];
+    }
+#endif
+}
+
+/**
+ * @brief Reads the lower half of the XCR0 register, which tells which register states the operating system saves.
+ *
+ * @return The lower 32 bits of XCR0.
+*/
+static unsigned int readXcr0() {
+#if defined(_MSC_VER)
+    return (unsigned int) _xgetbv(0);
+#else
+    unsigned int lo, hi;
+
+    __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return lo;
+#endif
+}
+
+/**
+ * @brief Fills the shuffle tables the kernels use to pack the selected lanes of a vector.
+ *
+ * ***Pseudocode:***
+ * 1. For every mask of 8 lanes:
+ *      - Count its bits
+ *      - List the selected lanes first, in order, then pad with lane 0
+ *      - For masks of 4 lanes, spell the same lanes out byte by byte
+*/
+static void buildPackTables() {
+    for (int mask = 0; mask < 256; mask++) {
+        int n = 0;
+
+        for (int lane = 0; lane < 8; lane++) {
+            if (mask & (1 << lane)) {
+                packLanes8[mask][n++] = lane;
+            }
+        }
+        laneCount[mask] = (unsigned char) n;
+        for (int i = n; i < 8; i++) {
+            packLanes8[mask][i] = 0;
+        }
+        if (mask < 16) {
+            for (int i = 0; i < 16; i++) {
+                packLanes4[mask][i] = (unsigned char) (packLanes8[mask][i / 4] * 4 + i % 4);
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Finds the fastest kernel level the processor and operating system support.
+ *
+ * @details
+ * - SSE needs SSSE3 for `pshufb`. AVX2 also needs the operating system to save the YMM registers, which `xgetbv`
+ *   reports.
+ *
+ * @return The supported `KernelLevel`.
+*/
+static KernelLevel detectKernelLevel() {
+    KernelLevel level = KERNEL_SCALAR;
+#ifdef SET_KERNELS_X86
+    int info[4];
+
+    buildPackTables();
+    queryCpu(info, 1, 0);
+    if (info[2] & (1 << 9)) {
+        level = KERNEL_SSE;// SSSE3
+    }
+    // AVX needs OSXSAVE and the OS saving the XMM and YMM state before AVX2 may be used
+    if ((info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (readXcr0() & 6) == 6) {
+        queryCpu(info, 7, 0);
+        if (info[1] & (1 << 5)) {
+            level = KERNEL_AVX2;
+        }
+    }
+#endif
+    return level;
+}
+
+/**
+ * @brief Detects the kernel level and fills the tables, called exactly once through `detection`.
+*/
+#ifdef _WIN32
+static BOOL CALLBACK detectOnce(PINIT_ONCE once, PVOID parameter, PVOID *context) {
+    (void) once;
+    (void) parameter;
+    (void) context;
+    detected = detectKernelLevel();
+    return TRUE;
+}
+#else
+static void detectOnce() {
+    detected = detectKernelLevel();
+}
+#endif
+
+/**
+ * @brief Returns the kernel level intersections and differences currently use.
+ *
+ * @pre None.
+ * @post The processor is queried on the first call.
+ *
+ * @details
+ * - Safe to call from several threads at once: the first call detects the level and builds the shuffle tables,
+ *   and the others wait for it to finish.
+ *
+ * @return The fastest level the processor supports, capped by `limitKernelLevel()`.
+*/
+KernelLevel getKernelLevel() {
+#ifdef _WIN32
+    InitOnceExecuteOnce(&detection, detectOnce, NULL, NULL);
+#else
+    pthread_once(&detection, detectOnce);
+#endif
+
+    return limit < detected ? limit : detected;
+}
+
+/**
+ * @brief Caps the kernel level used from now on, for example to compare the kernels against each other.
+ *
+ * @pre No other thread is running a set operation.
+ * @post Kernels faster than `level` are no longer used; levels the processor lacks are still skipped.
+ *
+ * @param level The fastest `KernelLevel` to allow.
+*/
+void limitKernelLevel(KernelLevel level) {
+    limit = level;
+}
+
+/**
+ * @brief Intersects the remaining elements of two sorted arrays one element at a time.
+ *
+ * @param a The first array.
+ * @param i Position in `a` to start at.
+ * @param countA Number of elements in `a`.
+ * @param b The second array.
+ * @param j Position in `b` to start at.
+ * @param countB Number of elements in `b`.
+ * @param out Receives the common elements.
+ * @param count Number of elements already in `out`.
+ *
+ * @return The number of elements in `out`.
+*/
+static int intersectScalar(const int *a, int i, int countA, const int *b, int j, int countB, int *out, int count) {
+    while (i < countA && j < countB) {
+        if (a[i] < b[j]) {
+            i++;
+        }
+        else if (b[j] < a[i]) {
+            j++;
+        }
+        else {
+            out[count++] = a[i];
+            i++;
+            j++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Subtracts the remaining elements of one sorted array from another one element at a time.
+ *
+ * @param a The array to subtract from.
+ * @param i Position in `a` to start at.
+ * @param countA Number of elements in `a`.
+ * @param b The array to subtract.
+ * @param j Position in `b` to start at.
+ * @param countB Number of elements in `b`.
+ * @param out Receives the elements only in `a`.
+ * @param count Number of elements already in `out`.
+ *
+ * @return The number of elements in `out`.
+*/
+static int differenceScalar(const int *a, int i, int countA, const int *b, int j, int countB, int *out, int count) {
+    while (i < countA) {
+        if (j == countB || a[i] < b[j]) {
+            out[count++] = a[i++];
+        }
+        else if (b[j] < a[i]) {
+            j++;
+        }
+        else {
+            i++;
+            j++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Finishes a block of `a` that has been compared with the blocks of `b` before `j` only.
+ *
+ * @details
+ * - Lanes in `matched` were found in earlier blocks; every other lane is looked up in the rest of `b`.
+ *
+ * @param block The block of elements of `a`.
+ * @param lanes Number of elements in the block.
+ * @param matched Bit mask of the lanes already found in `b`.
+ * @param b The array to subtract.
+ * @param j Position in `b` the lookups start at; advanced past the elements looked at.
+ * @param countB Number of elements in `b`.
+ * @param out Receives the elements only in `a`.
+ * @param count Number of elements already in `out`.
+ *
+ * @return The number of elements in `out`.
+*/
+static int finishBlock(const int *block, int lanes, int matched, const int *b, int *j, int countB, int *out, int count) {
+    for (int lane = 0; lane < lanes; lane++) {
+        if (!(matched & (1 << lane))) {
+            while (*j < countB && b[*j] < block[lane]) {
+                (*j)++;
+            }
+            if (*j == countB || b[*j] != block[lane]) {
+                out[count++] = block[lane];
+            }
+        }
+    }
+
+    return count;
+}
+
+#ifdef SET_KERNELS_X86
+/**
+ * @brief Compares a block of 4 elements with every lane of another block of 4.
+ *
+ * @param va The block whose lanes are tested.
+ * @param vb The block to look in.
+ *
+ * @return A 4 bit mask of the lanes of `va` found in `vb`.
+*/
+SSE_TARGET static int matchBlock4(__m128i va, __m128i vb) {
+    // Rotating vb three times lines every lane of va up with every lane of vb
+    __m128i eq0 = _mm_cmpeq_epi32(va, vb);
+    __m128i eq1 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)));
+    __m128i eq2 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2)));
+    __m128i eq3 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)));
+
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(_mm_or_si128(eq0, eq1), _mm_or_si128(eq2, eq3))));
+}
+
+/**
+ * @brief Intersects two sorted arrays 4 elements at a time with SSE.
+ *
+ * ***Pseudocode:***
+ * 1. While both arrays have a full block of 4 left:
+ *      - Compare the block of `a` with every rotation of the block of `b`
+ *      - Pack the matching lanes of `a` to the front and store all 4 lanes, counting only the matches
+ *      - Advance the block (or both) whose largest element is smaller
+ * 2. Intersect what is left one element at a time
+*/
+SSE_TARGET static int intersectSse(const int *a, int countA, const int *b, int countB, int *out) {
+    int i = 0;
+    int j = 0;
+    int count = 0;
+    int blocksA = countA & ~3;
+    int blocksB = countB & ~3;
+
+    while (i < blocksA && j < blocksB) {
+        __m128i va = _mm_loadu_si128((const __m128i *) (a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *) (b + j));
+        int mask = matchBlock4(va, vb);
+        int maxA = a[i + 3];
+        int maxB = b[j + 3];
+
+        _mm_storeu_si128((__m128i *) (out + count), _mm_shuffle_epi8(va, _mm_loadu_si128((const __m128i *) packLanes4[mask])));
+        count += laneCount[mask];
+        i += (maxA <= maxB) * 4;// no branch to mispredict
+        j += (maxB <= maxA) * 4;
+    }
+
+    return intersectScalar(a, i, countA, b, j, countB, out, count);
+}
+
+/**
+ * @brief Subtracts one sorted array from another 4 elements at a time with SSE.
+ *
+ * ***Pseudocode:***
+ * 1. While both arrays have a full block of 4 left:
+ *      - Add the lanes of the block of `a` found in the block of `b` to `matched`
+ *      - If the block of `a` ends first, store its unmatched lanes packed to the front, clear `matched`, advance it
+ *      - If the block of `b` ends first, advance it
+ * 2. If a block of `a` is half done, look its unmatched lanes up in the rest of `b`
+ * 3. Subtract what is left one element at a time
+*/
+SSE_TARGET static int differenceSse(const int *a, int countA, const int *b, int countB, int *out) {
+    int i = 0;
+    int j = 0;
+    int count = 0;
+    int matched = 0;
+    int blocksA = countA & ~3;
+    int blocksB = countB & ~3;
+
+    while (i < blocksA && j < blocksB) {
+        __m128i va = _mm_loadu_si128((const __m128i *) (a + i));
+        int maxA = a[i + 3];
+        int maxB = b[j + 3];
+
+        matched |= matchBlock4(va, _mm_loadu_si128((const __m128i *) (b + j)));
+        if (maxA <= maxB) {
+            int keep = ~matched & 0xF;
+
+            _mm_storeu_si128((__m128i *) (out + count), _mm_shuffle_epi8(va, _mm_loadu_si128((const __m128i *) packLanes4[keep])));
+            count += laneCount[keep];
+            matched = 0;
+            i += 4;
+        }
+        if (maxB <= maxA) {
+            j += 4;
+        }
+    }
+    if (i < blocksA) {
+        count = finishBlock(a + i, 4, matched, b, &j, countB, out, count);
+        i += 4;
+    }
+
+    return differenceScalar(a, i, countA, b, j, countB, out, count);
+}
+
+/**
+ * @brief Compares a block of 8 elements with every lane of another block of 8.
+ *
+ * @param va The block whose lanes are tested.
+ * @param vb The block to look in.
+ *
+ * @return An 8 bit mask of the lanes of `va` found in `vb`.
+*/
+AVX2_TARGET static int matchBlock8(__m256i va, __m256i vb) {
+    __m256i step = _mm256_set1_epi32(1);
+    __m256i rotation = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i seven = _mm256_set1_epi32(7);
+    __m256i eq = _mm256_cmpeq_epi32(va, vb);
+
+    // Seven rotations of vb line every lane of va up with every lane of vb
+    for (int r = 1; r < 8; r++) {
+        rotation = _mm256_and_si256(_mm256_add_epi32(rotation, step), seven);
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotation)));
+    }
+
+    return _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+}
+
+/**
+ * @brief Intersects two sorted arrays 8 elements at a time with AVX2.
+ *
+ * @details
+ * - The same algorithm as `intersectSse()` with blocks of 8.
+*/
+AVX2_TARGET static int intersectAvx2(const int *a, int countA, const int *b, int countB, int *out) {
+    int i = 0;
+    int j = 0;
+    int count = 0;
+    int blocksA = countA & ~7;
+    int blocksB = countB & ~7;
+
+    while (i < blocksA && j < blocksB) {
+        __m256i va = _mm256_loadu_si256((const __m256i *) (a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *) (b + j));
+        int mask = matchBlock8(va, vb);
+        int maxA = a[i + 7];
+        int maxB = b[j + 7];
+
+        _mm256_storeu_si256((__m256i *) (out + count), _mm256_permutevar8x32_epi32(va, _mm256_loadu_si256((const __m256i *) packLanes8[mask])));
+        count += laneCount[mask];
+        i += (maxA <= maxB) * 8;
+        j += (maxB <= maxA) * 8;
+    }
+
+    return intersectScalar(a, i, countA, b, j, countB, out, count);
+}
+
+/**
+ * @brief Subtracts one sorted array from another 8 elements at a time with AVX2.
+ *
+ * @details
+ * - The same algorithm as `differenceSse()` with blocks of 8.
+*/
+AVX2_TARGET static int differenceAvx2(const int *a, int countA, const int *b, int countB, int *out) {
+    int i = 0;
+    int j = 0;
+    int count = 0;
+    int matched = 0;
+    int blocksA = countA & ~7;
+    int blocksB = countB & ~7;
+
+    while (i < blocksA && j < blocksB) {
+        __m256i va = _mm256_loadu_si256((const __m256i *) (a + i));
+        int maxA = a[i + 7];
+        int maxB = b[j + 7];
+
+        matched |= matchBlock8(va, _mm256_loadu_si256((const __m256i *) (b + j)));
+        if (maxA <= maxB) {
+            int keep = ~matched & 0xFF;
+
+            _mm256_storeu_si256((__m256i *) (out + count), _mm256_permutevar8x32_epi32(va, _mm256_loadu_si256((const __m256i *) packLanes8[keep])));
+            count += laneCount[keep];
+            matched = 0;
+            i += 8;
+        }
+        if (maxB <= maxA) {
+            j += 8;
+        }
+    }
+    if (i < blocksA) {
+        count = finishBlock(a + i, 8, matched, b, &j, countB, out, count);
+        i += 8;
+    }
+
+    return differenceScalar(a, i, countA, b, j, countB, out, count);
+}
+#endif
+
+/**
+ * @brief Computes the elements two sorted arrays have in common.
+ *
+ * @pre Both arrays hold distinct elements in ascending order; `out` has room for the smaller count plus
+ *      `SET_KERNEL_PADDING` elements and does not overlap either input.
+ * @post `out` holds the common elements in ascending order; the elements after them are unspecified.
+ *
+ * @param a The first array.
+ * @param countA Number of elements in `a`.
+ * @param b The second array.
+ * @param countB Number of elements in `b`.
+ * @param out Receives the common elements.
+ *
+ * @return The number of elements written to `out`.
+*/
+int intersectSortedArrays(const int *a, int countA, const int *b, int countB, int *out) {
+#ifdef SET_KERNELS_X86
+    switch (getKernelLevel()) {
+        case KERNEL_AVX2:
+            return intersectAvx2(a, countA, b, countB, out);
+        case KERNEL_SSE:
+            return intersectSse(a, countA, b, countB, out);
+        default:
+            break;
+    }
+#endif
+    return intersectScalar(a, 0, countA, b, 0, countB, out, 0);
+}
+
+/**
+ * @brief Computes the elements of one sorted array that are not in another.
+ *
+ * @pre Both arrays hold distinct elements in ascending order; `out` has room for `countA` plus
+ *      `SET_KERNEL_PADDING` elements and does not overlap either input.
+ * @post `out` holds the elements of `a` missing from `b` in ascending order; the elements after them are
+ *       unspecified.
+ *
+ * @param a The array to subtract from.
+ * @param countA Number of elements in `a`.
+ * @param b The array to subtract.
+ * @param countB Number of elements in `b`.
+ * @param out Receives the elements only in `a`.
+ *
+ * @return The number of elements written to `out`.
+*/
+int differenceSortedArrays(const int *a, int countA, const int *b, int countB, int *out) {
+#ifdef SET_KERNELS_X86
+    switch (getKernelLevel()) {
+        case KERNEL_AVX2:
+            return differenceAvx2(a, countA, b, countB, out);
+        case KERNEL_SSE:
+            return differenceSse(a, countA, b, countB, out);
+        default:
+            break;
+    }
+#endif
+    return differenceScalar(a, 0, countA, b, 0, countB, out, 0);
+}
+
+// 
+
+// END OF SETKERNELSFUNCTIONS.C
\ No newline at end of file
@@ -0,0 +1,52 @@
+/**
+ * @file SetScript.h
+ *
+ * @brief Header file for defining the set registry of the test program and the scripts that drive it.
+ *
+ * @details
+ * A `SetRegistry` holds the sets of the test program by index. It grows as higher indices are used, up to
+ * `SET_REGISTRY_LIMIT` sets, and deletes the sets it holds when they are replaced or the registry is cleared.
+ *
+ * A set script runs commands on a registry without any prompts, one command per line. Words are separated by
+ * spaces or tabs, `#` starts a comment, and `<i>`, `<a>` and `<b>` are registry indices:
+ * - `create <i> [list|indexed|array|bitmap]` creates an empty set; `<i>` must be free.
+ * - `free <i>` deletes a set.
+ * - `add <i> <elem>...` and `remove <i> <elem>...` add or remove elements.
+ * - `add-range <i> <first> <last>` and `remove-range <i> <first> <last>` add or remove every element from
+ *   `<first>` to `<last>`.
+ * - `load <i> <file> [list|indexed|array|bitmap]` loads a set file, `map <i> <file>` maps one read-only and
+ *   `save <i> <file> [raw|delta]` saves a set, see `SetFile.h`.
+ * - `union <i> <a> <b>...`, `intersect <i> <a> <b>...` and `diff <i> <a> <b>` store the result of a set
+ *   operation; a union or intersection takes any number of sets.
+ * - `dump <i> [braces|lines|csv|json]` writes a set to the output, see `SetFormat.h`.
+ * - `size <i>` writes the number of elements of a set to the output, and `count <i> <first> <last>` the number
+ *   of its elements from `<first>` to `<last>`.
+ * - `rank <i> <elem>` writes the number of elements smaller than `<elem>`, and `select <i> <position>` the element
+ *   with `<position>` smaller elements (0 for the smallest).
+ *
+ * Loads, maps and set operations replace the set at `<i>`. The script stops at the first command that fails.
+ *
+ * @date 17/10/2026
+ */
+#ifndef SetScript_h
+#define SetScript_h
+#include <stdio.h>
+#include "OrderedList.h"
+
+#define SET_REGISTRY_LIMIT 1048576 /**< Number of sets a registry holds at most; indices go up to one less. */
+
+/**
+ * @struct SetRegistry
+ * @brief The sets of the test program, by index.
+ */
+typedef struct {
+    orderedIntSet **sets; /**< The sets, NULL where no set is stored. */
+    int capacity; /**< Number of indices `sets` has room for. */
+} SetRegistry;
+
+void initSetRegistry(SetRegistry* registry);
+void clearSetRegistry(SetRegistry* registry);
+orderedIntSet* getRegisteredSet(const SetRegistry* registry, int index);
+int putRegisteredSet(SetRegistry* registry, int index, orderedIntSet* s);
+int runSetScript(SetRegistry* registry, FILE* script, FILE* out);
+#endif
@@ -0,0 +1,764 @@
+/**
+ * @file SetScriptFunctions.c
+ *
+ * @brief Implementation of the set registry of the test program and of the set scripts that drive it.
+ *
+ * @details This file provides the implementation for:
+ *   - Storing sets by index in a registry that grows as higher indices are used.
+ *   - Reading a script of any length line by line, splitting each line into words and running the command.
+ *
+ * @date 17/10/2026
+*/
+
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include "SetScript.h"
+#include "SetFile.h"
+#include "SetFormat.h"
+
+#define SET_REGISTRY_INITIAL 16 // Indices a registry has room for once the first set is stored
+#define SET_SCRIPT_LINE 256 // Initial size of the line buffer, doubled for longer lines
+#define SET_SCRIPT_WORDS 16 // Initial number of words per line, doubled for longer lines
+
+/**
+ * @struct ScriptCommand
+ * @brief One line of a script split into words, and what its command runs on.
+ */
+typedef struct {
+    SetRegistry *registry; /**< The registry the command works on. */
+    FILE *out; /**< Where `dump` and `size` write to. */
+    char **words; /**< The words of the line, the command first. */
+    int count; /**< Number of words. */
+} ScriptCommand;
+
+/**
+ * @brief Runs a command.
+ *
+ * @return NULL on success, or a message telling why the command failed.
+ */
+typedef const char *(*CommandHandler)(ScriptCommand *command);
+
+/**
+ * @struct ScriptEntry
+ * @brief A command a script can use.
+ */
+typedef struct {
+    const char *name; /**< The first word of the command. */
+    int minWords; /**< Number of words the command takes at least, itself included. */
+    int maxWords; /**< Number of words the command takes at most, -1 for any number. */
+    CommandHandler run; /**< Runs the command. */
+} ScriptEntry;
+
+/**
+ * @brief Starts an empty registry.
+ *
+ * @pre None.
+ * @post The registry holds no sets and has no storage.
+ *
+ * @param registry The `SetRegistry` to start.
+*/
+void initSetRegistry(SetRegistry *registry) {
+    registry->sets = NULL;
+    registry->capacity = 0;
+}
+
+/**
+ * @brief Deletes every set in a registry and its storage.
+ *
+ * @pre `registry` was started with `initSetRegistry()`.
+ * @post The registry is empty and can be used again.
+ *
+ * @param registry The `SetRegistry` to clear.
+*/
+void clearSetRegistry(SetRegistry *registry) {
+    for (int i = 0; i < registry->capacity; i++) {
+        if (registry->sets[i] != NULL) {
+            deleteOrderedSet(registry->sets[i]);
+        }
+    }
+    free(registry->sets);
+    initSetRegistry(registry);
+}
+
+/**
+ * @brief Gets the set stored at an index.
+ *
+ * @param registry The `SetRegistry`.
+ * @param index The index, any value.
+ *
+ * @return A pointer to the `orderedIntSet`, or NULL if no set is stored at `index`.
+*/
+orderedIntSet *getRegisteredSet(const SetRegistry *registry, int index) {
+    if (index < 0 || index >= registry->capacity) {
+        return NULL;
+    }
+
+    return registry->sets[index];
+}
+
+/**
+ * @brief Stores a set at an index, deleting the set stored there before.
+ *
+ * @pre `s` is not stored at any other index.
+ * @post The registry owns `s`; on failure `s` is deleted.
+ *
+ * @details
+ * - The registry doubles its storage until `index` fits, so storing sets at indices 0 to n costs O(n) in total.
+ * - Storing NULL deletes the set at `index`, which is how a set is freed.
+ *
+ * ***Pseudocode:***
+ * 1. If `index` is not below `SET_REGISTRY_LIMIT`, delete `s` and return 0
+ * 2. If `index` does not fit the storage:
+ *      - If `s` is NULL, there is nothing to delete; return 1
+ *      - Double the storage until `index` fits, clearing the new indices; if this fails, delete `s` and return 0
+ * 3. Delete the set stored at `index`, if it is not `s`
+ * 4. Store `s` at `index` and return 1
+ *
+ * @param registry The `SetRegistry`.
+ * @param index The index, from 0 to `SET_REGISTRY_LIMIT` - 1.
+ * @param s A pointer to the `orderedIntSet` to store, or NULL.
+ *
+ * @return 1 on success, 0 if `index` is out of range or memory could not be allocated.
+*/
+int putRegisteredSet(SetRegistry *registry, int index, orderedIntSet *s) {
+    if (index < 0 || index >= SET_REGISTRY_LIMIT) {
+        if (s != NULL) {
+            deleteOrderedSet(s);
+        }
+        return 0;
+    }
+
+    if (index >= registry->capacity) {
+        if (s == NULL) {
+            return 1;// Nothing is stored that far out
+        }
+
+        int capacity = registry->capacity > 0 ? registry->capacity : SET_REGISTRY_INITIAL;
+        while (capacity <= index) {
+            capacity = capacity < SET_REGISTRY_LIMIT / 2 ? capacity * 2 : SET_REGISTRY_LIMIT;
+        }
+        orderedIntSet **sets = (orderedIntSet **) realloc(registry->sets, capacity * sizeof(orderedIntSet *));
+        if (sets == NULL) {
+            deleteOrderedSet(s);
+            return 0;
+        }
+        memset(sets + registry->capacity, 0, (capacity - registry->capacity) * sizeof(orderedIntSet *));
+        registry->sets = sets;
+        registry->capacity = capacity;
+    }
+
+    if (registry->sets[index] != NULL && registry->sets[index] != s) {
+        deleteOrderedSet(registry->sets[index]);
+    }
+    registry->sets[index] = s;
+
+    return 1;
+}
+
+/**
+ * @brief Reads a whole decimal integer.
+ *
+ * @return 1 if `word` is an integer that fits an int, 0 otherwise.
+*/
+static int parseInt(const char *word, int *value) {
+    char *end;
+
+    errno = 0;
+    long long parsed = strtoll(word, &end, 10);
+    if (end == word || *end != '\0' || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX) {
+        return 0;
+    }
+    *value = (int) parsed;
+
+    return 1;
+}
+
+/**
+ * @brief Reads a registry index.
+ *
+ * @return 1 if `word` is an integer from 0 to `SET_REGISTRY_LIMIT` - 1, 0 otherwise.
+*/
+static int parseIndex(const char *word, int *index) {
+    return parseInt(word, index) && *index >= 0 && *index < SET_REGISTRY_LIMIT;
+}
+
+/**
+ * @brief Reads the name of a backend: `list`, `indexed`, `array` or `bitmap`.
+ *
+ * @param word The name.
+ * @param backend Receives the `SetBackend`.
+ * @param indexed Receives 1 for `indexed`, a list with a skip list index, 0 otherwise.
+ *
+ * @return 1 if `word` names a backend, 0 otherwise.
+*/
+static int parseBackend(const char *word, SetBackend *backend, int *indexed) {
+    *indexed = strcmp(word, "indexed") == 0;
+    if (strcmp(word, "list") == 0 || *indexed) {
+        *backend = SET_BACKEND_LIST;
+    }
+    else if (strcmp(word, "array") == 0) {
+        *backend = SET_BACKEND_ARRAY;
+    }
+    else if (strcmp(word, "bitmap") == 0) {
+        *backend = SET_BACKEND_BITMAP;
+    }
+    else {
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Gets the set at the index in a word of a command.
+ *
+ * @param command The `ScriptCommand`.
+ * @param word Which word holds the index.
+ * @param s Receives a pointer to the `orderedIntSet`.
+ *
+ * @return NULL on success, or a message telling why there is no set.
+*/
+static const char *findSet(ScriptCommand *command, int word, orderedIntSet **s) {
+    int index;
+
+    if (!parseIndex(command->words[word], &index)) {
+        return "invalid index";
+    }
+    *s = getRegisteredSet(command->registry, index);
+
+    return *s == NULL ? "no set exists at that index" : NULL;
+}
+
+/**
+ * @brief Tells why a set file could not be used.
+*/
+static const char *fileStatusMessage(SetFileStatus status) {
+    switch (status) {
+    case SET_FILE_IO_ERROR:
+        return "the file could not be opened, read or written";
+    case SET_FILE_BAD_FORMAT:
+        return "the file is not a valid set file";
+    case SET_FILE_BAD_CHECKSUM:
+        return "the file is damaged, its checksum does not match";
+    case SET_FILE_NOT_MAPPABLE:
+        return "only raw set files can be mapped";
+    case SET_FILE_NO_MEMORY:
+        return "out of memory";
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * @brief Stores the result of a command at the index in its second word.
+ *
+ * @return NULL on success, or a message telling why it could not be stored.
+*/
+static const char *storeResult(ScriptCommand *command, orderedIntSet *s) {
+    int index;
+
+    if (s == NULL) {
+        return "out of memory";
+    }
+    parseIndex(command->words[1], &index);// Checked by the command
+
+    return putRegisteredSet(command->registry, index, s) ? NULL : "out of memory";
+}
+
+/**
+ * @brief `create <i> [list|indexed|array|bitmap]`
+*/
+static const char *runCreate(ScriptCommand *command) {
+    SetBackend backend = SET_BACKEND_LIST;
+    int indexed = 0;
+    int index;
+
+    if (!parseIndex(command->words[1], &index)) {
+        return "invalid index";
+    }
+    if (getRegisteredSet(command->registry, index) != NULL) {
+        return "a set already exists at that index, free it first";
+    }
+    if (command->count > 2 && !parseBackend(command->words[2], &backend, &indexed)) {
+        return "unknown backend";
+    }
+
+    return storeResult(command, indexed ? createIndexedOrderedSet() : createOrderedSetWithBackend(backend));
+}
+
+/**
+ * @brief `free <i>`
+*/
+static const char *runFree(ScriptCommand *command) {
+    orderedIntSet *s;
+    const char *error = findSet(command, 1, &s);
+
+    if (error == NULL) {
+        int index;
+        parseIndex(command->words[1], &index);
+        putRegisteredSet(command->registry, index, NULL);
+    }
+
+    return error;
+}
+
+/**
+ * @brief Tells why adding or removing an element failed, or NULL if it did not.
+*/
+static const char *elementMessage(ReturnValues result) {
+    if (result == ALLOCATION_ERROR) {
+        return "out of memory";
+    }
+    if (result == SET_IS_READ_ONLY) {
+        return "the set is read-only";
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief `add <i> <elem>...` and `remove <i> <elem>...`
+ *
+ * @details
+ * - Elements already in the set, or not in it, are not errors, so a script can be run more than once.
+*/
+static const char *runAddOrRemove(ScriptCommand *command) {
+    int add = strcmp(command->words[0], "add") == 0;
+    orderedIntSet *s;
+    const char *error = findSet(command, 1, &s);
+
+    for (int i = 2; i < command->count && error == NULL; i++) {
+        int elem;
+        if (!parseInt(command->words[i], &elem)) {
+            return "invalid element";
+        }
+        error = elementMessage(add ? addElement(s, elem) : removeElement(s, elem));
+    }
+
+    return error;
+}
+
+/**
+ * @brief Reads the `<first> <last>` range of a command.
+ *
+ * @return NULL if both were read, otherwise what is wrong with them.
+*/
+static const char *parseRange(ScriptCommand *command, int *first, int *last) {
+    if (!parseInt(command->words[2], first) || !parseInt(command->words[3], last)) {
+        return "invalid element";
+    }
+    if (*first > *last) {
+        return "the first element is larger than the last";
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief `add-range <i> <first> <last>` and `remove-range <i> <first> <last>`
+*/
+static const char *runAddOrRemoveRange(ScriptCommand *command) {
+    int add = strcmp(command->words[0], "add-range") == 0;
+    orderedIntSet *s;
+    const char *error = findSet(command, 1, &s);
+    int first, last;
+
+    if (error == NULL) {
+        error = parseRange(command, &first, &last);
+    }
+    if (error == NULL) {
+        error = elementMessage(add ? addRange(s, first, last) : removeRange(s, first, last));
+    }
+
+    return error;
+}
+
+/**
+ * @brief `count <i> <first> <last>`
+*/
+static const char *runCount(ScriptCommand *command) {
+    orderedIntSet *s;
+    const char *error = findSet(command, 1, &s);
+    int first, last;
+
+    if (error == NULL) {
+        error = parseRange(command, &first, &last);
+    }
+    if (error == NULL && fprintf(command->out, "%d\n", countInRange(s, first, last)) < 0) {
+        error = "writing the output failed";
+    }
+
+    return error;
+}
+
+/**
+ * @brief `rank <i> <elem>`
+*/
+static const char *runRank(ScriptCommand *command) {
+    orderedIntSet *s;
+    const char *error = findSet(command, 1, &s);
+    int elem;
+
+    if (error != NULL) {
+        return error;
+    }
+    if (!parseInt(command->words[2], &elem)) {
+        return "invalid element";
+    }
+
+    return fprintf(command->out, "%d\n", rankElement(s, elem)) < 0 ? "writing the output failed" : NULL;
+}
+
+/**
+ * @brief `select <i> <position>`
+*/
+static const char *runSelect(ScriptCommand *command) {
+    orderedIntSet *s;
+    const char *error = findSet(command, 1, &s);
+    int position, elem;
+
+    if (error != NULL) {
+        return error;
+    }
+    if (!parseInt(command->words[2], &position)) {
+        return "invalid position";
+    }
+    if (!selectElement(s, position, &elem)) {
+        return "the position is not in the set";
+    }
+
+    return fprintf(command->out, "%d\n", elem) < 0 ? "writing the output failed" : NULL;
+}
+
+/**
+ * @brief `load <i> <file> [list|indexed|array|bitmap]`
+*/
+static const char *runLoad(ScriptCommand *command) {
+    SetBackend backend = SET_BACKEND_LIST;
+    SetFileStatus status;
+    int indexed = 0;
+    int index;
+
+    if (!parseIndex(command->words[1], &index)) {
+        return "invalid index";
+    }
+    if (command->count > 3 && !parseBackend(command->words[3], &backend, &indexed)) {
+        return "unknown backend";
+    }
+
+    orderedIntSet *s = loadOrderedSet(command->words[2], backend, &status);
+    if (s == NULL) {
+        return fileStatusMessage(status);
+    }
+    if (indexed && !enableSetIndex(s)) {
+        deleteOrderedSet(s);
+        return "out of memory";
+    }
+
+    return storeResult(command, s);
+}
+
+/**
+ * @brief `map <i> <file>`
+*/
+static const char *runMap(ScriptCommand *command) {
+    SetFileStatus status;
+    int index;
+
+    if (!parseIndex(command->words[1], &index)) {
+        return "invalid index";
+    }
+
+    orderedIntSet *s = mapOrderedSet(command->words[2], 1, &status);
+
+    return s == NULL ? fileStatusMessage(status) : storeResult(command, s);
+}
+
+/**
+ * @brief `save <i> <file> [raw|delta]`
+*/
+static const char *runSave(ScriptCommand *command) {
+    SetFileEncoding encoding = SET_FILE_RAW;
+    orderedIntSet *s;
+    const char *error = findSet(command, 1, &s);
+
+    if (error != NULL) {
+        return error;
+    }
+    if (command->count > 3) {
+        if (strcmp(command->words[3], "delta") == 0) {
+            encoding = SET_FILE_DELTA;
+        }
+        else if (strcmp(command->words[3], "raw") != 0) {
+            return "unknown encoding";
+        }
+    }
+
+    return fileStatusMessage(saveOrderedSet(s, command->words[2], encoding));
+}
+
+/**
+ * @brief `union <i> <a> <b>...`, `intersect <i> <a> <b>...` and `diff <i> <a> <b>`
+ *
+ * @details
+ * - The result is computed before it replaces the set at `<i>`, so `<i>` may be one of the operands.
+ * - A union or intersection of more than two sets is computed in one pass, see `setUnionMany()` and
+ *   `setIntersectionMany()`.
+*/
+static const char *runSetOperation(ScriptCommand *command) {
+    orderedIntSet **operands;
+    orderedIntSet *result;
+    const char *error = NULL;
+    int count = command->count - 2;
+    int index;
+
+    if (!parseIndex(command->words[1], &index)) {
+        return "invalid index";
+    }
+    if ((operands = malloc((size_t) count * sizeof(orderedIntSet *))) == NULL) {
+        return "out of memory";
+    }
+    for (int i = 0; i < count && error == NULL; i++) {
+        error = findSet(command, i + 2, &operands[i]);
+    }
+    if (error != NULL) {
+        free(operands);
+        return error;
+    }
+
+    if (strcmp(command->words[0], "union") == 0) {
+        result = count == 2 ? setUnion(operands[0], operands[1]) : setUnionMany(operands, count);
+    }
+    else if (strcmp(command->words[0], "intersect") == 0) {
+        result = count == 2 ? setIntersection(operands[0], operands[1]) : setIntersectionMany(operands, count);
+    }
+    else {
+        result = setDifference(operands[0], operands[1]);
+    }
+    free(operands);
+
+    return storeResult(command, result);
+}
+
+/**
+ * @brief `dump <i> [braces|lines|csv|json]`
+*/
+static const char *runDump(ScriptCommand *command) {
+    static const char *formatNames[] = {"braces", "lines", "csv", "json"};
+    SetFormat format = SET_FORMAT_BRACES;
+    orderedIntSet *s;
+    const char *error = findSet(command, 1, &s);
+
+    if (error != NULL) {
+        return error;
+    }
+    if (command->count > 2) {
+        int found = 0;
+        for (int i = 0; i <= SET_FORMAT_JSON && !found; i++) {
+            if (strcmp(command->words[2], formatNames[i]) == 0) {
+                format = (SetFormat) i;
+                found = 1;
+            }
+        }
+        if (!found) {
+            return "unknown format";
+        }
+    }
+
+    return writeOrderedSet(s, format, command->out) == 0 ? NULL : "writing the output failed";
+}
+
+/**
+ * @brief `size <i>`
+*/
+static const char *runSize(ScriptCommand *command) {
+    orderedIntSet *s;
+    const char *error = findSet(command, 1, &s);
+
+    if (error == NULL && fprintf(command->out, "%d\n", s->size) < 0) {
+        error = "writing the output failed";
+    }
+
+    return error;
+}
+
+static const ScriptEntry scriptCommands[] = {
+    {"create", 2, 3, runCreate},
+    {"free", 2, 2, runFree},
+    {"add", 2, -1, runAddOrRemove},
+    {"remove", 2, -1, runAddOrRemove},
+    {"add-range", 4, 4, runAddOrRemoveRange},
+    {"remove-range", 4, 4, runAddOrRemoveRange},
+    {"load", 3, 4, runLoad},
+    {"map", 3, 3, runMap},
+    {"save", 3, 4, runSave},
+    {"union", 4, -1, runSetOperation},
+    {"intersect", 4, -1, runSetOperation},
+    {"diff", 4, 4, runSetOperation},
+    {"dump", 2, 3, runDump},
+    {"size", 2, 2, runSize},
+    {"count", 4, 4, runCount},
+    {"rank", 3, 3, runRank},
+    {"select", 3, 3, runSelect}
+};
+
+/**
+ * @brief Reads the next line of a script, however long it is.
+ *
+ * @param script The script.
+ * @param line The line buffer, grown as needed; it is NULL or allocated with `malloc()`.
+ * @param capacity Size of `*line`.
+ *
+ * @return 1 if a line was read, 0 at the end of the script, -1 if memory could not be allocated.
+*/
+static int readScriptLine(FILE *script, char **line, size_t *capacity) {
+    size_t length = 0;
+
+    for (;;) {
+        if (*capacity - length < 2) {
+            size_t grown = *capacity > 0 ? *capacity * 2 : SET_SCRIPT_LINE;
+            char *buffer = (char *) realloc(*line, grown);
+            if (buffer == NULL) {
+                return -1;
+            }
+            *line = buffer;
+            *capacity = grown;
+        }
+        if (fgets(*line + length, (int) (*capacity - length), script) == NULL) {
+            return length > 0;// A last line without a newline still counts
+        }
+        length += strlen(*line + length);
+        if (length > 0 && (*line)[length - 1] == '\n') {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief Splits a line into words in place, up to a `#`.
+ *
+ * @param line The line; separators are overwritten with NUL characters.
+ * @param words The word array, grown as needed; it is NULL or allocated with `malloc()`.
+ * @param capacity Number of entries in `*words`.
+ *
+ * @return The number of words, or -1 if memory could not be allocated.
+*/
+static int splitScriptLine(char *line, char ***words, int *capacity) {
+    int count = 0;
+    char *c = line;
+
+    for (;;) {
+        while (*c == ' ' || *c == '\t' || *c == '\r' || *c == '\n') {
+            c++;
+        }
+        if (*c == '\0' || *c == '#') {
+            return count;
+        }
+
+        if (count == *capacity) {
+            int grown = *capacity > 0 ? *capacity * 2 : SET_SCRIPT_WORDS;
+            char **buffer = (char **) realloc(*words, grown * sizeof(char *));
+            if (buffer == NULL) {
+                return -1;
+            }
+            *words = buffer;
+            *capacity = grown;
+        }
+        (*words)[count++] = c;
+
+        while (*c != '\0' && *c != ' ' && *c != '\t' && *c != '\r' && *c != '\n' && *c != '#') {
+            c++;
+        }
+        if (*c == '#') {
+            *c = '\0';// The comment starts right after the word
+            return count;
+        }
+        if (*c != '\0') {
+            *c++ = '\0';
+        }
+    }
+}
+
+/**
+ * @brief Runs a set script on a registry.
+ *
+ * @pre `registry` was started with `initSetRegistry()`; `script` is open for reading and `out` for writing.
+ * @post The commands of the script up to the first failing one have run; the registry keeps its sets.
+ *
+ * @details
+ * - The commands are described in `SetScript.h`. Lines may be of any length and empty lines are skipped.
+ * - The first failing command is reported on `stderr` with its line number, and the script stops there.
+ *
+ * ***Pseudocode:***
+ * 1. For each line of the script:
+ *      - Split it into words; skip it if there are none
+ *      - Find the command named by the first word and check the number of words
+ *      - Run the command; if it fails, report it and stop
+ * 2. Free the line and word buffers
+ * 3. Return 0 if every command succeeded, -1 otherwise
+ *
+ * @param registry The `SetRegistry` the commands work on.
+ * @param script The script to read.
+ * @param out Where `dump` and `size` write to.
+ *
+ * @return 0 on success, -1 if a command failed or the script could not be read.
+*/
+int runSetScript(SetRegistry *registry, FILE *script, FILE *out) {
+    ScriptCommand command = {registry, out, NULL, 0};
+    int wordCapacity = 0;
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    long lineNumber = 0;
+    const char *error = NULL;
+    int read;
+
+    while (error == NULL && (read = readScriptLine(script, &line, &lineCapacity)) != 0) {
+        lineNumber++;
+        if (read < 0 || (command.count = splitScriptLine(line, &command.words, &wordCapacity)) < 0) {
+            command.count = 0;// The words may point into a line that was moved
+            error = "out of memory";
+            break;
+        }
+        if (command.count == 0) {
+            continue;// Empty line or comment
+        }
+
+        const ScriptEntry *entry = NULL;
+        for (size_t i = 0; i < sizeof(scriptCommands) / sizeof(scriptCommands[0]) && entry == NULL; i++) {
+            if (strcmp(command.words[0], scriptCommands[i].name) == 0) {
+                entry = &scriptCommands[i];
+            }
+        }
+
+        if (entry == NULL) {
+            error = "unknown command";
+        }
+        else if (command.count < entry->minWords || (entry->maxWords >= 0 && command.count > entry->maxWords)) {
+            error = "wrong number of arguments";
+        }
+        else {
+            error = entry->run(&command);
+        }
+    }
+
+    if (error != NULL) {
+        fprintf(stderr, "[ERROR] line %ld: %s%s%s\n", lineNumber,
+                command.count > 0 ? command.words[0] : "", command.count > 0 ? ": " : "", error);
+    }
+    else if (ferror(script)) {
+        fprintf(stderr, "[ERROR] The script could not be read.\n");
+        error = "read error";
+    }
+    free(command.words);
+    free(line);
+
+    return error == NULL ? 0 : -1;
+}
+
+// 
+
+// END OF SETSCRIPTFUNCTIONS.C
\ No newline at end of file
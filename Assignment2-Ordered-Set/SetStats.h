@@ -0,0 +1,113 @@
+/**
+ * @file SetStats.h
+ *
+ * @brief Header file for defining the optional counters of list traversal, node allocation and set operations.
+ *
+ * @details
+ * Compiling the library with `ORDERED_SET_STATS` defined (for example in the preprocessor definitions of the
+ * project) makes the hot paths count what they do:
+ * - node hops: every move from a list node to its neighbour, by `gotoNextNode()`, `gotoPreviousNode()`, list
+ *   walks and set cursors;
+ * - comparisons of elements while walking a list or merging two sets;
+ * - node allocations and frees, and the slabs the node pools allocate and free for them.
+ *
+ * `addElement()`, `removeElement()`, `containsElement()`, `setUnion()`, `setIntersection()` and `setDifference()`
+ * also count their calls and the hops and comparisons made inside them; the set operations are timed as well.
+ * `getSetStats()` reads the counters and `resetSetStats()` clears them.
+ *
+ * Without `ORDERED_SET_STATS` the counting macros expand to nothing, so the hot paths are compiled exactly as
+ * before, and `getSetStats()` reports zeros.
+ *
+ * Every thread counts into counters of its own, so threads running counted code at the same time, such as the
+ * workers of the parallel set operations and the readers of the concurrent sets, never write the same counter.
+ * `getSetStats()` adds up the counters of every thread that counted anything, including threads that have ended.
+ * A call is attributed to its operation on the thread that made it: the hops and comparisons of the workers of a
+ * parallel set operation count towards the totals, not towards the operation.
+ *
+ * @date 17/10/2026
+ */
+#ifndef SetStats_h
+#define SetStats_h
+
+/**
+ * @enum SetStatsOperation
+ * @brief The set operations that are counted one by one.
+ */
+typedef enum {
+    STATS_ADD, /* 0 */ /**< `addElement()`. */
+    STATS_REMOVE, /* 1 */ /**< `removeElement()`. */
+    STATS_CONTAINS, /* 2 */ /**< `containsElement()`. */
+    STATS_UNION, /* 3 */ /**< `setUnion()`, timed. */
+    STATS_INTERSECTION, /* 4 */ /**< `setIntersection()`, timed. */
+    STATS_DIFFERENCE, /* 5 */ /**< `setDifference()`, timed. */
+    STATS_OPERATIONS /* 6 */ /**< Number of counted operations. */
+} SetStatsOperation;
+
+/**
+ * @struct SetOperationStats
+ * @brief What the calls of one set operation did.
+ */
+typedef struct {
+    unsigned long long calls; /**< Number of calls. */
+    unsigned long long nodeHops; /**< Node hops made inside the calls. */
+    unsigned long long comparisons; /**< Comparisons made inside the calls. */
+    unsigned long long nanoseconds; /**< Time spent in the calls; only the set operations are timed. */
+} SetOperationStats;
+
+/**
+ * @struct SetStats
+ * @brief The counters, since the program started or `resetSetStats()` was last called.
+ */
+typedef struct {
+    unsigned long long nodeHops; /**< Moves from a list node to its neighbour. */
+    unsigned long long comparisons; /**< Comparisons of elements in list walks and merges. */
+    unsigned long long nodeAllocations; /**< Nodes taken from a node pool. */
+    unsigned long long nodeFrees; /**< Nodes given back to a node pool one by one as they were deleted. */
+    unsigned long long slabAllocations; /**< Slabs the node pools allocated with `malloc()`. */
+    unsigned long long slabFrees; /**< Slabs freed, with all their nodes, when a node pool was released. */
+    SetOperationStats operations[STATS_OPERATIONS]; /**< Per `SetStatsOperation`. */
+} SetStats;
+
+/**
+ * @struct SetStatsMark
+ * @brief The counters at the start of a counted operation.
+ */
+typedef struct {
+    unsigned long long nodeHops; /**< `nodeHops` at the start. */
+    unsigned long long comparisons; /**< `comparisons` at the start. */
+    unsigned long long start; /**< Clock at the start in nanoseconds, for timed operations. */
+} SetStatsMark;
+
+int setStatsEnabled(void);
+void getSetStats(SetStats* stats);
+void resetSetStats(void);
+
+#ifdef ORDERED_SET_STATS
+#ifdef _MSC_VER
+#define STATS_THREAD_LOCAL __declspec(thread)
+#else
+#define STATS_THREAD_LOCAL _Thread_local
+#endif
+
+extern STATS_THREAD_LOCAL SetStats* setStatsThread;
+
+SetStats* registerSetStatsThread(void);
+void startSetStatsMark(SetStatsMark* mark, SetStatsOperation operation);
+void finishSetStatsMark(const SetStatsMark* mark, SetStatsOperation operation);
+
+/** The counters of the calling thread, registered the first time the thread counts. */
+#define STATS_THREAD (setStatsThread != NULL ? setStatsThread : registerSetStatsThread())
+/** Adds `amount` to the counter `counter` of `SetStats`. */
+#define STATS_COUNT(counter, amount) (STATS_THREAD->counter += (amount))
+/** Stores the value of `call` in `result`, counting the call as `operation`. */
+#define STATS_MEASURE(result, operation, call) do { \
+        SetStatsMark statsMark; \
+        startSetStatsMark(&statsMark, operation); \
+        (result) = (call); \
+        finishSetStatsMark(&statsMark, operation); \
+    } while (0)
+#else
+#define STATS_COUNT(counter, amount) ((void) 0)
+#define STATS_MEASURE(result, operation, call) ((result) = (call))
+#endif
+#endif
@@ -0,0 +1,200 @@
+/**
+ * @file SetStatsFunctions.c
+ *
+ * @brief Implementation of reading and clearing the optional set counters.
+ *
+ * @details This file provides the implementation for:
+ *   - Reporting whether the library counts at all, and reading and clearing the counters.
+ *   - Giving every thread that counts a block of counters of its own, when `ORDERED_SET_STATS` is defined.
+ *   - Attributing hops, comparisons and time to the set operation that caused them, when `ORDERED_SET_STATS`
+ *     is defined.
+ *
+ * @date 17/10/2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SetStats.h"
+#ifdef ORDERED_SET_STATS
+#include "SyncPrimitives.h"
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+/**
+ * @struct SetStatsBlock
+ * @brief The counters of one thread, linked to the blocks of the threads that registered before it.
+ */
+typedef struct SetStatsBlock {
+    SetStats counters; /**< The counters of the thread. */
+    struct SetStatsBlock *nextBlock; /**< Block registered before this one, NULL for the first. */
+} SetStatsBlock;
+
+STATS_THREAD_LOCAL SetStats *setStatsThread;
+static SetStatsBlock *setStatsBlocks;// Most recently registered block, read and pushed atomically
+
+/**
+ * @brief Gives the calling thread a block of counters of its own.
+ *
+ * @pre The calling thread has no block yet.
+ * @post `setStatsThread` points to the zeroed counters of a new block, which is linked in front of the others.
+ *
+ * @details
+ * - Blocks are only ever pushed, never removed, so they outlive their threads and `getSetStats()` still adds up
+ *   what ended threads counted. Pushing with compare-and-swap needs no lock to be set up beforehand.
+ *
+ * ***Pseudocode:***
+ * 1. Allocate a zeroed block; if that fails, print an error and exit
+ * 2. Push it in front of the list of blocks with compare-and-swap, retrying if another thread pushed first
+ * 3. Point `setStatsThread` to its counters and return them
+ *
+ * @return A pointer to the counters of the calling thread.
+*/
+SetStats *registerSetStatsThread(void) {
+    SetStatsBlock *block = (SetStatsBlock *) calloc(1, sizeof(SetStatsBlock));
+    SetStatsBlock *first;
+
+    if (block == NULL) {
+        printf("[ERROR] Memory allocation failed for the set counters of a thread.\n");
+        exit(-1);
+    }
+    do {
+        first = (SetStatsBlock *) atomicLoadPointer(&setStatsBlocks);
+        block->nextBlock = first;
+    } while (!atomicCasPointer(&setStatsBlocks, first, block));
+
+    setStatsThread = &block->counters;
+    return setStatsThread;
+}
+
+/**
+ * @brief Adds every counter of `part` to the same counter of `total`.
+*/
+static void addSetStats(SetStats *total, const SetStats *part) {
+    total->nodeHops += part->nodeHops;
+    total->comparisons += part->comparisons;
+    total->nodeAllocations += part->nodeAllocations;
+    total->nodeFrees += part->nodeFrees;
+    total->slabAllocations += part->slabAllocations;
+    total->slabFrees += part->slabFrees;
+    for (int i = 0; i < STATS_OPERATIONS; i++) {
+        total->operations[i].calls += part->operations[i].calls;
+        total->operations[i].nodeHops += part->operations[i].nodeHops;
+        total->operations[i].comparisons += part->operations[i].comparisons;
+        total->operations[i].nanoseconds += part->operations[i].nanoseconds;
+    }
+}
+
+/**
+ * @brief Returns the time in nanoseconds from a monotonic clock.
+*/
+static unsigned long long clockNanoseconds(void) {
+#ifdef _WIN32
+    static long long clockFrequency;// Ticks per second, read once
+    unsigned long long frequency = (unsigned long long) atomicLoadCounter(&clockFrequency);
+    unsigned long long ticks;
+    LARGE_INTEGER counter;
+
+    if (frequency == 0) {
+        LARGE_INTEGER read;
+
+        QueryPerformanceFrequency(&read);
+        frequency = (unsigned long long) read.QuadPart;
+        atomicStoreCounter(&clockFrequency, frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    ticks = (unsigned long long) counter.QuadPart;
+
+    // Whole seconds and the rest apart, so nothing overflows or is rounded away
+    return (ticks / frequency) * 1000000000ULL + (ticks % frequency) * 1000000000ULL / frequency;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long) now.tv_sec * 1000000000ULL + (unsigned long long) now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Records the counters at the start of a counted operation.
+ *
+ * @param mark Receives the counters.
+ * @param operation The `SetStatsOperation` starting; the set operations also read the clock.
+*/
+void startSetStatsMark(SetStatsMark *mark, SetStatsOperation operation) {
+    SetStats *counters = STATS_THREAD;
+
+    mark->nodeHops = counters->nodeHops;
+    mark->comparisons = counters->comparisons;
+    mark->start = operation >= STATS_UNION ? clockNanoseconds() : 0;
+}
+
+/**
+ * @brief Adds what happened since the start of a counted operation to the counters of the operation.
+ *
+ * @param mark The counters recorded by `startSetStatsMark()`.
+ * @param operation The `SetStatsOperation` finishing.
+*/
+void finishSetStatsMark(const SetStatsMark *mark, SetStatsOperation operation) {
+    SetStats *counters = STATS_THREAD;
+    SetOperationStats *stats = &counters->operations[operation];
+
+    stats->calls++;
+    stats->nodeHops += counters->nodeHops - mark->nodeHops;
+    stats->comparisons += counters->comparisons - mark->comparisons;
+    if (operation >= STATS_UNION) {
+        stats->nanoseconds += clockNanoseconds() - mark->start;
+    }
+}
+#endif
+
+/**
+ * @brief Tells whether the library was compiled with `ORDERED_SET_STATS`.
+ *
+ * @return 1 if the set counters are counting, 0 if they always read zero.
+*/
+int setStatsEnabled(void) {
+#ifdef ORDERED_SET_STATS
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Reads the set counters, added up over every thread that counted.
+ *
+ * @pre No other thread is running counted code, for example between two benchmark runs.
+ * @post `stats` holds the counters; they keep counting.
+ *
+ * @param stats Receives the `SetStats`, all zero without `ORDERED_SET_STATS`.
+*/
+void getSetStats(SetStats *stats) {
+    memset(stats, 0, sizeof(SetStats));
+#ifdef ORDERED_SET_STATS
+    for (SetStatsBlock *block = (SetStatsBlock *) atomicLoadPointer(&setStatsBlocks); block != NULL;
+         block = block->nextBlock) {
+        addSetStats(stats, &block->counters);
+    }
+#endif
+}
+
+/**
+ * @brief Clears the set counters of every thread, for example before the operation that is to be profiled.
+ *
+ * @pre No other thread is running counted code.
+ * @post Every counter is 0.
+*/
+void resetSetStats(void) {
+#ifdef ORDERED_SET_STATS
+    for (SetStatsBlock *block = (SetStatsBlock *) atomicLoadPointer(&setStatsBlocks); block != NULL;
+         block = block->nextBlock) {
+        memset(&block->counters, 0, sizeof(SetStats));
+    }
+#endif
+}
+
+// 
+
+// END OF SETSTATSFUNCTIONS.C
\ No newline at end of file
@@ -0,0 +1,92 @@
+/**
+ * @file SetStream.h
+ *
+ * @brief Header file for defining the set streams, which combine sorted files of any size without loading them.
+ *
+ * @details
+ * A `SetStreamReader` reads the elements of a sorted stream one at a time through a buffer of `SET_STREAM_BUFFER`
+ * bytes, and a `SetStreamWriter` writes them the same way, so the set operations on streams take the same memory
+ * whatever the size of their input. No `orderedIntSet` is ever built.
+ * - `SET_STREAM_BINARY` streams are set files, see `SetFile.h`, in either encoding. The checksum is verified once
+ *   the last element is read. A binary writer rewrites the header at the end, so its file must be seekable.
+ * - `SET_STREAM_TEXT` streams hold integers in decimal, separated by anything that is not a digit or a minus sign:
+ *   one per line, comma separated, or the `{1, 2, 3}` format of `printToStdout()`. A text writer writes one element
+ *   per line and works on pipes.
+ *
+ * Input must be in ascending order. Repeated elements are read once, like `createOrderedSetFromArray()` does; an
+ * element smaller than the one before stops the stream with `SET_FILE_BAD_FORMAT`. The operations keep the same
+ * elements as `setUnion()`, `setIntersection()` and `setDifference()`.
+ *
+ * The streams are caller-owned structs like `SetCursor`; the `FILE` they read or write stays open and belongs to
+ * the caller.
+ *
+ * @date 17/10/2026
+ */
+#ifndef SetStream_h
+#define SetStream_h
+#include <stdio.h>
+#include "SetFile.h"
+
+#define SET_STREAM_BUFFER 65536 /**< Bytes a stream reads or writes at a time. */
+
+/**
+ * @enum SetStreamFormat
+ * @brief How the elements of a stream are stored.
+ */
+typedef enum {
+    SET_STREAM_BINARY, /* 0 */ /**< A set file, raw or delta encoded. */
+    SET_STREAM_TEXT /* 1 */ /**< Decimal integers separated by any other characters. */
+} SetStreamFormat;
+
+/**
+ * @struct SetStreamReader
+ * @brief Reads the elements of a sorted stream in ascending order.
+ *
+ * Use the `setStream` functions rather than the fields.
+ */
+typedef struct {
+    FILE *file; /**< The stream read from. */
+    SetStreamFormat format; /**< Format of the stream. */
+    unsigned char *buffer; /**< `SET_STREAM_BUFFER` bytes read ahead. */
+    size_t next; /**< Next unread byte of `buffer`. */
+    size_t end; /**< One past the last byte read into `buffer`. */
+    SetFileHeader header; /**< Header of a binary stream. */
+    uint64_t remaining; /**< Payload bytes of a binary stream not read into `buffer` yet. */
+    uint32_t left; /**< Elements of a binary stream not decoded yet. */
+    uint32_t checksum; /**< Checksum of the payload bytes read so far. */
+    uint32_t biased; /**< Last element of a delta encoded stream with its sign bit flipped. */
+    int elem; /**< The current element. */
+    int hasElement; /**< 1 while `elem` holds an element. */
+    SetFileStatus status; /**< `SET_FILE_OK`, or why the stream stopped early. */
+} SetStreamReader;
+
+/**
+ * @struct SetStreamWriter
+ * @brief Writes elements in ascending order to a stream.
+ *
+ * Use the `setStream` functions rather than the fields.
+ */
+typedef struct {
+    FILE *file; /**< The stream written to. */
+    SetStreamFormat format; /**< Format of the stream. */
+    unsigned char *buffer; /**< `SET_STREAM_BUFFER` bytes waiting to be written. */
+    size_t used; /**< Number of bytes in `buffer`. */
+    SetFileHeader header; /**< Header of a binary stream, completed when the writer is closed. */
+    fpos_t start; /**< Position of the header of a binary stream. */
+    long long count; /**< Number of elements written. */
+    int last; /**< The last element written. */
+    SetFileStatus status; /**< `SET_FILE_OK`, or the first error. */
+} SetStreamWriter;
+
+SetFileStatus openSetStreamReader(SetStreamReader* reader, FILE* file, SetStreamFormat format);
+int setStreamHasElement(const SetStreamReader* reader);
+int setStreamElement(const SetStreamReader* reader);
+void setStreamAdvance(SetStreamReader* reader);
+SetFileStatus closeSetStreamReader(SetStreamReader* reader);
+SetFileStatus openSetStreamWriter(SetStreamWriter* writer, FILE* file, SetStreamFormat format, SetFileEncoding encoding);
+SetFileStatus setStreamWrite(SetStreamWriter* writer, int elem);
+SetFileStatus closeSetStreamWriter(SetStreamWriter* writer);
+SetFileStatus streamIntersection(SetStreamReader* a, SetStreamReader* b, SetStreamWriter* out);
+SetFileStatus streamUnion(SetStreamReader* a, SetStreamReader* b, SetStreamWriter* out);
+SetFileStatus streamDifference(SetStreamReader* a, SetStreamReader* b, SetStreamWriter* out);
+#endif
@@ -0,0 +1,573 @@
+/**
+ * @file SetStreamFunctions.c
+ *
+ * @brief Implementation of the set streams and of the set operations on them.
+ *
+ * @details This file provides the implementation for:
+ *   - Reading sorted binary and text streams one element at a time through a bounded buffer.
+ *   - Writing sorted elements to binary and text streams through a bounded buffer.
+ *   - Intersecting, uniting and subtracting two streams into a third in one pass.
+ *
+ * @date 17/10/2026
+*/
+
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "SetStream.h"
+#include "SetFormat.h"
+
+#define SET_STREAM_MAX_ELEMENT 12 // Bytes one element takes at most in any format: a sign, 10 digits and a newline
+
+/**
+ * @enum StreamOperation
+ * @brief Selects which elements a stream merge keeps, like the merge engine of the in-memory set operations.
+ */
+typedef enum {
+    STREAM_INTERSECTION, /**< Keep elements present in both streams. */
+    STREAM_UNION, /**< Keep elements present in either stream. */
+    STREAM_DIFFERENCE /**< Keep elements present in the first stream only. */
+} StreamOperation;
+
+/**
+ * @brief Moves the unread bytes of a reader to the front of its buffer and fills the rest from the stream.
+ *
+ * @details
+ * - A binary stream never reads past its payload, and every byte read is added to the checksum.
+ *
+ * @return 1 if any byte was read, 0 at the end of the stream or on a read error.
+*/
+static int refillReader(SetStreamReader *reader) {
+    size_t left = reader->end - reader->next;
+    size_t want = SET_STREAM_BUFFER - left;
+
+    memmove(reader->buffer, reader->buffer + reader->next, left);
+    if (reader->format == SET_STREAM_BINARY && want > reader->remaining) {
+        want = (size_t) reader->remaining;
+    }
+    size_t got = want > 0 ? fread(reader->buffer + left, 1, want, reader->file) : 0;
+    if (reader->format == SET_STREAM_BINARY) {
+        reader->checksum = setFileChecksum(reader->checksum, reader->buffer + left, got);
+        reader->remaining -= got;
+    }
+    reader->next = 0;
+    reader->end = left + got;
+
+    return got > 0;
+}
+
+/**
+ * @brief Reads the next element of a binary stream.
+ *
+ * @details
+ * - After the last element the rest of the payload is read, so that trailing bytes are caught and the checksum
+ *   covers the whole payload before it is compared.
+ * - Delta encoded gaps are checked like `loadOrderedSet()` does.
+ *
+ * @param reader The `SetStreamReader`.
+ * @param elem Receives the element.
+ *
+ * @return 1 if an element was read, 0 at the end of the stream or if `reader->status` was set to an error.
+*/
+static int readBinary(SetStreamReader *reader, int *elem) {
+    if (reader->left == 0) {
+        int trailing = reader->next != reader->end;
+
+        // Take in the rest of the payload
+        while (reader->remaining > 0 && refillReader(reader)) {
+            trailing = 1;
+            reader->next = reader->end;
+        }
+        if (trailing || reader->remaining > 0) {
+            reader->status = SET_FILE_BAD_FORMAT;
+        }
+        else if (reader->checksum != reader->header.checksum) {
+            reader->status = SET_FILE_BAD_CHECKSUM;
+        }
+        return 0;
+    }
+
+    if (reader->header.encoding == SET_FILE_RAW) {
+        if (reader->end - reader->next < sizeof(int)) {
+            refillReader(reader);
+        }
+        if (reader->end - reader->next < sizeof(int)) {
+            reader->status = SET_FILE_BAD_FORMAT;// The file was cut short
+            return 0;
+        }
+        memcpy(elem, reader->buffer + reader->next, sizeof(int));
+        reader->next += sizeof(int);
+    }
+    else {
+        uint32_t gap = 0;
+        int shift = 0;
+        unsigned char byte = 0x80u;
+
+        // Collect the 7-bit groups of the gap, lowest first
+        while (byte & 0x80u) {
+            if (reader->next == reader->end && !refillReader(reader)) {
+                reader->status = SET_FILE_BAD_FORMAT;// The file was cut short
+                return 0;
+            }
+            byte = reader->buffer[reader->next++];
+            if (shift > 28 || (shift == 28 && (byte & 0x7Fu) > 0xFu)) {
+                reader->status = SET_FILE_BAD_FORMAT;// The gap does not fit 32 bits
+                return 0;
+            }
+            gap |= (uint32_t) (byte & 0x7Fu) << shift;
+            shift += 7;
+        }
+        // Only the first gap may be 0, and no element may pass the largest int
+        if ((gap == 0 && reader->left != reader->header.count) || gap > 0xFFFFFFFFu - reader->biased) {
+            reader->status = SET_FILE_BAD_FORMAT;
+            return 0;
+        }
+        reader->biased += gap;
+        *elem = (int) (reader->biased ^ 0x80000000u);
+    }
+    reader->left--;
+
+    return 1;
+}
+
+/**
+ * @brief Reads the next element of a text stream.
+ *
+ * @details
+ * - Skips every byte that is neither a digit nor a minus sign, then reads an optional minus sign and the digits.
+ * - A minus sign without digits, or a number that does not fit an int, makes the stream invalid.
+ *
+ * @param reader The `SetStreamReader`.
+ * @param elem Receives the element.
+ *
+ * @return 1 if an element was read, 0 at the end of the stream or if `reader->status` was set to an error.
+*/
+static int readText(SetStreamReader *reader, int *elem) {
+    long long value = 0;
+    int negative = 0;
+    int digits = 0;
+
+    // Skip the separators
+    for (;;) {
+        if (reader->next == reader->end && !refillReader(reader)) {
+            return 0;// No element left
+        }
+        unsigned char c = reader->buffer[reader->next];
+        if ((c >= '0' && c <= '9') || c == '-') {
+            break;
+        }
+        reader->next++;
+    }
+
+    if (reader->buffer[reader->next] == '-') {
+        negative = 1;
+        reader->next++;
+    }
+    while ((reader->next < reader->end || refillReader(reader))
+           && reader->buffer[reader->next] >= '0' && reader->buffer[reader->next] <= '9') {
+        value = value * 10 + (reader->buffer[reader->next++] - '0');
+        digits++;
+        if (value > (long long) INT_MAX + 1) {
+            reader->status = SET_FILE_BAD_FORMAT;// Too large for an int
+            return 0;
+        }
+    }
+    if (digits == 0 || (!negative && value > INT_MAX)) {
+        reader->status = SET_FILE_BAD_FORMAT;
+        return 0;
+    }
+    *elem = (int) (negative ? -value : value);
+
+    return 1;
+}
+
+/**
+ * @brief Opens a reader on a sorted stream and reads its first element.
+ *
+ * @pre `file` is open for reading, in binary mode, at the start of the stream.
+ * @post The reader is on the first element, or done if the stream is empty or invalid.
+ *
+ * ***Pseudocode:***
+ * 1. Allocate the buffer (`SET_FILE_NO_MEMORY`)
+ * 2. If the stream is binary, read and check the header
+ * 3. Read the first element
+ * 4. Return the status of the reader
+ *
+ * @param reader The `SetStreamReader` to open.
+ * @param file The stream to read; it stays owned by the caller.
+ * @param format The `SetStreamFormat` of the stream.
+ *
+ * @return `SET_FILE_OK`, or why the stream cannot be read.
+*/
+SetFileStatus openSetStreamReader(SetStreamReader *reader, FILE *file, SetStreamFormat format) {
+    memset(reader, 0, sizeof(SetStreamReader));
+    reader->file = file;
+    reader->format = format;
+    reader->checksum = 1;
+    reader->status = SET_FILE_OK;
+
+    reader->buffer = (unsigned char *) malloc(SET_STREAM_BUFFER);
+    if (reader->buffer == NULL) {
+        reader->status = SET_FILE_NO_MEMORY;
+    }
+    else if (format == SET_STREAM_BINARY) {
+        if (fread(&reader->header, sizeof(SetFileHeader), 1, file) != 1) {
+            reader->status = SET_FILE_BAD_FORMAT;// Too short for a header
+        }
+        else {
+            reader->status = checkSetFileHeader(&reader->header);
+            reader->remaining = reader->header.payloadSize;
+            reader->left = reader->header.count;
+        }
+    }
+
+    if (reader->status == SET_FILE_OK) {
+        setStreamAdvance(reader);
+    }
+
+    return reader->status;
+}
+
+/**
+ * @brief Checks whether a stream reader has an element left.
+ *
+ * @param reader The `SetStreamReader`.
+ *
+ * @return 1 if `setStreamElement()` may be called, 0 once the stream is done or stopped with an error.
+*/
+int setStreamHasElement(const SetStreamReader *reader) {
+    return reader->hasElement;
+}
+
+/**
+ * @brief Returns the element a stream reader is on.
+ *
+ * @pre `setStreamHasElement(reader)` is 1.
+ *
+ * @param reader The `SetStreamReader`.
+ *
+ * @return The element.
+*/
+int setStreamElement(const SetStreamReader *reader) {
+    return reader->elem;
+}
+
+/**
+ * @brief Moves a stream reader on to the next larger element.
+ *
+ * @pre The reader was opened and has not been closed.
+ * @post The reader is on the next element that is larger than the current one, or done.
+ *
+ * ***Pseudocode:***
+ * 1. Read elements until one is larger than the current one:
+ *      - If none is left or the stream is invalid, the reader is done
+ *      - If one is smaller, stop with `SET_FILE_BAD_FORMAT`
+ *      - Repeats of the current one are skipped
+ *
+ * @param reader The `SetStreamReader`.
+*/
+void setStreamAdvance(SetStreamReader *reader) {
+    int hadElement = reader->hasElement;
+    int elem;
+
+    reader->hasElement = 0;
+    while (reader->status == SET_FILE_OK
+           && (reader->format == SET_STREAM_BINARY ? readBinary(reader, &elem) : readText(reader, &elem))) {
+        if (!hadElement || elem > reader->elem) {
+            reader->elem = elem;
+            reader->hasElement = 1;
+            return;
+        }
+        if (elem < reader->elem) {
+            reader->status = SET_FILE_BAD_FORMAT;// The stream is not sorted
+        }
+    }
+}
+
+/**
+ * @brief Closes a stream reader and frees its buffer.
+ *
+ * @pre The reader was opened and has not been closed.
+ * @post The reader is done; its file stays open.
+ *
+ * @param reader The `SetStreamReader`.
+ *
+ * @return `SET_FILE_OK` if everything read so far was valid, otherwise why reading stopped.
+*/
+SetFileStatus closeSetStreamReader(SetStreamReader *reader) {
+    free(reader->buffer);
+    reader->buffer = NULL;
+    reader->hasElement = 0;
+
+    return reader->status;
+}
+
+/**
+ * @brief Writes the buffered bytes of a writer to its stream.
+ *
+ * @details
+ * - The payload of a binary stream is added to the checksum and size in its header.
+*/
+static void flushWriter(SetStreamWriter *writer) {
+    if (writer->format == SET_STREAM_BINARY) {
+        writer->header.checksum = setFileChecksum(writer->header.checksum, writer->buffer, writer->used);
+        writer->header.payloadSize += writer->used;
+    }
+    if (fwrite(writer->buffer, 1, writer->used, writer->file) != writer->used) {
+        writer->status = SET_FILE_IO_ERROR;
+    }
+    writer->used = 0;
+}
+
+/**
+ * @brief Opens a writer on a stream.
+ *
+ * @pre `file` is open for writing, in binary mode; a binary stream must be seekable.
+ * @post A binary stream starts with a placeholder header, which `closeSetStreamWriter()` completes.
+ *
+ * @param writer The `SetStreamWriter` to open.
+ * @param file The stream to write; it stays owned by the caller.
+ * @param format The `SetStreamFormat` of the stream.
+ * @param encoding The `SetFileEncoding` of a binary stream, ignored for text.
+ *
+ * @return `SET_FILE_OK`, or why the stream cannot be written.
+*/
+SetFileStatus openSetStreamWriter(SetStreamWriter *writer, FILE *file, SetStreamFormat format, SetFileEncoding encoding) {
+    SetFileHeader header = {SET_FILE_MAGIC, SET_FILE_VERSION, (uint32_t) encoding, 0, 0, 1, 0};
+
+    writer->file = file;
+    writer->format = format;
+    writer->used = 0;
+    writer->header = header;
+    writer->count = 0;
+    writer->last = 0;
+    writer->status = SET_FILE_OK;
+
+    writer->buffer = (unsigned char *) malloc(SET_STREAM_BUFFER);
+    if (writer->buffer == NULL) {
+        writer->status = SET_FILE_NO_MEMORY;
+    }
+    else if (format == SET_STREAM_BINARY) {
+        if (encoding != SET_FILE_RAW && encoding != SET_FILE_DELTA) {
+            writer->status = SET_FILE_BAD_FORMAT;
+        }
+        // Remember where the header goes, it is rewritten at the end
+        else if (fgetpos(file, &writer->start) != 0 || fwrite(&header, sizeof(SetFileHeader), 1, file) != 1) {
+            writer->status = SET_FILE_IO_ERROR;
+        }
+    }
+
+    return writer->status;
+}
+
+/**
+ * @brief Writes an element to a stream.
+ *
+ * @pre The writer was opened and has not been closed.
+ * @post The element is buffered and written out once the buffer is full.
+ *
+ * ***Pseudocode:***
+ * 1. If the writer already failed, return its status
+ * 2. If `elem` is not larger than the last element, stop with `SET_FILE_BAD_FORMAT`
+ * 3. Append `elem` to the buffer: as 4 bytes, as the gap to the last element, or as decimal text and a newline
+ * 4. If the buffer is nearly full, write it out
+ *
+ * @param writer The `SetStreamWriter`.
+ * @param elem The element, larger than every element written before.
+ *
+ * @return `SET_FILE_OK`, or the first error of the writer.
+*/
+SetFileStatus setStreamWrite(SetStreamWriter *writer, int elem) {
+    if (writer->status != SET_FILE_OK) {
+        return writer->status;
+    }
+    if (writer->count > 0 && elem <= writer->last) {
+        writer->status = SET_FILE_BAD_FORMAT;// Streams are sorted
+        return writer->status;
+    }
+
+    unsigned char *out = writer->buffer + writer->used;
+    if (writer->format == SET_STREAM_TEXT) {
+        out += formatInt((char *) out, elem);
+        *out++ = '\n';
+    }
+    else if (writer->header.encoding == SET_FILE_RAW) {
+        memcpy(out, &elem, sizeof(int));
+        out += sizeof(int);
+    }
+    else {
+        // Flipping the sign bit makes the gaps between ascending elements positive
+        uint32_t previous = writer->count > 0 ? (uint32_t) writer->last ^ 0x80000000u : 0;
+        uint32_t gap = ((uint32_t) elem ^ 0x80000000u) - previous;
+
+        while (gap >= 0x80u) {
+            *out++ = (unsigned char) (gap | 0x80u);
+            gap >>= 7;
+        }
+        *out++ = (unsigned char) gap;
+    }
+    writer->used = out - writer->buffer;
+    writer->last = elem;
+    writer->count++;
+
+    // Write the buffer out before the next element could overflow it
+    if (writer->used > SET_STREAM_BUFFER - SET_STREAM_MAX_ELEMENT) {
+        flushWriter(writer);
+    }
+
+    return writer->status;
+}
+
+/**
+ * @brief Writes out what is left in a writer, completes the header of a binary stream and frees the buffer.
+ *
+ * @pre The writer was opened and has not been closed.
+ * @post The stream holds every element written, and its file position is at its end.
+ *
+ * @param writer The `SetStreamWriter`.
+ *
+ * @return `SET_FILE_OK`, or the first error of the writer.
+*/
+SetFileStatus closeSetStreamWriter(SetStreamWriter *writer) {
+    if (writer->status == SET_FILE_OK && writer->used > 0) {
+        flushWriter(writer);
+    }
+    if (writer->status == SET_FILE_OK && writer->format == SET_STREAM_BINARY) {
+        if (writer->count > INT_MAX) {
+            writer->status = SET_FILE_BAD_FORMAT;// Too many elements for a set
+        }
+        else {
+            writer->header.count = (uint32_t) writer->count;
+            if (fsetpos(writer->file, &writer->start) != 0
+                || fwrite(&writer->header, sizeof(SetFileHeader), 1, writer->file) != 1
+                || fseek(writer->file, 0, SEEK_END) != 0) {
+                writer->status = SET_FILE_IO_ERROR;
+            }
+        }
+    }
+    if (writer->status == SET_FILE_OK && fflush(writer->file) != 0) {
+        writer->status = SET_FILE_IO_ERROR;
+    }
+    free(writer->buffer);
+    writer->buffer = NULL;
+
+    return writer->status;
+}
+
+/**
+ * @brief Merges two sorted streams into a third, keeping the elements selected by `op`.
+ *
+ * @details
+ * - Walks both streams in one pass like the in-memory merge: the smaller element is kept or skipped depending on
+ *   the operation, and equal elements are kept once.
+ * - Once one stream is done, the rest of the other one is copied for a union, and for a difference if it is the
+ *   first one; otherwise reading stops there.
+ *
+ * ***Pseudocode:***
+ * 1. While both streams have elements and the output has not failed:
+ *      - If the element of `a` is smaller: write it unless intersecting, advance `a`
+ *      - If the element of `b` is smaller: write it if uniting, advance `b`
+ *      - If they are equal: write it unless subtracting, advance both
+ * 2. Unless intersecting, copy the rest of `a`; if uniting, copy the rest of `b`
+ * 3. Return the first error of `a`, `b` and `out`, or `SET_FILE_OK`
+ *
+ * @return The `SetFileStatus` of the merge.
+*/
+static SetFileStatus streamMerge(SetStreamReader *a, SetStreamReader *b, SetStreamWriter *out, StreamOperation op) {
+    while (setStreamHasElement(a) && setStreamHasElement(b) && out->status == SET_FILE_OK) {
+        int x = setStreamElement(a);
+        int y = setStreamElement(b);
+
+        if (x < y) {
+            if (op != STREAM_INTERSECTION) {
+                setStreamWrite(out, x);
+            }
+            setStreamAdvance(a);
+        }
+        else if (x > y) {
+            if (op == STREAM_UNION) {
+                setStreamWrite(out, y);
+            }
+            setStreamAdvance(b);
+        }
+        else {
+            if (op != STREAM_DIFFERENCE) {
+                setStreamWrite(out, x);
+            }
+            setStreamAdvance(a);
+            setStreamAdvance(b);
+        }
+    }
+
+    // Copy the rest of the streams the operation keeps
+    while (op != STREAM_INTERSECTION && setStreamHasElement(a) && out->status == SET_FILE_OK) {
+        setStreamWrite(out, setStreamElement(a));
+        setStreamAdvance(a);
+    }
+    while (op == STREAM_UNION && setStreamHasElement(b) && out->status == SET_FILE_OK) {
+        setStreamWrite(out, setStreamElement(b));
+        setStreamAdvance(b);
+    }
+
+    if (a->status != SET_FILE_OK) {
+        return a->status;
+    }
+    if (b->status != SET_FILE_OK) {
+        return b->status;
+    }
+    return out->status;
+}
+
+/**
+ * @brief Writes the elements present in both of two sorted streams.
+ *
+ * @pre Both readers and the writer are open; the readers are on their first element.
+ * @post `out` holds the intersection; close it to complete the stream. Reading stops once either stream is done.
+ *
+ * @param a The first `SetStreamReader`.
+ * @param b The second `SetStreamReader`.
+ * @param out The `SetStreamWriter` receiving the result.
+ *
+ * @return `SET_FILE_OK`, or the first error of the streams.
+*/
+SetFileStatus streamIntersection(SetStreamReader *a, SetStreamReader *b, SetStreamWriter *out) {
+    return streamMerge(a, b, out, STREAM_INTERSECTION);
+}
+
+/**
+ * @brief Writes the elements present in either of two sorted streams.
+ *
+ * @pre Both readers and the writer are open; the readers are on their first element.
+ * @post `out` holds the union; close it to complete the stream.
+ *
+ * @param a The first `SetStreamReader`.
+ * @param b The second `SetStreamReader`.
+ * @param out The `SetStreamWriter` receiving the result.
+ *
+ * @return `SET_FILE_OK`, or the first error of the streams.
+*/
+SetFileStatus streamUnion(SetStreamReader *a, SetStreamReader *b, SetStreamWriter *out) {
+    return streamMerge(a, b, out, STREAM_UNION);
+}
+
+/**
+ * @brief Writes the elements of one sorted stream that are not in another.
+ *
+ * @pre Both readers and the writer are open; the readers are on their first element.
+ * @post `out` holds the difference `a - b`; close it to complete the stream. Reading `b` stops once `a` is done.
+ *
+ * @param a The `SetStreamReader` whose elements are kept.
+ * @param b The `SetStreamReader` whose elements are removed.
+ * @param out The `SetStreamWriter` receiving the result.
+ *
+ * @return `SET_FILE_OK`, or the first error of the streams.
+*/
+SetFileStatus streamDifference(SetStreamReader *a, SetStreamReader *b, SetStreamWriter *out) {
+    return streamMerge(a, b, out, STREAM_DIFFERENCE);
+}
+
+// 
+
+// END OF SETSTREAMFUNCTIONS.C
\ No newline at end of file
@@ -0,0 +1,66 @@
+/**
+ * @file SkipListIndex.h
+ *
+ * @brief Header file for defining the skip list index that can be layered over the nodes of a double linked list.
+ *
+ * @details
+ * The index never stores elements itself. Roughly one node in four of the sorted double linked list gets a
+ * "tower" of forward links, one link per level, and each level skips over about four times as many nodes as the
+ * level below it. A search runs along the top level, drops a level whenever the next tower is too far, and
+ * finishes with a short walk along the list itself, so finding the position of an element is O(log n) on average.
+ *
+ * Every link also records how many nodes of the list it passes, so the same descent counts the nodes before an
+ * element (its rank) or finds the node at a given position of the list, see `skipListRank()` and `skipListSelect()`.
+ *
+ * The list keeps working exactly as before: in-order iteration still walks the `next` pointers of its nodes.
+ *
+ * @note The double linked list types are defined in 'DoubleLinkedListTypeDefs.h'.
+ *
+ * @date 17/10/2026
+ */
+#ifndef SkipListIndex_h
+#define SkipListIndex_h
+#include "DoubleLinkedListTypeDefs.h"
+
+#define SKIP_LIST_MAX_LEVEL 16 /**< Maximum number of index levels, enough for 4^16 (about 4 * 10^9) elements. */
+
+/**
+ * @struct skipLink
+ * @brief One forward link of a tower.
+ */
+typedef struct skipLink {
+    struct skipTower *next; /**< Next tower reaching this level, NULL at the end of the level. */
+    int width; /**< Nodes passed to reach the node of `next`, or to reach the end of the list if `next` is NULL. */
+} SkipLink;
+
+/**
+ * @struct skipTower
+ * @brief The forward links stored for one indexed node.
+ *
+ * The tower is allocated with room for `height` links; `link` is declared with one entry only.
+ */
+typedef struct skipTower {
+    Node *node; /**< Node of the double linked list this tower stands on. */
+    int height; /**< Number of levels this tower reaches. */
+    SkipLink link[1]; /**< Forward links, one per level, lowest level first. */
+} SkipTower;
+
+/**
+ * @struct SkipListIndex
+ * @brief Skip list index over the nodes of a sorted double linked list.
+ */
+typedef struct {
+    SkipTower *head; /**< Tower of full height standing on the list's head node. */
+    int levels; /**< Number of levels currently in use. */
+    unsigned int seed; /**< State of the random generator used to pick tower heights. */
+} SkipListIndex;
+
+SkipListIndex *createSkipListIndex(DoubleLinkedList *list);
+void deleteSkipListIndex(SkipListIndex *index);
+Node *skipListFindPredecessor(SkipListIndex *index, int elem, SkipTower **update);
+Node *skipListFindPredecessorFrom(SkipListIndex *index, int elem, SkipTower **update);
+void skipListInsert(SkipListIndex *index, Node *node, SkipTower **update);
+void skipListRemove(SkipListIndex *index, Node *node, SkipTower **update);
+int skipListRank(SkipListIndex *index, int elem);
+Node *skipListSelect(SkipListIndex *index, int position);
+#endif
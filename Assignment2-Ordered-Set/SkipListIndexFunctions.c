@@ -0,0 +1,469 @@
+/**
+ * @file SkipListIndexFunctions.c
+ *
+ * @brief Implementation of the skip list index layered over a sorted double linked list.
+ *
+ * @details This file provides the implementation for:
+ *   - Building an index over an existing sorted list and deleting it again.
+ *   - Finding the position of an element in O(log n) on average.
+ *   - Keeping the index up to date when a node is linked into or unlinked from the list.
+ *   - Counting the nodes before an element and finding the node at a position, through the widths of the links.
+ *
+ * @date 17/10/2026
+*/
+
+#include <stdlib.h>
+#include "SkipListIndex.h"
+
+/**
+ * @brief Picks the height of the tower for a newly indexed node.
+ *
+ * @details
+ * - Every level is reached with probability 1/4, so about one node in four gets a tower at all and each level
+ *   holds about a quarter of the towers of the level below it.
+ * - The random numbers come from a xorshift generator, which is fast and good enough for balancing.
+ *
+ * ***Pseudocode:***
+ * 1. Advance the xorshift state of `index`
+ * 2. Count pairs of zero bits from the bottom of the random number, up to `SKIP_LIST_MAX_LEVEL`
+ * 3. Return the count
+ *
+ * @param index A pointer to the `SkipListIndex`.
+ *
+ * @return The height of the new tower, 0 if the node is not indexed at all.
+*/
+static int randomHeight(SkipListIndex *index) {
+    unsigned int bits;
+    int height = 0;
+
+    // Advance the xorshift generator
+    index->seed ^= index->seed << 13;
+    index->seed ^= index->seed >> 17;
+    index->seed ^= index->seed << 5;
+    bits = index->seed;
+
+    // Each pair of zero bits (probability 1/4) adds one level
+    while (height < SKIP_LIST_MAX_LEVEL && (bits & 3) == 0) {
+        height++;
+        bits >>= 2;
+    }
+
+    return height;
+}
+
+/**
+ * @brief Allocates a tower with all forward links set to NULL and passing no node.
+ *
+ * @param node The node the tower stands on.
+ * @param height The number of levels the tower reaches (at least 1).
+ *
+ * @return A pointer to the new tower, or `NULL` on allocation failure.
+*/
+static SkipTower *createTower(Node *node, int height) {
+    // The struct already holds one link, the remaining ones are allocated behind it
+    SkipTower *tower = (SkipTower *) malloc(sizeof(SkipTower) + (height - 1) * sizeof(SkipLink));
+
+    if (tower != NULL) {
+        tower->node = node;
+        tower->height = height;
+        for (int level = 0; level < height; level++) {
+            tower->link[level].next = NULL;
+            tower->link[level].width = 0;
+        }
+    }
+
+    return tower;
+}
+
+/**
+ * @brief Builds a skip list index over the nodes of a sorted double linked list.
+ *
+ * @pre `list` is valid and its elements are in ascending order.
+ * @post Every node of `list` can be found through the index.
+ *
+ * @details
+ * - The list is walked once and each node that gets a tower is linked after the last tower seen on every level
+ *   it reaches, so building the index is O(n).
+ * - The width of each link is the difference between the positions of the nodes of its two towers.
+ *
+ * ***Pseudocode:***
+ * 1. Allocate the index and a full height tower for the list's head node
+ * 2. Set the last tower of every level to the head tower
+ * 3. For each node of `list`, counting its position:
+ *      - Pick a random height, skip the node if it is 0
+ *      - Link a new tower after the last tower of each of its levels, passing the nodes since that tower
+ * 4. If any allocation fails, delete the partial index and return NULL
+ * 5. Let the last tower of every level pass the rest of the list
+ * 6. Return the index
+ *
+ * @param list A pointer to the sorted `DoubleLinkedList` to index.
+ *
+ * @return A pointer to the new index, or `NULL` on allocation failure.
+*/
+SkipListIndex *createSkipListIndex(DoubleLinkedList *list) {
+    SkipListIndex *index = (SkipListIndex *) malloc(sizeof(SkipListIndex));
+    SkipTower *last[SKIP_LIST_MAX_LEVEL];
+    int lastPosition[SKIP_LIST_MAX_LEVEL];// Position of the node of each last tower, the head is at 0
+    int position = 0;
+
+    if (index == NULL) {
+        return NULL;// Return NULL if allocation fails
+    }
+
+    index->levels = 1;
+    index->seed = 2463534242u;// Any non-zero seed works for xorshift
+    index->head = createTower(list->head, SKIP_LIST_MAX_LEVEL);
+    if (index->head == NULL) {
+        free(index);
+        return NULL;// Return NULL if allocation fails
+    }
+
+    // Every level starts at the head tower
+    for (int level = 0; level < SKIP_LIST_MAX_LEVEL; level++) {
+        last[level] = index->head;
+        lastPosition[level] = 0;
+    }
+
+    // Walk the list once, appending towers to the end of each level they reach
+    for (Node *node = list->head->next; node != NULL; node = node->next) {
+        int height = randomHeight(index);
+
+        position++;
+        if (height == 0) {
+            continue;// This node is only reachable through the list itself
+        }
+
+        SkipTower *tower = createTower(node, height);
+        if (tower == NULL) {
+            // Clean up and return NULL if memory allocation fails
+            deleteSkipListIndex(index);
+            return NULL;
+        }
+
+        for (int level = 0; level < height; level++) {
+            last[level]->link[level].next = tower;
+            last[level]->link[level].width = position - lastPosition[level];
+            last[level] = tower;
+            lastPosition[level] = position;
+        }
+        if (height > index->levels) {
+            index->levels = height;
+        }
+    }
+
+    // The last tower of each level passes the rest of the list
+    for (int level = 0; level < SKIP_LIST_MAX_LEVEL; level++) {
+        last[level]->link[level].width = position - lastPosition[level];
+    }
+
+    return index;
+}
+
+/**
+ * @brief Deletes a skip list index and frees all of its towers.
+ *
+ * @pre `index` is valid or NULL.
+ * @post All towers and the index are deallocated; the indexed list itself is left untouched.
+ *
+ * @param index A pointer to the `SkipListIndex` to delete.
+*/
+void deleteSkipListIndex(SkipListIndex *index) {
+    if (index == NULL) {
+        return;// Nothing to delete
+    }
+
+    // Every tower reaches the lowest level, so walking it visits all of them
+    SkipTower *tower = index->head;
+    while (tower != NULL) {
+        SkipTower *next = tower->link[0].next;
+        free(tower);
+        tower = next;
+    }
+
+    free(index);
+}
+
+/**
+ * @brief Finds the last node holding an element smaller than `elem`.
+ *
+ * @pre `index` is valid and indexes a sorted list.
+ * @post If `update` is not NULL, `update[level]` holds the last tower before `elem` on every level in use.
+ *
+ * @details
+ * - Runs along the highest level as long as the next tower is still smaller than `elem`, then drops one level,
+ *   and finally walks the few unindexed nodes left between the last tower and `elem`.
+ * - The node after the returned one is the first node holding an element greater than or equal to `elem`.
+ *
+ * ***Pseudocode:***
+ * 1. Start at the head tower on the highest level in use
+ * 2. For each level from the top down:
+ *      - Move right while the next tower's element is smaller than `elem`
+ *      - Remember the tower in `update`
+ * 3. Walk the list from the last tower's node while the next element is smaller than `elem`
+ * 4. Return that node
+ *
+ * @param index A pointer to the `SkipListIndex`.
+ * @param elem The integer element to search for.
+ * @param update Array of `SKIP_LIST_MAX_LEVEL` tower pointers filled for a later insert or remove, or NULL.
+ *
+ * @return The predecessor node of `elem`, which is the list's head node if every element is greater or equal.
+*/
+Node *skipListFindPredecessor(SkipListIndex *index, int elem, SkipTower **update) {
+    SkipTower *tower = index->head;
+
+    // Descend level by level, moving right as far as possible on each
+    for (int level = index->levels - 1; level >= 0; level--) {
+        while (tower->link[level].next != NULL && tower->link[level].next->node->d.i < elem) {
+            tower = tower->link[level].next;
+        }
+        if (update != NULL) {
+            update[level] = tower;
+        }
+    }
+
+    // Finish with the short walk over the unindexed nodes
+    Node *node = tower->node;
+    while (node->next != NULL && node->next->d.i < elem) {
+        node = node->next;
+    }
+
+    return node;
+}
+
+/**
+ * @brief Finds the last node holding an element smaller than `elem`, starting from the result of an earlier search.
+ *
+ * @pre `update` holds the towers found by an earlier search for an element smaller than or equal to `elem`,
+ *      or the head tower on every level to start from the beginning.
+ * @post `update[level]` holds the last tower before `elem` on every level in use.
+ *
+ * @details
+ * - This is a finger search: instead of starting at the top of the head tower, it climbs up from the towers of the
+ *   previous search only as long as the next tower on the level is still smaller than `elem`, then descends as usual.
+ * - Searching for `k` ascending elements spread over a list of `n` costs O(k log(n / k)) in total, which makes
+ *   it the skip list form of a galloping (exponential) search.
+ *
+ * ***Pseudocode:***
+ * 1. Starting at the lowest level, climb while the next tower after `update[level]` is smaller than `elem`
+ * 2. From `update[level]` on the level reached, descend as in `skipListFindPredecessor()`, refreshing `update`
+ * 3. Walk the list from the last tower's node while the next element is smaller than `elem`
+ * 4. Return that node
+ *
+ * @param index A pointer to the `SkipListIndex`.
+ * @param elem The integer element to search for.
+ * @param update Array of `SKIP_LIST_MAX_LEVEL` tower pointers kept between searches.
+ *
+ * @return The predecessor node of `elem`, which is the list's head node if every element is greater or equal.
+*/
+Node *skipListFindPredecessorFrom(SkipListIndex *index, int elem, SkipTower **update) {
+    int level = 0;
+
+    // Climb only as high as the distance to elem requires
+    while (level < index->levels - 1 && update[level]->link[level].next != NULL
+           && update[level]->link[level].next->node->d.i < elem) {
+        level++;
+    }
+
+    // Descend from there, the levels above are still valid for elem
+    SkipTower *tower = update[level];
+    for (; level >= 0; level--) {
+        while (tower->link[level].next != NULL && tower->link[level].next->node->d.i < elem) {
+            tower = tower->link[level].next;
+        }
+        update[level] = tower;
+    }
+
+    // Finish with the short walk over the unindexed nodes
+    Node *node = tower->node;
+    while (node->next != NULL && node->next->d.i < elem) {
+        node = node->next;
+    }
+
+    return node;
+}
+
+/**
+ * @brief Adds a node that was just linked into the list to the index.
+ *
+ * @pre `node` was inserted right after the node returned by `skipListFindPredecessor()`, which filled `update`.
+ * @post `node` may have a tower linked into the levels it reaches, and every link passing it counts it.
+ *
+ * @details
+ * - Most nodes get no tower at all; then only the links passing over the node get one wider.
+ * - If the tower cannot be allocated the node simply stays unindexed; it is still found by the final list walk
+ *   of a search, so the index remains correct.
+ * - A link the new tower is linked into is split in two, so the distance from the tower before it to the node is
+ *   counted: along the list on the lowest level, then along the level below for each level above.
+ *
+ * ***Pseudocode:***
+ * 1. Pick a random height and allocate the tower, use height 0 if it is 0 or allocation fails
+ * 2. If the tower is taller than the levels in use, start the new levels at the head tower
+ * 3. On each level of the tower, count the nodes from the node of `update[level]` to `node`
+ * 4. On each level of the tower, link it in after `update[level]`, splitting the width of the link
+ * 5. On every level above the tower, widen the link passing over `node` by one
+ *
+ * @param index A pointer to the `SkipListIndex`.
+ * @param node The newly linked node.
+ * @param update The towers filled in by `skipListFindPredecessor()` for the node's element.
+*/
+void skipListInsert(SkipListIndex *index, Node *node, SkipTower **update) {
+    int height = randomHeight(index);
+    int distance[SKIP_LIST_MAX_LEVEL];// Nodes from the node of update[level] to node, node included
+    SkipTower *tower = height > 0 ? createTower(node, height) : NULL;
+
+    if (tower == NULL) {
+        height = 0;// The node stays unindexed, which is slower but still correct
+    }
+
+    // New levels start at the head tower
+    while (index->levels < height) {
+        update[index->levels] = index->head;
+        index->levels++;
+    }
+
+    // Measure how far the node is from the tower before it on each level of the new tower
+    if (height > 0) {
+        distance[0] = 0;
+        for (Node *walk = update[0]->node; walk != node; walk = walk->next) {
+            distance[0]++;
+        }
+        for (int level = 1; level < height; level++) {
+            distance[level] = distance[level - 1];
+            for (SkipTower *walk = update[level]; walk != update[level - 1]; walk = walk->link[level - 1].next) {
+                distance[level] += walk->link[level - 1].width;
+            }
+        }
+    }
+
+    // Link the tower in after the last smaller tower on each of its levels, the links above pass one node more
+    for (int level = 0; level < SKIP_LIST_MAX_LEVEL; level++) {
+        SkipTower *before = level < index->levels ? update[level] : index->head;
+
+        if (level < height) {
+            tower->link[level].next = before->link[level].next;
+            tower->link[level].width = before->link[level].width + 1 - distance[level];
+            before->link[level].next = tower;
+            before->link[level].width = distance[level];
+        }
+        else {
+            before->link[level].width++;
+        }
+    }
+}
+
+/**
+ * @brief Removes the tower of a node that is about to be unlinked from the list.
+ *
+ * @pre `update` was filled by `skipListFindPredecessor()` for the node's element and the node is still linked.
+ * @post No tower refers to `node` anymore, and no link counts it.
+ *
+ * ***Pseudocode:***
+ * 1. If the tower after `update[0]` does not stand on `node`, the node has no tower
+ * 2. On each level of the tower, link `update[level]` to the tower's successor, adding up both widths
+ * 3. On every level above the tower, narrow the link passing over `node` by one
+ * 4. Free the tower
+ * 5. Drop empty levels from the top
+ *
+ * @param index A pointer to the `SkipListIndex`.
+ * @param node The node that is being removed.
+ * @param update The towers filled in by `skipListFindPredecessor()` for the node's element.
+*/
+void skipListRemove(SkipListIndex *index, Node *node, SkipTower **update) {
+    SkipTower *tower = update[0]->link[0].next;
+    int height = 0;
+
+    // Only a tower right after the last smaller one can stand on the node
+    if (tower != NULL && tower->node == node) {
+        height = tower->height;
+    }
+    else {
+        tower = NULL;// The node has no tower
+    }
+
+    for (int level = 0; level < SKIP_LIST_MAX_LEVEL; level++) {
+        SkipTower *before = level < index->levels ? update[level] : index->head;
+
+        if (level < height) {
+            before->link[level].next = tower->link[level].next;
+            before->link[level].width += tower->link[level].width - 1;
+        }
+        else {
+            before->link[level].width--;
+        }
+    }
+    free(tower);
+
+    // Keep searches from starting on levels that became empty
+    while (index->levels > 1 && index->head->link[index->levels - 1].next == NULL) {
+        index->levels--;
+    }
+}
+
+/**
+ * @brief Counts the nodes of the indexed list holding an element smaller than `elem`.
+ *
+ * @details
+ * - Descends like `skipListFindPredecessor()`, adding up the widths of the links it follows, so the count is
+ *   O(log n) on average.
+ *
+ * @param index A pointer to the `SkipListIndex`.
+ * @param elem The integer element to count the smaller elements of.
+ *
+ * @return Number of nodes before the first node holding an element greater than or equal to `elem`.
+*/
+int skipListRank(SkipListIndex *index, int elem) {
+    SkipTower *tower = index->head;
+    int rank = 0;
+
+    // Descend level by level, counting the nodes each followed link passes
+    for (int level = index->levels - 1; level >= 0; level--) {
+        while (tower->link[level].next != NULL && tower->link[level].next->node->d.i < elem) {
+            rank += tower->link[level].width;
+            tower = tower->link[level].next;
+        }
+    }
+
+    // Finish with the short walk over the unindexed nodes
+    for (Node *node = tower->node; node->next != NULL && node->next->d.i < elem; node = node->next) {
+        rank++;
+    }
+
+    return rank;
+}
+
+/**
+ * @brief Finds the node at a position of the indexed list.
+ *
+ * @details
+ * - Descends from the top level, following a link as long as it does not pass `position`, so the search is
+ *   O(log n) on average.
+ *
+ * @param index A pointer to the `SkipListIndex`.
+ * @param position Position of the node, 1 for the first node after the head.
+ *
+ * @return The node at `position`, or `NULL` if the list is shorter. Position 0 returns the head node.
+*/
+Node *skipListSelect(SkipListIndex *index, int position) {
+    SkipTower *tower = index->head;
+    int reached = 0;// Position of the node of tower
+
+    // Descend level by level, moving right while the next tower is not past the position
+    for (int level = index->levels - 1; level >= 0; level--) {
+        while (tower->link[level].next != NULL && reached + tower->link[level].width <= position) {
+            reached += tower->link[level].width;
+            tower = tower->link[level].next;
+        }
+    }
+
+    // Finish with the short walk over the unindexed nodes
+    Node *node = tower->node;
+    while (node != NULL && reached < position) {
+        node = node->next;
+        reached++;
+    }
+
+    return node;
+}
+// 
+
+// END OF SKIPLISTINDEXFUNCTIONS.C
\ No newline at end of file
@@ -0,0 +1,40 @@
+/**
+ * @file SortedArray.h
+ *
+ * @brief Header file for defining the sorted array used as the contiguous storage of an ordered set.
+ *
+ * @details
+ * A sorted array keeps its elements in ascending order in one block of memory that grows by doubling.
+ * Elements are found with a branchless binary search and inserted or removed by shifting the elements behind them
+ * with `memmove`. For sets that are read far more often than they are modified this beats the double linked list:
+ * lookups touch O(log n) cache lines and scans read memory strictly sequentially.
+ *
+ * The functions report errors with the `llError` codes of the double linked list.
+ *
+ * @date 17/10/2026
+ */
+#ifndef SortedArray_h
+#define SortedArray_h
+#include "DoubleLinkedListTypeDefs.h"
+
+#define SORTED_ARRAY_MIN_CAPACITY 16 /**< Capacity allocated for an empty array. */
+
+/**
+ * @struct SortedArray
+ * @brief A growable array of integers in ascending order.
+ */
+typedef struct {
+    int *elems; /**< The elements, `elems[0]` to `elems[count - 1]` are in use. */
+    int count; /**< Number of elements in use. */
+    int capacity; /**< Number of elements `elems` has room for. */
+} SortedArray;
+
+SortedArray *createSortedArray(int capacity);
+void deleteSortedArray(SortedArray *array);
+llError reserveSortedArray(SortedArray *array, int capacity);
+int sortedArrayLowerBound(const SortedArray *array, int elem);
+int sortedArrayGallop(const SortedArray *array, int from, int elem);
+llError sortedArrayInsertAt(SortedArray *array, int pos, int elem);
+llError sortedArrayRemoveAt(SortedArray *array, int pos);
+llError sortedArrayAppend(SortedArray *array, int elem);
+#endif
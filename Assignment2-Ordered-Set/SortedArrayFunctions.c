@@ -0,0 +1,256 @@
+/**
+ * @file SortedArrayFunctions.c
+ *
+ * @brief Implementation of the sorted array used as the contiguous storage of an ordered set.
+ *
+ * @details This file provides the implementation for:
+ *   - Creating, growing and deleting a sorted array.
+ *   - Binary and galloping (exponential) search for the position of an element.
+ *   - Inserting, removing and appending elements.
+ *
+ * @date 17/10/2026
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "SortedArray.h"
+
+/**
+ * @brief Finds the first position in a range whose element is greater than or equal to `elem`.
+ *
+ * @details
+ * - A branchless binary search: the range is halved with a conditional move instead of a branch, so the loop
+ *   runs exactly log2(n) times and never suffers a branch misprediction.
+ *
+ * ***Pseudocode:***
+ * 1. If the range is empty, return its start
+ * 2. While more than one candidate is left:
+ *      - Move the base to the middle if the middle element is smaller than `elem`
+ *      - Halve the number of candidates
+ * 3. Return the base, plus one if its element is still smaller than `elem`
+ *
+ * @param elems The sorted elements.
+ * @param lo First position of the range.
+ * @param hi One past the last position of the range.
+ * @param elem The integer element to search for.
+ *
+ * @return A position between `lo` and `hi`.
+*/
+static int lowerBoundInRange(const int *elems, int lo, int hi, int elem) {
+    const int *base = elems + lo;
+    int n = hi - lo;
+
+    if (n == 0) {
+        return lo;
+    }
+    while (n > 1) {
+        int half = n / 2;
+        base = (base[half] < elem) ? base + half : base;// compiles to a conditional move
+        n -= half;
+    }
+
+    return (int) (base - elems) + (*base < elem);
+}
+
+/**
+ * @brief Creates a new empty sorted array.
+ *
+ * @pre None.
+ * @post An empty array with room for at least `capacity` elements is created.
+ *
+ * @param capacity Number of elements to allocate room for; `SORTED_ARRAY_MIN_CAPACITY` is used if it is smaller.
+ *
+ * @return A pointer to the new array, or `NULL` on allocation failure.
+*/
+SortedArray *createSortedArray(int capacity) {
+    SortedArray *array = (SortedArray *) malloc(sizeof(SortedArray));
+
+    if (array == NULL) {
+        return NULL;// Return NULL if allocation fails
+    }
+    if (capacity < SORTED_ARRAY_MIN_CAPACITY) {
+        capacity = SORTED_ARRAY_MIN_CAPACITY;
+    }
+
+    array->elems = (int *) malloc((size_t) capacity * sizeof(int));
+    if (array->elems == NULL) {
+        free(array);
+        return NULL;// Return NULL if allocation fails
+    }
+    array->count = 0;
+    array->capacity = capacity;
+
+    return array;
+}
+
+/**
+ * @brief Deletes a sorted array and frees its memory.
+ *
+ * @param array A pointer to the `SortedArray` to delete, or NULL.
+*/
+void deleteSortedArray(SortedArray *array) {
+    if (array == NULL) {
+        return;// Nothing to delete
+    }
+    free(array->elems);
+    free(array);
+}
+
+/**
+ * @brief Makes sure the array has room for at least `capacity` elements.
+ *
+ * @pre `array` is valid.
+ * @post `array->capacity` is at least `capacity`; the elements are unchanged.
+ *
+ * @param array A pointer to the `SortedArray`.
+ * @param capacity Number of elements needed.
+ *
+ * @return `ok`, or `noMemory` if the array could not be grown.
+*/
+llError reserveSortedArray(SortedArray *array, int capacity) {
+    if (capacity <= array->capacity) {
+        return ok;// Already big enough
+    }
+
+    int *elems = (int *) realloc(array->elems, (size_t) capacity * sizeof(int));
+    if (elems == NULL) {
+        return noMemory;// The old block is still valid
+    }
+    array->elems = elems;
+    array->capacity = capacity;
+
+    return ok;
+}
+
+/**
+ * @brief Doubles the capacity of a full array, without letting it overflow an int.
+ *
+ * @param array A pointer to the full `SortedArray`.
+ *
+ * @return `ok`, or `noMemory` if the array could not be grown.
+*/
+static llError growSortedArray(SortedArray *array) {
+    if (array->capacity == INT_MAX) {
+        return noMemory;// The count could not be represented anymore
+    }
+    return reserveSortedArray(array, array->capacity > INT_MAX / 2 ? INT_MAX : array->capacity * 2);
+}
+
+/**
+ * @brief Finds the position of `elem`, or the position it would have to be inserted at.
+ *
+ * @param array A pointer to the `SortedArray`.
+ * @param elem The integer element to search for.
+ *
+ * @return The first position whose element is greater than or equal to `elem`, `array->count` if there is none.
+*/
+int sortedArrayLowerBound(const SortedArray *array, int elem) {
+    return lowerBoundInRange(array->elems, 0, array->count, elem);
+}
+
+/**
+ * @brief Finds the position of `elem` with a galloping search starting at a known position.
+ *
+ * @pre Every element before `from` is smaller than `elem`.
+ *
+ * @details
+ * - Probes positions `from`, `from + 1`, `from + 3`, `from + 7`, ... until an element greater than or equal to
+ *   `elem` is found, then binary searches the last gap.
+ * - If the answer is `d` positions after `from`, this costs O(log d), so searching for many ascending elements one
+ *   after another costs O(k log(n / k)) in total.
+ *
+ * ***Pseudocode:***
+ * 1. Start with a step of 1 at `from`
+ * 2. While the probed element is smaller than `elem`, move past it and double the step
+ * 3. Binary search between the last two probes
+ *
+ * @param array A pointer to the `SortedArray`.
+ * @param from Position to start the search at.
+ * @param elem The integer element to search for.
+ *
+ * @return The first position whose element is greater than or equal to `elem`, `array->count` if there is none.
+*/
+int sortedArrayGallop(const SortedArray *array, int from, int elem) {
+    long long lo = from;
+    long long probe = from;
+    long long step = 1;
+
+    // Double the step until the probe reaches elem or the end
+    while (probe < array->count && array->elems[probe] < elem) {
+        lo = probe + 1;
+        probe += step;
+        step *= 2;
+    }
+    if (probe > array->count) {
+        probe = array->count;
+    }
+
+    return lowerBoundInRange(array->elems, (int) lo, (int) probe, elem);
+}
+
+/**
+ * @brief Inserts an element at a given position, shifting the later elements up by one.
+ *
+ * @pre Inserting `elem` at `pos` keeps the array sorted.
+ * @post `elem` is at position `pos`; the capacity is doubled first if the array is full.
+ *
+ * @param array A pointer to the `SortedArray`.
+ * @param pos Position between 0 and `array->count`.
+ * @param elem The integer element to insert.
+ *
+ * @return `ok`, `illegalNode` if `pos` is out of range, or `noMemory` if the array could not be grown.
+*/
+llError sortedArrayInsertAt(SortedArray *array, int pos, int elem) {
+    if (pos < 0 || pos > array->count) {
+        return illegalNode;// Position outside the array
+    }
+    if (array->count == array->capacity && growSortedArray(array) != ok) {
+        return noMemory;// Return an error if growing fails
+    }
+
+    memmove(array->elems + pos + 1, array->elems + pos, (size_t) (array->count - pos) * sizeof(int));
+    array->elems[pos] = elem;
+    array->count++;
+
+    return ok;
+}
+
+/**
+ * @brief Removes the element at a given position, shifting the later elements down by one.
+ *
+ * @param array A pointer to the `SortedArray`.
+ * @param pos Position between 0 and `array->count - 1`.
+ *
+ * @return `ok`, or `illegalNode` if `pos` is out of range.
+*/
+llError sortedArrayRemoveAt(SortedArray *array, int pos) {
+    if (pos < 0 || pos >= array->count) {
+        return illegalNode;// Position outside the array
+    }
+
+    memmove(array->elems + pos, array->elems + pos + 1, (size_t) (array->count - pos - 1) * sizeof(int));
+    array->count--;
+
+    return ok;
+}
+
+/**
+ * @brief Appends an element greater than all others at the end of the array.
+ *
+ * @param array A pointer to the `SortedArray`.
+ * @param elem The integer element to append.
+ *
+ * @return `ok`, or `noMemory` if the array could not be grown.
+*/
+llError sortedArrayAppend(SortedArray *array, int elem) {
+    if (array->count == array->capacity && growSortedArray(array) != ok) {
+        return noMemory;// Return an error if growing fails
+    }
+    array->elems[array->count++] = elem;
+
+    return ok;
+}
+// 
+
+// END OF SORTEDARRAYFUNCTIONS.C
\ No newline at end of file
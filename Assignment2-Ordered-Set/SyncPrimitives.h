@@ -0,0 +1,75 @@
+/**
+ * @file SyncPrimitives.h
+ *
+ * @brief Header file for the locks, condition variables and atomic operations shared by the multi-threaded modules.
+ *
+ * @details
+ * Maps one small set of names onto Win32 on Windows and onto POSIX threads and the GCC/Clang `__atomic` builtins
+ * everywhere else, so the thread pool, the epoch reclaimer and the concurrent sets do not repeat the platform
+ * checks. Only the source files include it: it pulls in `windows.h` or `pthread.h`.
+ *
+ * - Pointer loads have acquire and pointer stores release semantics, which is what publishing a fully built node
+ *   through a `next` pointer needs.
+ * - Counters are 64 bits wide on every platform, so versions and epochs never wrap around.
+ * - `atomicFence()` is a full (sequentially consistent) fence.
+ *
+ * @date 17/10/2026
+ */
+#ifndef SyncPrimitives_h
+#define SyncPrimitives_h
+
+#ifdef _WIN32
+#include <windows.h>
+
+typedef CRITICAL_SECTION Mutex;
+typedef CONDITION_VARIABLE Condition;
+
+#define initMutex(mutex) InitializeCriticalSection(mutex)
+#define destroyMutex(mutex) DeleteCriticalSection(mutex)
+#define lockMutex(mutex) EnterCriticalSection(mutex)
+#define unlockMutex(mutex) LeaveCriticalSection(mutex)
+#define initCondition(condition) InitializeConditionVariable(condition)
+#define destroyCondition(condition) ((void) (condition))
+#define waitCondition(condition, mutex) SleepConditionVariableCS((condition), (mutex), INFINITE)
+#define wakeAll(condition) WakeAllConditionVariable(condition)
+
+#define atomicLoadPointer(pointer) ReadPointerAcquire((PVOID volatile *) (pointer))
+#define atomicStorePointer(pointer, value) WritePointerRelease((PVOID volatile *) (pointer), (PVOID) (value))
+#define atomicCasPointer(pointer, expected, desired) \
+    (InterlockedCompareExchangePointer((PVOID volatile *) (pointer), (PVOID) (desired), (PVOID) (expected)) \
+     == (PVOID) (expected))
+#define atomicLoadCounter(counter) ReadAcquire64((LONG64 volatile *) (counter))
+#define atomicStoreCounter(counter, value) WriteRelease64((LONG64 volatile *) (counter), (LONG64) (value))
+#define atomicCasCounter(counter, expected, desired) \
+    (InterlockedCompareExchange64((LONG64 volatile *) (counter), (LONG64) (desired), (LONG64) (expected)) \
+     == (LONG64) (expected))
+#define atomicAddCounter(counter, value) InterlockedExchangeAdd64((LONG64 volatile *) (counter), (LONG64) (value))
+#define atomicFence() MemoryBarrier()
+#else
+#include <pthread.h>
+
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t Condition;
+
+#define initMutex(mutex) pthread_mutex_init((mutex), NULL)
+#define destroyMutex(mutex) pthread_mutex_destroy(mutex)
+#define lockMutex(mutex) pthread_mutex_lock(mutex)
+#define unlockMutex(mutex) pthread_mutex_unlock(mutex)
+#define initCondition(condition) pthread_cond_init((condition), NULL)
+#define destroyCondition(condition) pthread_cond_destroy(condition)
+#define waitCondition(condition, mutex) pthread_cond_wait((condition), (mutex))
+#define wakeAll(condition) pthread_cond_broadcast(condition)
+
+#define atomicLoadPointer(pointer) __atomic_load_n((pointer), __ATOMIC_ACQUIRE)
+#define atomicStorePointer(pointer, value) __atomic_store_n((pointer), (value), __ATOMIC_RELEASE)
+#define atomicCasPointer(pointer, expected, desired) \
+    __sync_bool_compare_and_swap((pointer), (expected), (desired))
+#define atomicLoadCounter(counter) __atomic_load_n((counter), __ATOMIC_ACQUIRE)
+#define atomicStoreCounter(counter, value) __atomic_store_n((counter), (long long) (value), __ATOMIC_RELEASE)
+#define atomicCasCounter(counter, expected, desired) \
+    __sync_bool_compare_and_swap((counter), (long long) (expected), (long long) (desired))
+#define atomicAddCounter(counter, value) __atomic_fetch_add((counter), (long long) (value), __ATOMIC_SEQ_CST)
+#define atomicFence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * @file ThreadPool.h
+ *
+ * @brief Header file for defining the worker pool used to run set operations on several threads.
+ *
+ * @details
+ * A thread pool keeps a fixed number of worker threads waiting. `runThreadPool()` hands them a batch of
+ * independent tasks, takes part in running them itself and returns once all of them are done, so the caller
+ * never has to deal with threads directly.
+ *
+ * The pool uses Win32 threads and condition variables on Windows and POSIX threads everywhere else.
+ *
+ * @date 17/10/2026
+ */
+#ifndef ThreadPool_h
+#define ThreadPool_h
+#include <stddef.h>
+
+/**
+ * @typedef PoolTask
+ * @brief A task run by the pool, called with a pointer to its own argument.
+ */
+typedef void (*PoolTask)(void *arg);
+
+/**
+ * @struct ThreadPool
+ * @brief A pool of worker threads. Its contents depend on the platform and are private to `ThreadPoolFunctions.c`.
+ */
+typedef struct threadPool ThreadPool;
+
+int getProcessorCount();
+ThreadPool *createThreadPool(int threads);
+void deleteThreadPool(ThreadPool *pool);
+int getThreadPoolSize(const ThreadPool *pool);
+void runThreadPool(ThreadPool *pool, PoolTask task, void *args, size_t argSize, int count);
+#endif
@@ -0,0 +1,272 @@
+/**
+ * @file ThreadPoolFunctions.c
+ *
+ * @brief Implementation of the worker pool used to run set operations on several threads.
+ *
+ * @details This file provides the implementation for:
+ *   - Starting and joining Win32 or POSIX threads; locks and condition variables come from `SyncPrimitives.h`.
+ *   - Creating and deleting a pool of waiting worker threads.
+ *   - Running a batch of tasks on the workers and the calling thread.
+ *
+ * @date 17/10/2026
+*/
+
+#include <stdlib.h>
+#include "ThreadPool.h"
+#include "SyncPrimitives.h"
+
+#ifdef _WIN32
+typedef HANDLE Thread;
+#else
+#include <unistd.h>
+
+typedef pthread_t Thread;
+#endif
+
+/**
+ * @struct threadPool
+ * @brief The workers of a pool and the batch of tasks they are working on.
+ *
+ * Every field below `lock` is only read or written while holding `lock`.
+ */
+struct threadPool {
+    int threads; /**< Threads running tasks, the caller of `runThreadPool()` included. */
+    int started; /**< Worker threads actually started, `threads - 1` unless creation failed. */
+    Thread *workers; /**< The worker threads. */
+    Mutex lock; /**< Protects the batch. */
+    Condition wake; /**< Signalled when a batch starts or the pool shuts down. */
+    Condition done; /**< Signalled when the last task of a batch finishes. */
+    PoolTask task; /**< Task of the current batch. */
+    char *args; /**< Arguments of the current batch, `argSize` bytes apart. */
+    size_t argSize; /**< Size of one argument. */
+    int count; /**< Number of tasks in the current batch. */
+    int next; /**< Next task nobody has claimed yet. */
+    int pending; /**< Tasks of the current batch that have not finished. */
+    unsigned batch; /**< Incremented for every batch, so workers can tell a new one from the last. */
+    int stopping; /**< Set when the pool is deleted. */
+};
+
+/**
+ * @brief Claims and runs tasks of the current batch until none is left to claim.
+ *
+ * @pre `pool->lock` is held; it is released while a task runs and held again on return.
+*/
+static void runTasks(ThreadPool *pool) {
+    while (pool->next < pool->count) {
+        void *arg = pool->args + (size_t) pool->next * pool->argSize;
+        PoolTask task = pool->task;
+
+        pool->next++;
+        unlockMutex(&pool->lock);
+        task(arg);
+        lockMutex(&pool->lock);
+        // The last task to finish wakes the caller
+        if (--pool->pending == 0) {
+            wakeAll(&pool->done);
+        }
+    }
+}
+
+/**
+ * @brief Body of a worker thread: waits for a batch, helps running it, and waits again until the pool is deleted.
+*/
+static void workerLoop(ThreadPool *pool) {
+    unsigned seen = 0;
+
+    lockMutex(&pool->lock);
+    for (;;) {
+        while (!pool->stopping && pool->batch == seen) {
+            waitCondition(&pool->wake, &pool->lock);
+        }
+        if (pool->stopping) {
+            break;
+        }
+        seen = pool->batch;
+        runTasks(pool);
+    }
+    unlockMutex(&pool->lock);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI workerMain(LPVOID arg) {
+    workerLoop((ThreadPool *) arg);
+    return 0;
+}
+#else
+static void *workerMain(void *arg) {
+    workerLoop((ThreadPool *) arg);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Returns the number of processors the operating system reports.
+ *
+ * @return The number of logical processors, at least 1.
+*/
+int getProcessorCount() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int) info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return count > 0 ? (int) count : 1;
+#endif
+}
+
+/**
+ * @brief Creates a pool of worker threads.
+ *
+ * @pre None.
+ * @post `threads - 1` workers are started and wait for tasks; the thread calling `runThreadPool()` is the last one.
+ *
+ * @details
+ * - If the operating system refuses to start some of the workers, the pool runs with the ones it got.
+ *
+ * ***Pseudocode:***
+ * 1. If `threads` is less than 1, use the number of processors
+ * 2. Allocate the pool and its list of workers, initialize the lock and condition variables
+ * 3. Start `threads - 1` workers, stopping at the first one that cannot be started
+ * 4. Return the pool
+ *
+ * @param threads Number of threads to run tasks on, the caller included; 0 or less for one per processor.
+ *
+ * @return A pointer to the new `ThreadPool`, or NULL if memory could not be allocated.
+*/
+ThreadPool *createThreadPool(int threads) {
+    if (threads < 1) {
+        threads = getProcessorCount();
+    }
+
+    ThreadPool *pool = (ThreadPool *) malloc(sizeof(ThreadPool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->workers = (Thread *) malloc((size_t) threads * sizeof(Thread));
+    if (pool->workers == NULL) {
+        free(pool);
+        return NULL;
+    }
+
+    initMutex(&pool->lock);
+    initCondition(&pool->wake);
+    initCondition(&pool->done);
+    pool->task = NULL;
+    pool->args = NULL;
+    pool->argSize = 0;
+    pool->count = 0;
+    pool->next = 0;
+    pool->pending = 0;
+    pool->batch = 0;
+    pool->stopping = 0;
+
+    // Start the workers; the caller of runThreadPool() is the last thread
+    for (pool->started = 0; pool->started < threads - 1; pool->started++) {
+#ifdef _WIN32
+        pool->workers[pool->started] = CreateThread(NULL, 0, workerMain, pool, 0, NULL);
+        if (pool->workers[pool->started] == NULL) {
+            break;
+        }
+#else
+        if (pthread_create(&pool->workers[pool->started], NULL, workerMain, pool) != 0) {
+            break;
+        }
+#endif
+    }
+    pool->threads = pool->started + 1;
+
+    return pool;
+}
+
+/**
+ * @brief Stops the workers of a pool and frees it.
+ *
+ * @pre No batch is running on the pool.
+ * @post All workers have exited and the pool is freed.
+ *
+ * @param pool A pointer to the `ThreadPool`, or NULL.
+*/
+void deleteThreadPool(ThreadPool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    // Wake every worker and let it see the pool is shutting down
+    lockMutex(&pool->lock);
+    pool->stopping = 1;
+    wakeAll(&pool->wake);
+    unlockMutex(&pool->lock);
+
+    for (int i = 0; i < pool->started; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(pool->workers[i], INFINITE);
+        CloseHandle(pool->workers[i]);
+#else
+        pthread_join(pool->workers[i], NULL);
+#endif
+    }
+
+    destroyCondition(&pool->done);
+    destroyCondition(&pool->wake);
+    destroyMutex(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+/**
+ * @brief Returns the number of threads a pool runs tasks on, the caller of `runThreadPool()` included.
+*/
+int getThreadPoolSize(const ThreadPool *pool) {
+    return pool->threads;
+}
+
+/**
+ * @brief Runs a batch of tasks on the pool and waits for all of them.
+ *
+ * @pre One batch at a time: `runThreadPool()` must not be called on the same pool from two threads at once.
+ * @post `task` has been called once for each of the `count` arguments and every call has returned.
+ *
+ * @details
+ * - Tasks are handed out one at a time as threads become free, so uneven tasks still keep every thread busy.
+ * - The calling thread runs tasks too instead of just waiting.
+ *
+ * ***Pseudocode:***
+ * 1. Publish the batch and wake the workers
+ * 2. Run tasks until none is left to claim
+ * 3. Wait until the tasks claimed by the workers have finished
+ *
+ * @param pool A pointer to the `ThreadPool`.
+ * @param task The function to run.
+ * @param args Array of `count` arguments, `argSize` bytes each; task `i` is passed a pointer to argument `i`.
+ * @param argSize Size of one argument in bytes.
+ * @param count Number of tasks.
+*/
+void runThreadPool(ThreadPool *pool, PoolTask task, void *args, size_t argSize, int count) {
+    if (count <= 0) {
+        return;
+    }
+
+    lockMutex(&pool->lock);
+    pool->task = task;
+    pool->args = (char *) args;
+    pool->argSize = argSize;
+    pool->count = count;
+    pool->next = 0;
+    pool->pending = count;
+    pool->batch++;
+    wakeAll(&pool->wake);
+
+    // Help with the batch, then wait for the tasks still running on the workers
+    runTasks(pool);
+    while (pool->pending > 0) {
+        waitCondition(&pool->done, &pool->lock);
+    }
+    unlockMutex(&pool->lock);
+}
+
+// 
+
+// END OF THREADPOOLFUNCTIONS.C
\ No newline at end of file
@@ -17,11 +17,13 @@
 * @date 30/11/2024
 */
 
+#define _CRT_SECURE_NO_WARNINGS
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include "OrderedList.h"
-#define _CRT_SECURE_NO_WARNINGS
-#define MAX_SETS 10 // Maximum number of ordered sets.
+#include "SetScript.h"
 
 
 /**
@@ -31,6 +33,9 @@
  * This program provides operations to create, delete, add, and remove elements
  * from ordered sets. Additionally, it includes set operations such as intersection,
  * union, and difference.
+ *
+ * Started with `--batch`, it runs a set script from a file or standard input instead, without any prompts,
+ * see `SetScript.h`.
  */
 
  // Placeholder functions for the actual operations (to be implemented elsewhere) -- ********Commented out******** ******Move the relevant documentation to rory(orderedlist).c********
@@ -103,6 +108,45 @@ void displayMenu() {
     printf("8. Terminate Program\n");
 }
 
+/**
+ * @brief Runs a set script without any prompts.
+ *
+ * The commands of the script are described in `SetScript.h`. The sets
+ * are written to standard output, and the first failing command is
+ * reported on standard error.
+ *
+ * @param path The script file, or "-" for standard input.
+ * @param timed 1 to report how long the script took on standard error.
+ *
+ * @return Returns 0 if every command succeeded, 1 otherwise.
+ */
+int runBatch(const char* path, int timed) {
+    SetRegistry registry;
+    struct timespec start, end;
+    FILE* script = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+
+    if (script == NULL) {
+        fprintf(stderr, "[ERROR] Could not open the script %s.\n", path);
+        return 1;
+    }
+
+    initSetRegistry(&registry);
+    timespec_get(&start, TIME_UTC);
+    int result = runSetScript(&registry, script, stdout);
+    timespec_get(&end, TIME_UTC);
+    if (timed) {
+        fprintf(stderr, "Script ran in %.3f ms.\n",
+            (double) (end.tv_sec - start.tv_sec) * 1e3 + (double) (end.tv_nsec - start.tv_nsec) / 1e6);
+    }
+
+    clearSetRegistry(&registry);
+    if (script != stdin) {
+        fclose(script);
+    }
+
+    return result == 0 ? 0 : 1;
+}
+
 /**
  * @brief Main function to handle user input and menu operations.
  *
@@ -110,12 +154,47 @@ void displayMenu() {
  * and invoke the appropriate functions for managing ordered sets and
  * performing set operations.
  *
- * @return Returns 0 on successful program termination.
+ * Started as `program --batch [script|-] [--time]`, it runs the script, or
+ * standard input for `-` or no script, with `runBatch` instead.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv The command line arguments.
+ *
+ * @return Returns 0 on successful program termination, 1 if a batch script failed.
  */
-int main() {
-    orderedIntSet* sets[MAX_SETS] = { NULL }; // Array to hold up to 10 ordered sets
+int main(int argc, char* argv[]) {
+    SetRegistry registry; // The ordered sets, by index
     int choice;
 
+    if (argc > 1) {
+        const char* script = NULL;
+        int batch = 0;
+        int timed = 0;
+
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], "--batch") == 0) {
+                batch = 1;
+            }
+            else if (strcmp(argv[i], "--time") == 0) {
+                timed = 1;
+            }
+            else if (batch && script == NULL) {
+                script = argv[i];
+            }
+            else {
+                batch = 0;
+                break;
+            }
+        }
+        if (!batch) {
+            fprintf(stderr, "Usage: %s [--batch [script|-] [--time]]\n", argv[0]);
+            return 1;
+        }
+        return runBatch(script != NULL ? script : "-", timed);
+    }
+
+    initSetRegistry(&registry);
+
     // Display the menu once
     displayMenu();
 
@@ -136,19 +215,19 @@ int main() {
         switch (choice) {
         case 1: { // Create Ordered Set
             int index;
-            printf("Enter index (0-9) to create an Ordered Set:\n");
-            if (scanf_s("%d", &index) != 1 || index < 0 || index >= MAX_SETS) {
+            printf("Enter index (0-%d) to create an Ordered Set:\n", SET_REGISTRY_LIMIT - 1);
+            if (scanf_s("%d", &index) != 1 || index < 0 || index >= SET_REGISTRY_LIMIT) {
                 /*
-                    * The user is asked to input a valid index between 0 and 9.
+                    * The user is asked to input a valid index.
                     * If the input is invalid (non-integer or out of range),
                     * the program informs the user and skips this case.
                     */
-                printf("Invalid index. Must be between 0 and 9.\n");
+                printf("Invalid index. Must be between 0 and %d.\n", SET_REGISTRY_LIMIT - 1);
                 while (getchar() != '\n'); // Clear input buffer
                 break;// Exit this case and return to the menu
             }
 
-            if (sets[index] != NULL) { /*
+            if (getRegisteredSet(&registry, index) != NULL) { /*
                      * Check if an ordered set already exists at the specified index.
                      * If so, the user is notified that they must delete the set
                      * before creating a new one at the same index.
@@ -160,27 +239,31 @@ int main() {
                     * If the index is valid and no set exists at that index,
                     * create a new ordered set and store it at the specified index.
                     */
-                sets[index] = createOrderedSet();
-                printf("Created ordered set at index %d.\n", index);
+                if (putRegisteredSet(&registry, index, createOrderedSet())) {
+                    printf("Created ordered set at index %d.\n", index);
+                }
+                else {
+                    printf("Error creating the set.\n");
+                }
             }
             break;
         }
 
         case 2: { // Delete Ordered Set
             int index;
-            printf("Enter index (0-9) to delete an Ordered Set:\n");
-            if (scanf_s("%d", &index) != 1 || index < 0 || index >= MAX_SETS) {
+            printf("Enter index (0-%d) to delete an Ordered Set:\n", SET_REGISTRY_LIMIT - 1);
+            if (scanf_s("%d", &index) != 1 || index < 0 || index >= SET_REGISTRY_LIMIT) {
                 /*
                     * The user is asked to input a valid index for deletion.
                     * If the input is invalid (non-integer or out of range),
                     * the program informs the user and skips this case.
                     */
-                printf("Invalid index. Must be between 0 and 9.\n");
+                printf("Invalid index. Must be between 0 and %d.\n", SET_REGISTRY_LIMIT - 1);
                 while (getchar() != '\n'); // Clear input buffer
                 break;
             }
 
-            if (sets[index] == NULL) {
+            if (getRegisteredSet(&registry, index) == NULL) {
                 /*
                     * Check if an ordered set exists at the specified index.
                     * If no set exists, notify the user and do nothing.
@@ -189,11 +272,10 @@ int main() {
             }
             else {
                 /*
-                    * If a set exists at the specified index, delete it using
-                    * the `deleteOrderedSet` function and set the pointer to NULL.
+                    * If a set exists at the specified index, remove it from the
+                    * registry, which deletes it using the `deleteOrderedSet` function.
                     */
-                deleteOrderedSet(sets[index]);
-                sets[index] = NULL;
+                putRegisteredSet(&registry, index, NULL);
                 printf("Deleted ordered set at index %d.\n", index);
             }
             break;
@@ -202,19 +284,19 @@ int main() {
         case 3: { // Add Element to Set
             int index;
             int elem = 0;
-            printf("Enter index (0-9) to add elements to an Ordered Set, a negative number will stop the process.:\n");
-            if (scanf_s("%d", &index) != 1 || index < 0 || index >= MAX_SETS) {
+            printf("Enter index (0-%d) to add elements to an Ordered Set, a negative number will stop the process.:\n", SET_REGISTRY_LIMIT - 1);
+            if (scanf_s("%d", &index) != 1 || index < 0 || index >= SET_REGISTRY_LIMIT) {
                 /*
                     * The user is asked to input a valid index for adding an element.
                     * If the input is invalid (non-integer or out of range),
                     * the program informs the user and skips this case.
                     */
-                printf("Invalid index. Must be between 0 and 9.\n");
+                printf("Invalid index. Must be between 0 and %d.\n", SET_REGISTRY_LIMIT - 1);
                 while (getchar() != '\n'); // Clear input buffer
                 break;
             }
 
-            if (sets[index] == NULL) {
+            if (getRegisteredSet(&registry, index) == NULL) {
                 /*
                     * Check if an ordered set exists at the specified index.
                     * If no set exists, notify the user and do nothing.
@@ -240,7 +322,7 @@ int main() {
                  * was successfully added, already existed, or if there was an error.
                  */
                 if (elem >= 0) {
-                    ReturnValues result = addElement(sets[index], elem);
+                    ReturnValues result = addElement(getRegisteredSet(&registry, index), elem);
                     if (result == NUMBER_ADDED) {
                         printf("Element %d added to the set at index %d.\n", elem, index);
                     }
@@ -252,25 +334,25 @@ int main() {
                     }
                 }
             }
-            printToStdout(sets[index]);
+            printToStdout(getRegisteredSet(&registry, index));
             break;
         }
 
         case 4: { // Remove Element from Set
             int index;
             int elem = 0;
-            printf("Enter index (0-9) to remove elements from an Ordered Set:\n");
-            if (scanf_s("%d", &index) != 1 || index < 0 || index >= MAX_SETS) {
+            printf("Enter index (0-%d) to remove elements from an Ordered Set:\n", SET_REGISTRY_LIMIT - 1);
+            if (scanf_s("%d", &index) != 1 || index < 0 || index >= SET_REGISTRY_LIMIT) {
                 /*
                     * Validate the index for removing an element.
                     * If invalid, notify the user and skip the case.
                     */
-                printf("Invalid index. Must be between 0 and 9.\n");
+                printf("Invalid index. Must be between 0 and %d.\n", SET_REGISTRY_LIMIT - 1);
                 while (getchar() != '\n'); // Clear input buffer
                 break;
             }
 
-            if (sets[index] == NULL) {
+            if (getRegisteredSet(&registry, index) == NULL) {
                 /*
                      * Check if an ordered set exists at the specified index.
                      * If no set exists, notify the user and skip this case.
@@ -295,7 +377,7 @@ int main() {
                 * or not found in the set.
                 */
                 if (elem >= 0) {
-                    ReturnValues result = removeElement(sets[index], elem);
+                    ReturnValues result = removeElement(getRegisteredSet(&registry, index), elem);
                     if (result == NUMBER_REMOVED) {
                         printf("Element %d removed from the set at index %d.\n", elem, index);
                     }
@@ -304,7 +386,7 @@ int main() {
                     }
                 }
             }
-            printToStdout(sets[index]);
+            printToStdout(getRegisteredSet(&registry, index));
             break;
         }
 
@@ -312,58 +394,58 @@ int main() {
             int i1, i2, i3;// Declare indices for input sets and result set
             printf("Enter two indices for Set Intersection (i1, i2):\n");
             if (scanf_s("%d %d", &i1, &i2) != 2 ||
-                i1 < 0 || i1 >= MAX_SETS || i2 < 0 || i2 >= MAX_SETS) {
+                i1 < 0 || i1 >= SET_REGISTRY_LIMIT || i2 < 0 || i2 >= SET_REGISTRY_LIMIT) {
                 /*
                     * Validate input indices for the two sets.
-                    * Indices must be between 0 and MAX_SETS - 1.
+                    * Indices must be between 0 and SET_REGISTRY_LIMIT - 1.
                     * If invalid, clear the input buffer and inform the user.
                     */
-                printf("Invalid indices. Must be between 0 and 9.\n");
+                printf("Invalid indices. Must be between 0 and %d.\n", SET_REGISTRY_LIMIT - 1);
                 while (getchar() != '\n'); // Clear input buffer
                 break;
             }
 
             printf("Enter index to store the result (i3):\n");
-            if (scanf_s("%d", &i3) != 1 || i3 < 0 || i3 >= MAX_SETS) {
+            if (scanf_s("%d", &i3) != 1 || i3 < 0 || i3 >= SET_REGISTRY_LIMIT) {
                 /*
                     * Validate the index for the result set.
                     * If invalid, clear the input buffer and inform the user.
                     */
-                printf("Invalid index. Must be between 0 and 9.\n");
+                printf("Invalid index. Must be between 0 and %d.\n", SET_REGISTRY_LIMIT - 1);
                 while (getchar() != '\n'); // Clear input buffer
                 break;
             }/*
                      * Check if both input sets exist.
                      * If not, inform the user and exit this case.
                      */
-            if (sets[i1] = NULL && sets[i2] == NULL) {
+            if (getRegisteredSet(&registry, i1) == NULL && getRegisteredSet(&registry, i2) == NULL) {
 
                 printf("No ordered set available at index %d or index %d Intersection cannot be found.\n", i1, i2);
                 break;
             }
-            else if (sets[i1] == NULL) {
+            else if (getRegisteredSet(&registry, i1) == NULL) {
                 printf("No set available at index %d. Intersection cannot be found\n", i1);
                 break;
             }
-            else if (sets[i2] == NULL) {
+            else if (getRegisteredSet(&registry, i2) == NULL) {
                 printf("No set available at index %d. Intersection cannot be found\n", i2);
                 break;
             }
-            if (sets[i3] != NULL) {
-                /*
-                    * If a set already exists at the result index, delete it first
-                    * to free memory and prepare for the new result.
-                    */
-                deleteOrderedSet(sets[i3]); // Clear the existing set
-            }
-
             /*
              * Perform the intersection operation using `setIntersection`.
              * Store the resulting set in the specified result index.
              */
-            sets[i3] = setIntersection(sets[i1], sets[i2]);
+            orderedIntSet* result = setIntersection(getRegisteredSet(&registry, i1), getRegisteredSet(&registry, i2));
+            /*
+             * The set stored at the result index before is deleted only once
+             * the result is stored, so the result index may be i1 or i2.
+             */
+            if (result == NULL || !putRegisteredSet(&registry, i3, result)) {
+                printf("Error computing the set intersection.\n");
+                break;
+            }
             printf("Set Intersection stored at index %d.\n", i3);
-            printToStdout(sets[i3]);
+            printToStdout(result);
             break;
         }
 
@@ -371,24 +453,24 @@ int main() {
             int i1, i2, i3;// Declare indices for input sets and result set
             printf("Enter two indices for Set Union (i1, i2):\n");
             if (scanf_s("%d %d", &i1, &i2) != 2 ||
-                i1 < 0 || i1 >= MAX_SETS || i2 < 0 || i2 >= MAX_SETS) {
+                i1 < 0 || i1 >= SET_REGISTRY_LIMIT || i2 < 0 || i2 >= SET_REGISTRY_LIMIT) {
                 /*
                      * Validate input indices for the two sets.
-                     * Indices must be between 0 and MAX_SETS - 1.
+                     * Indices must be between 0 and SET_REGISTRY_LIMIT - 1.
                      * If invalid, clear the input buffer and inform the user.
                      */
-                printf("Invalid indices. Must be between 0 and 9.\n");
+                printf("Invalid indices. Must be between 0 and %d.\n", SET_REGISTRY_LIMIT - 1);
                 while (getchar() != '\n'); // Clear input buffer
                 break;
             }
 
             printf("Enter index to store the result (i3):\n");
-            if (scanf_s("%d", &i3) != 1 || i3 < 0 || i3 >= MAX_SETS) {
+            if (scanf_s("%d", &i3) != 1 || i3 < 0 || i3 >= SET_REGISTRY_LIMIT) {
                 /*
                     * Validate the index for the result set.
                     * If invalid, clear the input buffer and inform the user.
                     */
-                printf("Invalid index. Must be between 0 and 9.\n");
+                printf("Invalid index. Must be between 0 and %d.\n", SET_REGISTRY_LIMIT - 1);
                 while (getchar() != '\n'); // Clear input buffer
                 break;
             }
@@ -396,115 +478,113 @@ int main() {
                      * Check if both input sets exist.
                      * If not, inform the user and exit this case.
                      */
-            if (sets[i1] = NULL && sets[i2] == NULL) {
+            if (getRegisteredSet(&registry, i1) == NULL && getRegisteredSet(&registry, i2) == NULL) {
                 printf("No ordered set available at index %d or index %d. Union cannot be found.\n", i1, i2);
                 break;
             }
-            else if (sets[i1] == NULL) {
+            else if (getRegisteredSet(&registry, i1) == NULL) {
                 printf("No set available at index %d. Union cannot be found\n", i1);
                 break;
             }
-            else if (sets[i2] == NULL) {
+            else if (getRegisteredSet(&registry, i2) == NULL) {
                 printf("No set available at index %d. Union cannot be found\n", i2);
                 break;
+            }
 
-                if (sets[i3] != NULL) {
-                    /*
-                    * If a set already exists at the result index, delete it first
-                    * to free memory and prepare for the new result.
-                    */
-                    deleteOrderedSet(sets[i3]); // Clear the existing set
-                }
-                /*
-                                * Perform the union operation using `setUnion`.
-                                * Store the resulting set in the specified result index.
-                                */
-                sets[i3] = setUnion(sets[i1], sets[i2]);
-                printf("Set Union stored at index %d.\n", i3);
-                printToStdout(sets[i3]);
+            /*
+                            * Perform the union operation using `setUnion`.
+                            * Store the resulting set in the specified result index.
+                            */
+            orderedIntSet* result = setUnion(getRegisteredSet(&registry, i1), getRegisteredSet(&registry, i2));
+            /*
+             * The set stored at the result index before is deleted only once
+             * the result is stored, so the result index may be i1 or i2.
+             */
+            if (result == NULL || !putRegisteredSet(&registry, i3, result)) {
+                printf("Error computing the set union.\n");
                 break;
             }
+            printf("Set Union stored at index %d.\n", i3);
+            printToStdout(result);
+            break;
+        }
 
         case 7: { // Set Difference
             int i1, i2, i3;// Declare indices for input sets and result set
             printf("Enter two indices for Set Difference (i1, i2):\n");
             if (scanf_s("%d %d", &i1, &i2) != 2 ||
-                i1 < 0 || i1 >= MAX_SETS || i2 < 0 || i2 >= MAX_SETS) {
+                i1 < 0 || i1 >= SET_REGISTRY_LIMIT || i2 < 0 || i2 >= SET_REGISTRY_LIMIT) {
                 /*
                     * Validate input indices for the two sets.
-                    * Indices must be between 0 and MAX_SETS - 1.
+                    * Indices must be between 0 and SET_REGISTRY_LIMIT - 1.
                     * If invalid, clear the input buffer and inform the user.
                     */
-                printf("Invalid indices. Must be between 0 and 9.\n");
+                printf("Invalid indices. Must be between 0 and %d.\n", SET_REGISTRY_LIMIT - 1);
                 while (getchar() != '\n'); // Clear input buffer
                 break;
             }
 
             printf("Enter index to store the result (i3):\n");
-            if (scanf_s("%d", &i3) != 1 || i3 < 0 || i3 >= MAX_SETS) {
+            if (scanf_s("%d", &i3) != 1 || i3 < 0 || i3 >= SET_REGISTRY_LIMIT) {
                 /*
                      * Validate the index for the result set.
                      * If invalid, clear the input buffer and inform the user.
                      */
-                printf("Invalid index. Must be between 0 and 9.\n");
+                printf("Invalid index. Must be between 0 and %d.\n", SET_REGISTRY_LIMIT - 1);
                 while (getchar() != '\n'); // Clear input buffer
                 break;
             }
 
-            if (sets[i1] = NULL && sets[i2] == NULL) {/*
+            if (getRegisteredSet(&registry, i1) == NULL && getRegisteredSet(&registry, i2) == NULL) {/*
                      * Check if both input sets exist.
                      * If not, inform the user and exit this case.
                      */
                 printf("No ordered set available at index %d or index %d Difference cannot be found.\n", i1, i2);
                 break;
             }
-            else if (sets[i1] == NULL) {
+            else if (getRegisteredSet(&registry, i1) == NULL) {
                 printf("No set available at index %d. Difference cannot be found\n", i1);
                 break;
             }
-            else if (sets[i2] == NULL) {
+            else if (getRegisteredSet(&registry, i2) == NULL) {
                 printf("No set available at index %d. Difference cannot be found\n", i2);
                 break;
             }
 
-            if (sets[i3] != NULL) { /*
-                     * If a set already exists at the result index, delete it first
-                     * to free memory and prepare for the new result.
-                     */
-                deleteOrderedSet(sets[i3]); // Clear the existing set
-            }
             /*
                              * Perform the difference operation using `setDifference`.
                              * Store the resulting set in the specified result index.
                              */
-            sets[i3] = setDifference(sets[i1], sets[i2]);
+            orderedIntSet* result = setDifference(getRegisteredSet(&registry, i1), getRegisteredSet(&registry, i2));
+            /*
+             * The set stored at the result index before is deleted only once
+             * the result is stored, so the result index may be i1 or i2.
+             */
+            if (result == NULL || !putRegisteredSet(&registry, i3, result)) {
+                printf("Error computing the set difference.\n");
+                break;
+            }
             printf("Set Difference stored at index %d.\n", i3);
-            printToStdout(sets[i3]);
+            printToStdout(result);
             break;
         }
 
         case 8: // Terminate program
             printf("Terminating program.\n");
             /*
-                * Loop through all possible sets in the `sets` array.
-                * If a set exists at an index, delete it to free memory.
+                * Delete every set in the registry to free memory.
                 */
-            for (int i = 0; i < MAX_SETS; i++) {
-                if (sets[i] != NULL) {
-                    deleteOrderedSet(sets[i]);
-                }
-            }
+            clearSetRegistry(&registry);
             break;
 
         default:
             printf("Invalid choice. Please try again.\n");
             while (getchar() != '\n'); // Clear input buffer
         }
-        }
-        } while (choice != 8);
+    } while (choice != 8);
 
-        return 0;
-    }
-    // 
+    return 0;
+}
+// 
 
 // END OF MAIN.C
\ No newline at end of file